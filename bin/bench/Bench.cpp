@@ -0,0 +1,451 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <remill/Arch/Arch.h>
+#include <remill/Arch/Instruction.h>
+#include <remill/Arch/InstructionStream.h>
+#include <remill/Arch/Name.h>
+#include <remill/BC/ABI.h>
+#include <remill/BC/IntrinsicTable.h>
+#include <remill/BC/Lifter.h>
+#include <remill/BC/Optimizer.h>
+#include <remill/BC/Util.h>
+#include <remill/OS/OS.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+DEFINE_string(os, REMILL_OS,
+              "Operating system name of the code being "
+              "decoded. Valid OSes: linux, macos, windows, solaris.");
+DEFINE_string(arch, REMILL_ARCH,
+              "Architecture of the code being decoded. "
+              "Valid architectures: x86, amd64 (with or without "
+              "`_avx` or `_avx512` appended), aarch64, aarch32, sparc32, "
+              "sparc64");
+
+DEFINE_uint64(address, 0,
+              "Address at which we should assume the bytes are "
+              "located in virtual memory.");
+
+DEFINE_string(binary, "",
+              "Path to a file of raw code bytes, e.g. the .text section of a "
+              "real binary extracted with `objcopy -O binary "
+              "--only-section=.text`.");
+DEFINE_string(bytes, "", "Hex-encoded byte string to decode.");
+
+DEFINE_uint64(iterations, 10,
+              "Number of times to replay the decoded instruction mix.");
+DEFINE_uint64(top_isels, 10,
+              "Number of most frequent semantics functions in the "
+              "instruction mix to report.");
+
+DEFINE_bool(lift, false,
+            "Also compare decoding and lifting each instruction against "
+            "loading it from a serialized instruction stream and lifting "
+            "it.");
+DEFINE_bool(inline_semantics, false,
+            "With --lift, also measure lifting when the pre-simplified "
+            "bodies of the semantics functions are stamped into the lifted "
+            "blocks, including the time to make their templates, and compare "
+            "lifting and optimizing the instruction mix with and without "
+            "stamping.");
+DEFINE_string(stream_file, "",
+              "Path to the instruction stream file used by --lift. Defaults "
+              "to a temporary file.");
+
+// Count allocations made through `operator new`, which is what `std::string`,
+// `std::vector`, and LLVM's containers use.
+static std::atomic<uint64_t> gNumAllocations{0};
+
+void *operator new(size_t size) {
+  gNumAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (auto ptr = malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+  free(ptr);
+}
+
+namespace {
+
+struct Measurement {
+  uint64_t num_insts{0};
+  double nanoseconds{0};
+  uint64_t num_allocations{0};
+};
+
+// Time `cb`, which processes `num_insts` instructions.
+template <typename T>
+static Measurement Measure(uint64_t num_insts, T cb) {
+  Measurement m;
+  m.num_insts = std::max<uint64_t>(1u, num_insts);
+  const auto num_allocations = gNumAllocations.load();
+  const auto start = std::chrono::steady_clock::now();
+  cb();
+  const auto end = std::chrono::steady_clock::now();
+  m.num_allocations = gNumAllocations.load() - num_allocations;
+  m.nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+  return m;
+}
+
+static void Report(const char *name, const Measurement &m) {
+  std::cout << std::left << std::setw(16) << name << std::right << std::fixed
+            << std::setprecision(1) << std::setw(10)
+            << (m.nanoseconds / m.num_insts) << " ns/inst" << std::setw(10)
+            << (static_cast<double>(m.num_allocations) / m.num_insts)
+            << " allocs/inst" << std::endl;
+}
+
+// Read the bytes to decode from `--binary` or `--bytes`.
+static bool ReadInputBytes(std::string &bytes) {
+  if (!FLAGS_binary.empty()) {
+    auto buff = llvm::MemoryBuffer::getFile(FLAGS_binary, false, false);
+    if (!buff) {
+      std::cerr << "Unable to read " << FLAGS_binary << ": "
+                << buff.getError().message() << std::endl;
+      return false;
+    }
+    bytes = (*buff)->getBuffer().str();
+    return true;
+  }
+
+  if (FLAGS_bytes.size() % 2) {
+    std::cerr << "Please specify an even number of nibbles to --bytes."
+              << std::endl;
+    return false;
+  }
+
+  for (size_t i = 0; i < FLAGS_bytes.size(); i += 2) {
+    char nibbles[] = {FLAGS_bytes[i], FLAGS_bytes[i + 1], '\0'};
+    char *parsed_to = nullptr;
+    auto byte_val = strtol(nibbles, &parsed_to, 16);
+    if (parsed_to != &(nibbles[2])) {
+      std::cerr << "Invalid hex byte value '" << nibbles
+                << "' passed to --bytes." << std::endl;
+      return false;
+    }
+    bytes.push_back(static_cast<char>(byte_val));
+  }
+  return true;
+}
+
+// Linear sweep `bytes`, returning the offsets of every instruction that
+// decoded. This is the instruction mix that gets replayed.
+static std::vector<uint64_t> SweepInstructions(const remill::Arch *arch,
+                                               std::string_view bytes) {
+  const auto max_size = arch->MaxInstructionSize();
+  const auto align = std::max<uint64_t>(1u, arch->MinInstructionAlign());
+  std::map<std::string, uint64_t> isel_counts;
+  std::vector<uint64_t> offsets;
+
+  remill::Instruction inst;
+  for (uint64_t offset = 0; offset < bytes.size();) {
+    inst.Reset();
+    if (arch->DecodeInstruction(FLAGS_address + offset,
+                                bytes.substr(offset, max_size), inst) &&
+        inst.IsValid() && inst.NumBytes()) {
+      offsets.push_back(offset);
+      isel_counts[inst.function] += 1;
+      offset += inst.NumBytes();
+    } else {
+      offset += align;
+    }
+  }
+
+  std::vector<std::pair<uint64_t, std::string>> hot_isels;
+  for (auto &[isel, count] : isel_counts) {
+    hot_isels.emplace_back(count, isel);
+  }
+  std::sort(hot_isels.rbegin(), hot_isels.rend());
+  hot_isels.resize(std::min<size_t>(hot_isels.size(), FLAGS_top_isels));
+
+  std::cout << "Decoded " << offsets.size() << " instructions with "
+            << isel_counts.size() << " distinct semantics functions from "
+            << bytes.size() << " bytes" << std::endl;
+  for (auto &[count, isel] : hot_isels) {
+    std::cout << "  " << std::setw(6) << std::fixed << std::setprecision(2)
+              << (100.0 * count / std::max<size_t>(1u, offsets.size()))
+              << "%  " << isel << std::endl;
+  }
+
+  return offsets;
+}
+
+// Lifts instructions into a scratch function, which is periodically emptied
+// so that the amount of IR stays bounded.
+class ScratchLifter {
+ public:
+  ScratchLifter(const remill::Arch *arch_, llvm::Module *module_,
+                bool inline_semantics = false)
+      : arch(arch_),
+        module(module_),
+        intrinsics(module),
+        inst_lifter(arch, intrinsics),
+        func(arch->DefineLiftedFunction(
+            inline_semantics ? "__remill_bench_inline" : "__remill_bench",
+            module)),
+        state_ptr(remill::NthArgument(func, remill::kStatePointerArgNum)) {
+    inst_lifter.SetInlineSemantics(inline_semantics);
+  }
+
+  void Lift(remill::Instruction &inst) {
+    if (++num_blocks > 1024u) {
+      Reset();
+    }
+    auto block = llvm::BasicBlock::Create(module->getContext(), "", func);
+    inst_lifter.LiftIntoBlock(inst, block, state_ptr);
+  }
+
+  void Reset(void) {
+    func->deleteBody();
+    arch->InitializeEmptyLiftedFunction(func);
+    inst_lifter.ClearCache();
+    num_blocks = 0;
+  }
+
+ private:
+  const remill::Arch *const arch;
+  llvm::Module *const module;
+  const remill::IntrinsicTable intrinsics;
+  remill::InstructionLifter inst_lifter;
+  llvm::Function *const func;
+  llvm::Value *const state_ptr;
+  unsigned num_blocks{0};
+};
+
+// Lift each instruction in `offsets` into its own function in a copy of
+// `semantics`, and optimize those functions. This is the end-to-end compile
+// time that stamping semantics templates is meant to reduce.
+static Measurement MeasureLiftAndOptimize(const remill::Arch *arch,
+                                          const llvm::Module *semantics,
+                                          std::string_view bytes,
+                                          const std::vector<uint64_t> &offsets,
+                                          bool inline_semantics) {
+  const auto max_size = arch->MaxInstructionSize();
+  auto module = llvm::CloneModule(*semantics);
+  remill::Instruction inst;
+
+  return Measure(offsets.size(), [&](void) {
+    const remill::IntrinsicTable intrinsics(module.get());
+    remill::InstructionLifter inst_lifter(arch, intrinsics);
+    inst_lifter.SetInlineSemantics(inline_semantics);
+
+    std::vector<llvm::Function *> funcs;
+    for (auto offset : offsets) {
+      inst.Reset();
+      arch->DecodeInstruction(FLAGS_address + offset,
+                              bytes.substr(offset, max_size), inst);
+      auto func = arch->DefineLiftedFunction(
+          "__remill_bench_" + std::to_string(offset), module.get());
+      auto block = &(func->getEntryBlock());
+      inst_lifter.LiftIntoBlock(
+          inst, block, remill::NthArgument(func, remill::kStatePointerArgNum));
+      remill::AddTerminatingTailCall(block, intrinsics.missing_block,
+                                     intrinsics);
+      funcs.push_back(func);
+    }
+
+    remill::OptimizeModule(arch, module.get(), funcs);
+  });
+}
+
+// Compare decode-and-lift against load-and-lift from an instruction stream.
+static bool BenchmarkLifting(const remill::Arch *arch, llvm::Module *semantics,
+                             std::string_view bytes,
+                             const std::vector<uint64_t> &offsets) {
+  const auto max_size = arch->MaxInstructionSize();
+  remill::Instruction inst;
+
+  std::string stream_file = FLAGS_stream_file;
+  if (stream_file.empty()) {
+    llvm::SmallString<128> path;
+    if (auto ec = llvm::sys::fs::createTemporaryFile("remill-bench", "insts",
+                                                     path)) {
+      std::cerr << "Unable to create a temporary file: " << ec.message()
+                << std::endl;
+      return false;
+    }
+    stream_file = path.str().str();
+  }
+
+  remill::InstructionStreamWriter writer(arch->arch_name);
+  for (auto offset : offsets) {
+    inst.Reset();
+    arch->DecodeInstruction(FLAGS_address + offset,
+                            bytes.substr(offset, max_size), inst);
+    if (!writer.Add(inst)) {
+      return false;
+    }
+  }
+
+  if (!writer.WriteToFile(stream_file)) {
+    return false;
+  }
+
+  const auto num_insts = offsets.size() * FLAGS_iterations;
+  ScratchLifter lifter(arch, semantics);
+
+  const auto decode_lift = Measure(num_insts, [&](void) {
+    for (uint64_t i = 0; i < FLAGS_iterations; ++i) {
+      for (auto offset : offsets) {
+        inst.Reset();
+        arch->DecodeInstruction(FLAGS_address + offset,
+                                bytes.substr(offset, max_size), inst);
+        lifter.Lift(inst);
+      }
+    }
+  });
+
+  lifter.Reset();
+
+  std::unique_ptr<remill::InstructionStream> stream;
+  const auto load_lift = Measure(num_insts, [&](void) {
+    stream = remill::InstructionStream::Open(stream_file);
+    for (uint64_t i = 0; stream && i < FLAGS_iterations; ++i) {
+      for (size_t j = 0; j < stream->Size(); ++j) {
+        stream->Read(j, arch, inst);
+        lifter.Lift(inst);
+      }
+    }
+  });
+
+  if (!stream) {
+    return false;
+  }
+
+  Report("decode+lift", decode_lift);
+  Report("load+lift", load_lift);
+
+  if (FLAGS_inline_semantics) {
+    ScratchLifter inline_lifter(arch, semantics, true);
+    const auto decode_stamp = Measure(num_insts, [&](void) {
+      for (uint64_t i = 0; i < FLAGS_iterations; ++i) {
+        for (auto offset : offsets) {
+          inst.Reset();
+          arch->DecodeInstruction(FLAGS_address + offset,
+                                  bytes.substr(offset, max_size), inst);
+          inline_lifter.Lift(inst);
+        }
+      }
+    });
+    Report("decode+stamp", decode_stamp);
+
+    Report("lift+opt", MeasureLiftAndOptimize(arch, semantics, bytes, offsets,
+                                              false));
+    Report("stamp+opt", MeasureLiftAndOptimize(arch, semantics, bytes, offsets,
+                                               true));
+  }
+
+  if (FLAGS_stream_file.empty()) {
+    llvm::sys::fs::remove(stream_file);
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+
+  if (FLAGS_binary.empty() == FLAGS_bytes.empty()) {
+    std::cerr << "Please specify exactly one of --binary or --bytes."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::string bytes;
+  if (!ReadInputBytes(bytes)) {
+    return EXIT_FAILURE;
+  }
+
+  llvm::LLVMContext context;
+  auto arch = remill::Arch::Get(context, FLAGS_os, FLAGS_arch);
+  if (!arch) {
+    return EXIT_FAILURE;
+  }
+
+  // Decoding fills in operands using the register table, which needs the
+  // semantics.
+  auto semantics = remill::LoadArchSemantics(arch.get());
+
+  const auto offsets = SweepInstructions(arch.get(), bytes);
+  if (offsets.empty()) {
+    std::cerr << "No instructions were decoded." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const auto max_size = arch->MaxInstructionSize();
+  const auto num_insts = offsets.size() * FLAGS_iterations;
+  const std::string_view bytes_view = bytes;
+  remill::Instruction inst;
+
+  const auto decode = Measure(num_insts, [&](void) {
+    for (uint64_t i = 0; i < FLAGS_iterations; ++i) {
+      for (auto offset : offsets) {
+        inst.Reset();
+        arch->DecodeInstruction(FLAGS_address + offset,
+                                bytes_view.substr(offset, max_size), inst);
+      }
+    }
+  });
+
+  remill::ControlFlowInfo info;
+  const auto decode_cf = Measure(num_insts, [&](void) {
+    for (uint64_t i = 0; i < FLAGS_iterations; ++i) {
+      for (auto offset : offsets) {
+        arch->DecodeControlFlow(FLAGS_address + offset,
+                                bytes_view.substr(offset, max_size), info);
+      }
+    }
+  });
+
+  Report("decode", decode);
+  Report("control flow", decode_cf);
+
+  if (FLAGS_lift &&
+      !BenchmarkLifting(arch.get(), semantics.get(), bytes_view, offsets)) {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
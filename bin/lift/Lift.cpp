@@ -23,7 +23,11 @@
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Type.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Support/Base64.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/TimeProfiler.h>
 #include <llvm/Support/raw_ostream.h>
 #include <remill/Arch/Arch.h>
 #include <remill/Arch/Instruction.h>
@@ -32,11 +36,14 @@
 #include <remill/BC/IntrinsicTable.h>
 #include <remill/BC/Lifter.h>
 #include <remill/BC/Optimizer.h>
+#include <remill/BC/Profile.h>
 #include <remill/BC/Util.h>
+#include <remill/OS/FileSystem.h>
 #include <remill/OS/OS.h>
 #include <remill/Version/Version.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <fstream>
 #include <functional>
@@ -46,6 +53,8 @@
 #include <sstream>
 #include <string>
 #include <system_error>
+#include <unordered_set>
+#include <vector>
 
 DEFINE_string(os, REMILL_OS,
               "Operating system name of the code being "
@@ -76,44 +85,156 @@ DEFINE_string(slice_inputs, "",
 DEFINE_string(slice_outputs, "",
               "Comma-separated list of registers to treat as outputs.");
 
+DEFINE_uint64(inline_call_insts, 0,
+              "Maximum number of instructions in a direct call target for it "
+              "to be inlined into the trace of its caller. Zero disables "
+              "inlining.");
+
+DEFINE_bool(direct_atomics, false,
+            "Lift atomic read-modify-write instructions, e.g. x86 'LOCK ADD', "
+            "using the atomic memory intrinsics directly, instead of "
+            "surrounding them with __remill_atomic_begin/end.");
+
+DEFINE_bool(inline_semantics, false,
+            "Stamp pre-simplified copies of the instruction semantics "
+            "functions into the lifted code, instead of calling them and "
+            "leaving them to the inliner. Cannot be used with --thin_module, "
+            "--stream_dir, or --server, whose lifted code only has "
+            "declarations of the semantics functions.");
+
+DEFINE_bool(thin_module, false,
+            "Lift into a thin module that only declares the semantics "
+            "functions, and link in the needed semantics just before "
+            "optimizing, instead of lifting into the semantics module. This "
+            "is always done with --stream_dir.");
+
+DEFINE_bool(fold_constant_memory, false,
+            "Treat the bytes passed to --bytes as read-only memory, and fold "
+            "reads of them at constant addresses, e.g. of literal pools, into "
+            "constants.");
+
+DEFINE_bool(promote_stack_frames, false,
+            "Turn accesses to each lifted trace's own stack frame into "
+            "accesses to local variables, when the stack pointer provably "
+            "doesn't escape the trace.");
+
+DEFINE_bool(coalesce_memory, false,
+            "Fuse adjacent memory reads, and adjacent memory writes, in the "
+            "lifted traces into wider ones.");
+
+DEFINE_bool(merge_traces, false,
+            "Turn lifted traces that are structurally identical to another "
+            "trace once optimized, e.g. copies of the same thunk, into "
+            "tail calls to that trace.");
+
+DEFINE_string(profile, "",
+              "Path to an execution profile of the code being lifted. Each "
+              "line is either 'block <addr> <count>' or 'edge <from> <to> "
+              "<count>'. Hot traces are lifted first, and conditional "
+              "branches get profiled branch weights.");
+DEFINE_uint64(cold_entry_count, 0,
+              "Traces whose profiled entry count is below this threshold are "
+              "optimized more cheaply. Zero disables this.");
+DEFINE_uint64(cheap_trace_ir_insts, 0,
+              "Traces with more LLVM instructions than this, once their "
+              "semantics are inlined, are optimized as cheaply as cold "
+              "traces, and skip the module pipeline. Zero disables this.");
+DEFINE_uint64(unoptimized_trace_ir_insts, 0,
+              "Traces with more LLVM instructions than this, once their "
+              "semantics are inlined, are otherwise left unoptimized. Zero "
+              "disables this.");
+DEFINE_uint64(trace_time_budget_ms, 0,
+              "Traces that take longer than this many milliseconds to "
+              "optimize aren't optimized any further, including by the "
+              "module pipeline. Zero disables this.");
+
+DEFINE_bool(count_blocks, false,
+            "Instrument each lifted guest block with an execution counter. "
+            "The counters, and the guest address of each counter, are "
+            "defined as the __remill_block_counts and __remill_block_pcs "
+            "arrays. With --stream_dir, they are saved to their own "
+            "block_counters.bc file.");
+
+DEFINE_string(stream_dir, "",
+              "Directory into which each lifted trace is saved, as its own "
+              "bitcode file, as soon as it has been optimized. This keeps "
+              "peak memory usage bounded when lifting large programs.");
+DEFINE_uint64(stream_batch_size, 64,
+              "Number of lifted traces to optimize together before saving "
+              "them to --stream_dir.");
+
+DEFINE_string(stats_out, "",
+              "Path to a file where per-trace and per-pass optimization "
+              "statistics should be saved, as JSON.");
+
+DEFINE_string(trace_out, "",
+              "Path to a file where a timeline of the decoding, lifting, "
+              "optimization and saving phases should be saved, in the Chrome "
+              "trace event format. It can be viewed with Perfetto or "
+              "chrome://tracing.");
+DEFINE_uint64(trace_granularity, 0,
+              "Minimum duration, in microseconds, of the events that are "
+              "saved to --trace_out.");
+
+DEFINE_bool(server, false,
+            "Run as a long-lived lifting service. Lift requests are read as "
+            "newline-delimited JSON objects from stdin, and one JSON response "
+            "per request is written to stdout. Architectures and semantics "
+            "modules are kept loaded between requests.");
+
 using Memory = std::map<uint64_t, uint8_t>;
 
-// Unhexlify the data passed to `--bytes`, and fill in `memory` with each
-// such byte.
-static Memory UnhexlifyInputBytes(uint64_t addr_mask) {
-  Memory memory;
+// Unhexlify the data in `bytes`, and fill in `memory` with each such byte,
+// starting at `address`. Returns `false` and fills in `error` if `bytes` is
+// malformed.
+static bool UnhexlifyBytes(std::string_view bytes, uint64_t address,
+                           uint64_t addr_mask, Memory &memory,
+                           std::string &error) {
+  if (bytes.size() % 2) {
+    error = "Odd number of nibbles in bytes.";
+    return false;
+  }
 
-  for (size_t i = 0; i < FLAGS_bytes.size(); i += 2) {
-    char nibbles[] = {FLAGS_bytes[i], FLAGS_bytes[i + 1], '\0'};
+  for (size_t i = 0; i < bytes.size(); i += 2) {
+    char nibbles[] = {bytes[i], bytes[i + 1], '\0'};
     char *parsed_to = nullptr;
     auto byte_val = strtol(nibbles, &parsed_to, 16);
 
     if (parsed_to != &(nibbles[2])) {
-      std::cerr << "Invalid hex byte value '" << nibbles
-                << "' specified in --bytes." << std::endl;
-      exit(EXIT_FAILURE);
+      error = "Invalid hex byte value '" + std::string(nibbles) + "'.";
+      return false;
     }
 
-    auto byte_addr = FLAGS_address + (i / 2);
+    auto byte_addr = address + (i / 2);
     auto masked_addr = byte_addr & addr_mask;
 
-    // Make sure that if a really big number is specified for `--address`,
+    // Make sure that if a really big number is specified for `address`,
     // that we don't accidentally wrap around and start filling out low
     // byte addresses.
     if (masked_addr < byte_addr) {
-      std::cerr << "Too many bytes specified to --bytes, would result "
-                << "in a 32-bit overflow.";
-      exit(EXIT_FAILURE);
-
-    } else if (masked_addr < FLAGS_address) {
-      std::cerr << "Too many bytes specified to --bytes, would result "
-                << "in a 64-bit overflow.";
-      exit(EXIT_FAILURE);
+      error = "Too many bytes, would result in a 32-bit overflow.";
+      return false;
+
+    } else if (masked_addr < address) {
+      error = "Too many bytes, would result in a 64-bit overflow.";
+      return false;
     }
 
     memory[byte_addr] = static_cast<uint8_t>(byte_val);
   }
 
+  return true;
+}
+
+// Unhexlify the data passed to `--bytes`, and fill in `memory` with each
+// such byte.
+static Memory UnhexlifyInputBytes(uint64_t addr_mask) {
+  Memory memory;
+  std::string error;
+  if (!UnhexlifyBytes(FLAGS_bytes, FLAGS_address, addr_mask, memory, error)) {
+    std::cerr << error << " Check the value passed to --bytes." << std::endl;
+    exit(EXIT_FAILURE);
+  }
   return memory;
 }
 
@@ -142,9 +263,20 @@ class SimpleTraceManager : public remill::TraceManager {
     auto trace_it = traces.find(addr);
     if (trace_it != traces.end()) {
       return trace_it->second;
-    } else {
-      return nullptr;
     }
+
+    // Traces that have been saved to `--stream_dir` are declared again by
+    // name, as nothing keeps their old declarations from being optimized
+    // away along with the next batch.
+    if (streamed_traces.count(addr)) {
+      const auto trace_name = TraceName(addr);
+      if (auto decl = stream_module->getFunction(trace_name)) {
+        return decl;
+      }
+      return arch->DeclareLiftedFunction(trace_name, stream_module);
+    }
+
+    return nullptr;
   }
 
   // Get a definition for a lifted trace.
@@ -154,6 +286,17 @@ class SimpleTraceManager : public remill::TraceManager {
     return GetLiftedTraceDeclaration(addr);
   }
 
+  // Returns the execution profile passed to `--profile`, if any.
+  const remill::ExecutionProfile *GetExecutionProfile(void) override {
+    return profile;
+  }
+
+  // Inline small direct call targets into the traces of their callers when
+  // `--inline_call_insts` is non-zero.
+  unsigned MaxInlinedCallInstructions(uint64_t) override {
+    return static_cast<unsigned>(FLAGS_inline_call_insts);
+  }
+
   // Try to read an executable byte of memory. Returns `true` of the byte
   // at address `addr` is executable and readable, and updates the byte
   // pointed to by `byte` with the read value.
@@ -168,10 +311,96 @@ class SimpleTraceManager : public remill::TraceManager {
   }
 
  public:
+  // Try to read `size` bytes of read-only memory. The bytes passed to
+  // `--bytes` are only treated as read-only with `--fold_constant_memory`.
+  bool TryReadConstantMemory(uint64_t addr, uint64_t size,
+                             uint8_t *bytes) override {
+    if (!FLAGS_fold_constant_memory) {
+      return false;
+    }
+    for (uint64_t i = 0; i < size; ++i) {
+      auto byte_it = memory.find(addr + i);
+      if (byte_it == memory.end()) {
+        return false;
+      }
+      bytes[i] = byte_it->second;
+    }
+    return true;
+  }
+
   Memory &memory;
   std::unordered_map<uint64_t, llvm::Function *> traces;
+
+  // Addresses of the traces that have been saved to `--stream_dir`, and the
+  // module that they were lifted into.
+  std::unordered_set<uint64_t> streamed_traces;
+  const remill::Arch *arch{nullptr};
+  llvm::Module *stream_module{nullptr};
+
+  const remill::ExecutionProfile *profile{nullptr};
+  remill::OptimizationStats *stats{nullptr};
 };
 
+// Returns the optimization guide for the traces lifted using `manager`.
+static remill::OptimizationGuide
+LiftedTraceOptimizationGuide(SimpleTraceManager &manager) {
+  remill::OptimizationGuide guide = {};
+  guide.cold_entry_count = FLAGS_cold_entry_count;
+  guide.cheap_trace_ir_insts = FLAGS_cheap_trace_ir_insts;
+  guide.unoptimized_trace_ir_insts = FLAGS_unoptimized_trace_ir_insts;
+  guide.trace_time_budget_ms = FLAGS_trace_time_budget_ms;
+  guide.promote_stack_frames = FLAGS_promote_stack_frames;
+  guide.coalesce_memory_accesses = FLAGS_coalesce_memory;
+  guide.merge_traces = FLAGS_merge_traces;
+  guide.stats = manager.stats;
+  guide.read_constant_memory = [&manager](uint64_t addr, uint64_t size,
+                                          uint8_t *bytes) {
+    return manager.TryReadConstantMemory(addr, size, bytes);
+  };
+  return guide;
+}
+
+// Record the number of instructions that were decoded into the trace at
+// `trace_addr` in the statistics for `--stats_out`, if they're being kept.
+static void RecordDecodedInstructions(SimpleTraceManager &manager,
+                                      const remill::TraceLifter &trace_lifter,
+                                      uint64_t trace_addr,
+                                      llvm::Function *trace) {
+  if (manager.stats) {
+    manager.stats->traces[trace->getName().str()].num_decoded_insts =
+        trace_lifter.NumDecodedInstructions(trace_addr);
+  }
+}
+
+// Save the statistics collected for `--stats_out`.
+static bool SaveStats(const remill::OptimizationStats &stats) {
+  std::error_code ec;
+  llvm::raw_fd_ostream os(FLAGS_stats_out, ec, llvm::sys::fs::OF_Text);
+  if (ec) {
+    LOG(ERROR) << "Could not save statistics to " << FLAGS_stats_out << ": "
+               << ec.message();
+    return false;
+  }
+  remill::WriteOptimizationStats(stats, os);
+  return true;
+}
+
+// Save the timeline collected for `--trace_out`.
+static bool SaveTimeTrace(void) {
+  std::error_code ec;
+  llvm::raw_fd_ostream os(FLAGS_trace_out, ec, llvm::sys::fs::OF_Text);
+  if (!ec) {
+    llvm::timeTraceProfilerWrite(os);
+  }
+  llvm::timeTraceProfilerCleanup();
+  if (ec) {
+    LOG(ERROR) << "Could not save the timeline to " << FLAGS_trace_out << ": "
+               << ec.message();
+    return false;
+  }
+  return true;
+}
+
 // Looks for calls to a function like `__remill_function_return`, and
 // replace its state pointer with a null pointer so that the state
 // pointer never escapes.
@@ -190,6 +419,515 @@ static void MuteStateEscape(llvm::Module *module, const char *func_name) {
   }
 }
 
+// Optimize a batch of lifted traces, then move each of them into its own
+// small module, and save that module into `--stream_dir`. The manager then
+// remembers the streamed traces by address, so that it can tell the trace
+// lifter that they have already been lifted, and declare them in `module`
+// again when a later trace calls or branches to one of them.
+static bool StreamTraces(const remill::Arch *arch, llvm::Module *module,
+                         llvm::Module *semantics,
+                         SimpleTraceManager &manager,
+                         std::map<uint64_t, llvm::Function *> &batch) {
+  if (batch.empty()) {
+    return true;
+  }
+
+  if (module != semantics) {
+    remill::LinkSemantics(module, semantics);
+  }
+
+  remill::OptimizeModule(arch, module, batch,
+                         LiftedTraceOptimizationGuide(manager));
+
+  auto ok = true;
+  for (auto [trace_addr, trace] : batch) {
+    const auto trace_name = trace->getName().str();
+    llvm::Module trace_module(trace_name, module->getContext());
+    arch->PrepareModuleDataLayout(&trace_module);
+    remill::MoveFunctionIntoModule(trace, &trace_module);
+    manager.traces.erase(trace_addr);
+    manager.streamed_traces.insert(trace_addr);
+
+    std::stringstream ss;
+    ss << FLAGS_stream_dir << remill::PathSeparator() << trace_name << ".bc";
+    const auto bc_path = ss.str();
+    if (!remill::StoreModuleToFile(&trace_module, bc_path, true)) {
+      LOG(ERROR) << "Could not save LLVM bitcode to " << bc_path;
+      ok = false;
+    }
+  }
+
+  batch.clear();
+  return ok;
+}
+
+// Lift all discoverable traces starting from `entry_address` into `module`,
+// optimize them, and then move them into `dest_module`. If `module` is a thin
+// module, then the semantics are linked in from `semantics` before
+// optimizing. If any slice registers are given, then a `slice` function that
+// calls the entry trace is added to `dest_module`, and `dest_module` is
+// re-optimized. Returns `false` and fills in `error` on failure.
+static bool LiftIntoModule(const remill::Arch *arch, llvm::Module *module,
+                           llvm::Module *semantics,
+                           remill::InstructionLifter &inst_lifter,
+                           SimpleTraceManager &manager,
+                           uint64_t entry_address,
+                           std::string_view slice_inputs,
+                           std::string_view slice_outputs,
+                           llvm::Module *dest_module, std::string &error) {
+  auto &context = module->getContext();
+  const auto state_ptr_type = arch->StatePointerType();
+  const auto mem_ptr_type = arch->MemoryPointerType();
+
+  remill::TraceLifter trace_lifter(inst_lifter, manager);
+  trace_lifter.SetCountBlockExecutions(FLAGS_count_blocks);
+
+  // Lift all discoverable traces starting from `entry_address` into
+  // `module`.
+  auto record_decoded_insts = [&](uint64_t trace_addr,
+                                  llvm::Function *trace) {
+    RecordDecodedInstructions(manager, trace_lifter, trace_addr, trace);
+  };
+
+  if (!trace_lifter.Lift(entry_address, record_decoded_insts)) {
+    error = "Could not lift code at the entry address.";
+    return false;
+  }
+
+  if (module != semantics) {
+    remill::LinkSemantics(module, semantics);
+  }
+
+  // Optimize the module, but with a particular focus on only the functions
+  // that we actually lifted.
+  auto guide = LiftedTraceOptimizationGuide(manager);
+  remill::OptimizeModule(arch, module, manager.traces, guide);
+
+  llvm::Function *entry_trace = nullptr;
+  const auto make_slice = !slice_inputs.empty() || !slice_outputs.empty();
+
+  // Move the lifted code into a new module. This module will be much smaller
+  // because it won't be bogged down with all of the semantics definitions.
+  // This is a good JITing strategy: optimize the lifted code in the semantics
+  // module, move it to a new module, instrument it there, then JIT compile it.
+  for (auto &lifted_entry : manager.traces) {
+    if (lifted_entry.first == entry_address) {
+      entry_trace = lifted_entry.second;
+    }
+    remill::MoveFunctionIntoModule(lifted_entry.second, dest_module);
+
+    // If we are providing a prototype, then we'll be re-optimizing the new
+    // module, and we want everything to get inlined.
+    if (make_slice) {
+      lifted_entry.second->setLinkage(llvm::GlobalValue::InternalLinkage);
+      lifted_entry.second->removeFnAttr(llvm::Attribute::NoInline);
+      lifted_entry.second->removeFnAttr(llvm::Attribute::OptimizeNone);
+      lifted_entry.second->addFnAttr(llvm::Attribute::InlineHint);
+      lifted_entry.second->addFnAttr(llvm::Attribute::AlwaysInline);
+    }
+  }
+
+  if (FLAGS_count_blocks) {
+    remill::DefineBlockCounters(dest_module,
+                                trace_lifter.CountedBlockAddresses());
+  }
+
+  if (!make_slice) {
+    return true;
+  }
+
+  // We have a prototype, so go create a function that will call our entrypoint.
+  if (!entry_trace) {
+    error = "No trace was lifted at the entry address.";
+    return false;
+  }
+
+  llvm::SmallVector<llvm::StringRef, 4> input_reg_names;
+  llvm::SmallVector<llvm::StringRef, 4> output_reg_names;
+  llvm::StringRef(slice_inputs.data(), slice_inputs.size())
+      .split(input_reg_names, ',', -1, false /* KeepEmpty */);
+  llvm::StringRef(slice_outputs.data(), slice_outputs.size())
+      .split(output_reg_names, ',', -1, false /* KeepEmpty */);
+
+  if (input_reg_names.empty() && output_reg_names.empty()) {
+    error = "Empty lists of slice inputs and slice outputs.";
+    return false;
+  }
+
+  // Use the registers to build a function prototype.
+  llvm::SmallVector<llvm::Type *, 8> arg_types;
+  arg_types.push_back(mem_ptr_type);
+
+  for (auto &reg_name : input_reg_names) {
+    const auto reg = arch->RegisterByName(reg_name.str());
+    if (!reg) {
+      error = "Invalid register name '" + reg_name.str() +
+              "' used in input slice list.";
+      return false;
+    }
+
+    arg_types.push_back(reg->type);
+  }
+
+  const auto first_output_reg_index = arg_types.size();
+
+  // Outputs are "returned" by pointer through arguments.
+  for (auto &reg_name : output_reg_names) {
+    const auto reg = arch->RegisterByName(reg_name.str());
+    if (!reg) {
+      error = "Invalid register name '" + reg_name.str() +
+              "' used in output slice list.";
+      return false;
+    }
+
+    arg_types.push_back(llvm::PointerType::get(reg->type, 0));
+  }
+
+  const auto state_type = state_ptr_type->getPointerElementType();
+  const auto func_type =
+      llvm::FunctionType::get(mem_ptr_type, arg_types, false);
+  const auto func = llvm::Function::Create(
+      func_type, llvm::GlobalValue::ExternalLinkage, "slice", dest_module);
+
+  // Store all of the function arguments (corresponding with specific registers)
+  // into the stack-allocated `State` structure.
+  auto entry = llvm::BasicBlock::Create(context, "", func);
+  llvm::IRBuilder<> ir(entry);
+
+  const auto state_ptr = ir.CreateAlloca(state_type);
+
+  const remill::Register *pc_reg =
+      arch->RegisterByName(arch->ProgramCounterRegisterName());
+
+  CHECK(pc_reg != nullptr)
+      << "Could not find the register in the state structure "
+      << "associated with the program counter.";
+
+  // Store the program counter into the state.
+  const auto pc_reg_ptr = pc_reg->AddressOf(state_ptr, entry);
+  const auto trace_pc =
+      llvm::ConstantInt::get(pc_reg->type, entry_address, false);
+  ir.SetInsertPoint(entry);
+  ir.CreateStore(trace_pc, pc_reg_ptr);
+
+  auto args_it = func->arg_begin();
+  for (auto &reg_name : input_reg_names) {
+    const auto reg = arch->RegisterByName(reg_name.str());
+    auto &arg = *++args_it;  // Pre-increment, as first arg is memory pointer.
+    arg.setName(reg_name);
+    CHECK_EQ(arg.getType(), reg->type);
+    auto reg_ptr = reg->AddressOf(state_ptr, entry);
+    ir.SetInsertPoint(entry);
+    ir.CreateStore(&arg, reg_ptr);
+  }
+
+  llvm::Value *mem_ptr = &*func->arg_begin();
+
+  llvm::Value *trace_args[remill::kNumBlockArgs] = {};
+  trace_args[remill::kStatePointerArgNum] = state_ptr;
+  trace_args[remill::kMemoryPointerArgNum] = mem_ptr;
+  trace_args[remill::kPCArgNum] = trace_pc;
+
+  mem_ptr = ir.CreateCall(entry_trace, trace_args);
+
+  // Go read all output registers out of the state and store them
+  // into the output parameters.
+  args_it = func->arg_begin();
+  for (size_t i = 0, j = 0; i < func->arg_size(); ++i, ++args_it) {
+    if (i < first_output_reg_index) {
+      continue;
+    }
+
+    const auto &reg_name = output_reg_names[j++];
+    const auto reg = arch->RegisterByName(reg_name.str());
+    auto &arg = *args_it;
+    arg.setName(reg_name + "_output");
+
+    auto reg_ptr = reg->AddressOf(state_ptr, entry);
+    ir.SetInsertPoint(entry);
+    ir.CreateStore(ir.CreateLoad(reg->type, reg_ptr), &arg);
+  }
+
+  // Return the memory pointer, so that all memory accesses are
+  // preserved.
+  ir.CreateRet(mem_ptr);
+
+  // We want the stack-allocated `State` to be subject to scalarization
+  // and mem2reg, but to "encourage" that, we need to prevent the
+  // `alloca`d `State` from escaping.
+  MuteStateEscape(dest_module, "__remill_error");
+  MuteStateEscape(dest_module, "__remill_function_call");
+  MuteStateEscape(dest_module, "__remill_function_return");
+  MuteStateEscape(dest_module, "__remill_jump");
+  MuteStateEscape(dest_module, "__remill_missing_block");
+
+  guide.slp_vectorize = true;
+  guide.loop_vectorize = true;
+  remill::OptimizeBareModule(dest_module, guide);
+  return true;
+}
+
+// Lifting state that is kept warm across `--server` requests. Each one has
+// its own context, so that the semantics of different architectures can't
+// collide with one another. Requests are lifted into their own thin modules,
+// so the semantics module is never modified, and nothing has to be cleaned
+// out of it between requests.
+struct WarmLifter {
+  WarmLifter(std::string_view os, std::string_view arch_name)
+      : arch(remill::Arch::Get(context, os, arch_name)),
+        semantics(remill::LoadArchSemantics(arch.get())) {}
+
+  llvm::LLVMContext context;
+  const remill::Arch::ArchPtr arch;
+  const std::unique_ptr<llvm::Module> semantics;
+};
+
+using WarmLifterMap = std::map<std::string, std::unique_ptr<WarmLifter>>;
+
+// Read an address out of a request. Addresses can be given as JSON numbers
+// or, to avoid precision loss in some JSON libraries, as strings such as
+// `"0x1000"`.
+static bool GetRequestAddress(const llvm::json::Object &request,
+                              llvm::StringRef key, uint64_t &addr) {
+  const auto val = request.get(key);
+  if (!val) {
+    return true;
+  }
+
+  if (auto num = val->getAsUINT64()) {
+    addr = *num;
+    return true;
+  }
+
+  if (auto str = val->getAsString()) {
+    auto str_copy = str->str();
+    char *parsed_to = nullptr;
+    addr = strtoull(str_copy.c_str(), &parsed_to, 0);
+    return !str_copy.empty() && parsed_to == &(str_copy[str_copy.size()]);
+  }
+
+  return false;
+}
+
+// Read a comma-separated list of registers out of a request. The list can
+// also be given as a JSON array of register names.
+static bool GetRequestRegisters(const llvm::json::Object &request,
+                                llvm::StringRef key, std::string &regs) {
+  const auto val = request.get(key);
+  if (!val) {
+    return true;
+  }
+
+  if (auto str = val->getAsString()) {
+    regs = str->str();
+    return true;
+  }
+
+  if (auto arr = val->getAsArray()) {
+    for (const auto &elem : *arr) {
+      auto reg_name = elem.getAsString();
+      if (!reg_name) {
+        return false;
+      }
+      if (!regs.empty()) {
+        regs.push_back(',');
+      }
+      regs.append(reg_name->data(), reg_name->size());
+    }
+    return true;
+  }
+
+  return false;
+}
+
+// Handle a single `--server` request, returning the JSON response.
+//
+// Requests have the form:
+//
+//    {"id": ..., "os": "linux", "arch": "amd64", "address": 4096,
+//     "entry_address": 4096, "bytes": "c3", "slice_inputs": "RDI",
+//     "slice_outputs": ["RAX"], "format": "ir"}
+//
+// Only `bytes` is required; `os` and `arch` default to `--os` and `--arch`,
+// and `format` is one of `ir` (default) or `bc` (base64-encoded bitcode).
+static llvm::json::Object HandleRequest(WarmLifterMap &lifters,
+                                        llvm::StringRef line) {
+  llvm::json::Object response;
+  auto fail = [&response](std::string message) {
+    response["ok"] = false;
+    response["error"] = std::move(message);
+    return std::move(response);
+  };
+
+  auto parsed = llvm::json::parse(line);
+  if (!parsed) {
+    return fail(llvm::toString(parsed.takeError()));
+  }
+
+  const auto request = parsed->getAsObject();
+  if (!request) {
+    return fail("Request is not a JSON object.");
+  }
+
+  if (auto id = request->get("id")) {
+    response["id"] = *id;
+  }
+
+  std::string os = FLAGS_os;
+  std::string arch_name = FLAGS_arch;
+  std::string format = "ir";
+  std::string bytes;
+  std::string slice_inputs;
+  std::string slice_outputs;
+  uint64_t address = 0;
+
+  if (auto val = request->getString("os")) {
+    os = val->str();
+  }
+  if (auto val = request->getString("arch")) {
+    arch_name = val->str();
+  }
+  if (auto val = request->getString("format")) {
+    format = val->str();
+  }
+  if (auto val = request->getString("bytes")) {
+    bytes = val->str();
+  }
+
+  if (remill::kOSInvalid == remill::GetOSName(os)) {
+    return fail("Invalid operating system name '" + os + "'.");
+  }
+  if (remill::kArchInvalid == remill::GetArchName(arch_name)) {
+    return fail("Invalid architecture name '" + arch_name + "'.");
+  }
+  if (format != "ir" && format != "bc") {
+    return fail("Invalid output format '" + format + "'.");
+  }
+  if (bytes.empty()) {
+    return fail("Missing or empty 'bytes'.");
+  }
+  if (!GetRequestAddress(*request, "address", address)) {
+    return fail("Invalid 'address'.");
+  }
+  auto entry_address = address;
+  if (!GetRequestAddress(*request, "entry_address", entry_address)) {
+    return fail("Invalid 'entry_address'.");
+  }
+  if (!GetRequestRegisters(*request, "slice_inputs", slice_inputs) ||
+      !GetRequestRegisters(*request, "slice_outputs", slice_outputs)) {
+    return fail("Invalid 'slice_inputs' or 'slice_outputs'.");
+  }
+
+  auto &lifter = lifters[os + ":" + arch_name];
+  if (!lifter) {
+    lifter = std::make_unique<WarmLifter>(os, arch_name);
+  }
+
+  const auto arch = lifter->arch.get();
+  const uint64_t addr_mask = ~0ULL >> (64UL - arch->address_size);
+  if (address != (address & addr_mask) ||
+      entry_address != (entry_address & addr_mask)) {
+    return fail("Address does not fit into the architecture's address size.");
+  }
+
+  std::string error;
+  Memory memory;
+  if (!UnhexlifyBytes(bytes, address, addr_mask, memory, error)) {
+    return fail(error);
+  }
+
+  const auto semantics = lifter->semantics.get();
+  const auto module =
+      remill::CreateThinModule(arch, semantics, "lifted_traces");
+  const remill::IntrinsicTable intrinsics(module.get());
+  remill::InstructionLifter inst_lifter(arch, &intrinsics, semantics);
+  inst_lifter.SetDirectAtomics(FLAGS_direct_atomics);
+
+  SimpleTraceManager manager(memory);
+  llvm::Module dest_module("lifted_code", lifter->context);
+  arch->PrepareModuleDataLayout(&dest_module);
+
+  if (!LiftIntoModule(arch, module.get(), semantics, inst_lifter, manager,
+                      entry_address, slice_inputs, slice_outputs,
+                      &dest_module, error)) {
+    return fail(error);
+  }
+
+  if (auto verify_error = remill::VerifyModuleMsg(&dest_module)) {
+    return fail(*verify_error);
+  }
+
+  std::string output;
+  llvm::raw_string_ostream output_stream(output);
+  if (format == "ir") {
+    dest_module.print(output_stream, nullptr);
+    output_stream.flush();
+    response["ir"] = std::move(output);
+  } else {
+    llvm::WriteBitcodeToFile(dest_module, output_stream);
+    output_stream.flush();
+    response["bitcode"] = llvm::encodeBase64(output);
+  }
+
+  response["ok"] = true;
+  return response;
+}
+
+// Serve lift requests from stdin until it is closed. Per-request latencies
+// are reported once all requests have been handled.
+static int Serve(void) {
+  WarmLifterMap lifters;
+  std::vector<double> warm_latencies;
+  std::vector<double> cold_latencies;
+  std::string line;
+
+  while (std::getline(std::cin, line)) {
+    if (line.empty()) {
+      continue;
+    }
+
+    // Only the time spent handling the request is measured, not the time
+    // spent writing out the response. Requests that had to load an
+    // architecture are cold starts, and are reported separately.
+    const auto num_lifters = lifters.size();
+    const auto start = std::chrono::steady_clock::now();
+    auto response = HandleRequest(lifters, line);
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto latency =
+        std::chrono::duration<double, std::micro>(end - start).count();
+    if (lifters.size() != num_lifters) {
+      cold_latencies.push_back(latency);
+    } else {
+      warm_latencies.push_back(latency);
+    }
+
+    llvm::outs() << llvm::json::Value(std::move(response)) << '\n';
+    llvm::outs().flush();
+  }
+
+  std::cerr << "Served " << (warm_latencies.size() + cold_latencies.size())
+            << " requests";
+  if (!cold_latencies.empty()) {
+    std::cerr << "; " << cold_latencies.size() << " cold starts, max "
+              << *std::max_element(cold_latencies.begin(),
+                                   cold_latencies.end())
+              << "us";
+  }
+  if (!warm_latencies.empty()) {
+    std::sort(warm_latencies.begin(), warm_latencies.end());
+    const auto percentile = [&warm_latencies](size_t p) {
+      return warm_latencies[((warm_latencies.size() - 1u) * p) / 100u];
+    };
+    std::cerr << "; warm latency p50 " << percentile(50) << "us, p99 "
+              << percentile(99) << "us, max " << warm_latencies.back()
+              << "us";
+  }
+  std::cerr << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
 static void SetVersion(void) {
   std::stringstream ss;
   auto vs = remill::version::GetVersionString();
@@ -220,6 +958,18 @@ int main(int argc, char *argv[]) {
   google::ParseCommandLineFlags(&argc, &argv, true);
   google::InitGoogleLogging(argv[0]);
 
+  // Stamping needs the bodies of the semantics functions, but thin modules,
+  // which streaming and the server always lift into, only declare them.
+  if (FLAGS_inline_semantics &&
+      (FLAGS_thin_module || !FLAGS_stream_dir.empty() || FLAGS_server)) {
+    std::cerr << "Cannot use --inline_semantics with --thin_module, "
+              << "--stream_dir, or --server." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (FLAGS_server) {
+    return Serve();
+  }
 
   if (FLAGS_bytes.empty()) {
     std::cerr << "Please specify a sequence of hex bytes to --bytes."
@@ -237,6 +987,26 @@ int main(int argc, char *argv[]) {
     FLAGS_entry_address = FLAGS_address;
   }
 
+  if (!FLAGS_stream_dir.empty()) {
+    if (!FLAGS_slice_inputs.empty() || !FLAGS_slice_outputs.empty()) {
+      std::cerr << "Cannot use --slice_inputs or --slice_outputs with "
+                << "--stream_dir." << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (!FLAGS_ir_out.empty() || !FLAGS_bc_out.empty()) {
+      std::cerr << "Cannot use --ir_out or --bc_out with --stream_dir."
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (!remill::TryCreateDirectory(FLAGS_stream_dir)) {
+      std::cerr << "Could not create directory " << FLAGS_stream_dir
+                << " passed to --stream_dir." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   // Make sure `--address` and `--entry_address` are in-bounds for the target
   // architecture's address size.
   llvm::LLVMContext context;
@@ -257,176 +1027,121 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
-  std::unique_ptr<llvm::Module> module(remill::LoadArchSemantics(arch.get()));
-
-  const auto state_ptr_type = arch->StatePointerType();
-  const auto mem_ptr_type = arch->MemoryPointerType();
+  std::unique_ptr<llvm::Module> semantics(
+      remill::LoadArchSemantics(arch.get()));
+
+  // Lift either straight into the semantics module, or into a thin module
+  // that leaves the semantics module untouched. Streaming always uses a thin
+  // module, so that optimizing each batch doesn't also re-optimize all of
+  // the semantics.
+  std::unique_ptr<llvm::Module> thin_module;
+  llvm::Module *module = semantics.get();
+  if (FLAGS_thin_module || !FLAGS_stream_dir.empty()) {
+    thin_module =
+        remill::CreateThinModule(arch.get(), semantics.get(), "lifted_traces");
+    module = thin_module.get();
+  }
 
   Memory memory = UnhexlifyInputBytes(addr_mask);
   SimpleTraceManager manager(memory);
-  remill::IntrinsicTable intrinsics(module.get());
-  remill::InstructionLifter inst_lifter(arch, intrinsics);
-  remill::TraceLifter trace_lifter(inst_lifter, manager);
-
-  // Lift all discoverable traces starting from `--entry_address` into
-  // `module`.
-  trace_lifter.Lift(FLAGS_entry_address);
-
-  // Optimize the module, but with a particular focus on only the functions
-  // that we actually lifted.
-  remill::OptimizationGuide guide = {};
-  remill::OptimizeModule(arch, module, manager.traces, guide);
-
-  // Create a new module in which we will move all the lifted functions. Prepare
-  // the module for code of this architecture, i.e. set the data layout, triple,
-  // etc.
-  llvm::Module dest_module("lifted_code", context);
-  arch->PrepareModuleDataLayout(&dest_module);
-
-  llvm::Function *entry_trace = nullptr;
-  const auto make_slice =
-      !FLAGS_slice_inputs.empty() || !FLAGS_slice_outputs.empty();
-
-  // Move the lifted code into a new module. This module will be much smaller
-  // because it won't be bogged down with all of the semantics definitions.
-  // This is a good JITing strategy: optimize the lifted code in the semantics
-  // module, move it to a new module, instrument it there, then JIT compile it.
-  for (auto &lifted_entry : manager.traces) {
-    if (lifted_entry.first == FLAGS_entry_address) {
-      entry_trace = lifted_entry.second;
-    }
-    remill::MoveFunctionIntoModule(lifted_entry.second, &dest_module);
 
-    // If we are providing a prototype, then we'll be re-optimizing the new
-    // module, and we want everything to get inlined.
-    if (make_slice) {
-      lifted_entry.second->setLinkage(llvm::GlobalValue::InternalLinkage);
-      lifted_entry.second->removeFnAttr(llvm::Attribute::NoInline);
-      lifted_entry.second->addFnAttr(llvm::Attribute::InlineHint);
-      lifted_entry.second->addFnAttr(llvm::Attribute::AlwaysInline);
+  std::unique_ptr<remill::ExecutionProfile> profile;
+  if (!FLAGS_profile.empty()) {
+    profile = remill::LoadExecutionProfileFromFile(FLAGS_profile);
+    if (!profile) {
+      std::cerr << "Could not load the profile passed to --profile."
+                << std::endl;
+      return EXIT_FAILURE;
     }
+    manager.profile = profile.get();
   }
 
-  // We have a prototype, so go create a function that will call our entrypoint.
-  if (make_slice) {
-    CHECK_NOTNULL(entry_trace);
-
-    llvm::SmallVector<llvm::StringRef, 4> input_reg_names;
-    llvm::SmallVector<llvm::StringRef, 4> output_reg_names;
-    llvm::StringRef(FLAGS_slice_inputs)
-        .split(input_reg_names, ',', -1, false /* KeepEmpty */);
-    llvm::StringRef(FLAGS_slice_outputs)
-        .split(output_reg_names, ',', -1, false /* KeepEmpty */);
-
-    CHECK(!(input_reg_names.empty() && output_reg_names.empty()))
-        << "Empty lists passed to both --slice_inputs and --slice_outputs";
-
-    // Use the registers to build a function prototype.
-    llvm::SmallVector<llvm::Type *, 8> arg_types;
-    arg_types.push_back(mem_ptr_type);
-
-    for (auto &reg_name : input_reg_names) {
-      const auto reg = arch->RegisterByName(reg_name.str());
-      CHECK(reg != nullptr)
-          << "Invalid register name '" << reg_name.str()
-          << "' used in input slice list '" << FLAGS_slice_inputs << "'";
-
-      arg_types.push_back(reg->type);
-    }
-
-    const auto first_output_reg_index = arg_types.size();
+  remill::OptimizationStats stats;
+  if (!FLAGS_stats_out.empty()) {
+    manager.stats = &stats;
+  }
 
-    // Outputs are "returned" by pointer through arguments.
-    for (auto &reg_name : output_reg_names) {
-      const auto reg = arch->RegisterByName(reg_name.str());
-      CHECK(reg != nullptr)
-          << "Invalid register name '" << reg_name.str()
-          << "' used in output slice list '" << FLAGS_slice_outputs << "'";
+  // Trace points are nearly free when this isn't initialized.
+  const auto time_trace = !FLAGS_trace_out.empty();
+  if (time_trace) {
+    llvm::timeTraceProfilerInitialize(
+        static_cast<unsigned>(FLAGS_trace_granularity), "remill-lift");
+  }
 
-      arg_types.push_back(llvm::PointerType::get(reg->type, 0));
+  remill::IntrinsicTable intrinsics(module);
+  remill::InstructionLifter inst_lifter(arch.get(), &intrinsics,
+                                        semantics.get());
+  inst_lifter.SetDirectAtomics(FLAGS_direct_atomics);
+  inst_lifter.SetInlineSemantics(FLAGS_inline_semantics);
+
+  // Stream out traces as they are lifted. The trace lifter tells the manager
+  // about a trace before invoking our callback, so a batch can be saved as
+  // soon as it fills up. No lifted trace is ever left in `module` outside of
+  // the batch, where the module pipeline would optimize it without its
+  // budget, and then again when it's streamed.
+  if (!FLAGS_stream_dir.empty()) {
+    manager.arch = arch.get();
+    manager.stream_module = module;
+
+    remill::TraceLifter trace_lifter(inst_lifter, manager);
+    trace_lifter.SetCountBlockExecutions(FLAGS_count_blocks);
+    const auto batch_size = std::max<uint64_t>(1u, FLAGS_stream_batch_size);
+    std::map<uint64_t, llvm::Function *> batch;
+    auto ok = true;
+
+    trace_lifter.Lift(FLAGS_entry_address,
+                      [&](uint64_t trace_addr, llvm::Function *trace) {
+                        RecordDecodedInstructions(manager, trace_lifter,
+                                                  trace_addr, trace);
+                        batch.emplace(trace_addr, trace);
+                        if (batch.size() >= batch_size) {
+                          ok = StreamTraces(arch.get(), module,
+                                            semantics.get(), manager,
+                                            batch) && ok;
+
+                          // Moved traces are freed along with their modules,
+                          // so cached register pointers may now dangle.
+                          inst_lifter.ClearCache();
+                        }
+                      });
+
+    ok = StreamTraces(arch.get(), module, semantics.get(), manager, batch) &&
+         ok;
+
+    // The counters are only sized once every trace has been lifted.
+    if (FLAGS_count_blocks) {
+      llvm::Module counters_module("block_counters", context);
+      arch->PrepareModuleDataLayout(&counters_module);
+      remill::DefineBlockCounters(&counters_module,
+                                  trace_lifter.CountedBlockAddresses());
+
+      std::stringstream ss;
+      ss << FLAGS_stream_dir << remill::PathSeparator()
+         << "block_counters.bc";
+      const auto bc_path = ss.str();
+      if (!remill::StoreModuleToFile(&counters_module, bc_path, true)) {
+        LOG(ERROR) << "Could not save LLVM bitcode to " << bc_path;
+        ok = false;
+      }
     }
-
-    const auto state_type = state_ptr_type->getPointerElementType();
-    const auto func_type =
-        llvm::FunctionType::get(mem_ptr_type, arg_types, false);
-    const auto func = llvm::Function::Create(
-        func_type, llvm::GlobalValue::ExternalLinkage, "slice", &dest_module);
-
-    // Store all of the function arguments (corresponding with specific registers)
-    // into the stack-allocated `State` structure.
-    auto entry = llvm::BasicBlock::Create(context, "", func);
-    llvm::IRBuilder<> ir(entry);
-
-    const auto state_ptr = ir.CreateAlloca(state_type);
-
-    const remill::Register *pc_reg =
-        arch->RegisterByName(arch->ProgramCounterRegisterName());
-
-    CHECK(pc_reg != nullptr)
-        << "Could not find the register in the state structure "
-        << "associated with the program counter.";
-
-    // Store the program counter into the state.
-    const auto pc_reg_ptr = pc_reg->AddressOf(state_ptr, entry);
-    const auto trace_pc =
-        llvm::ConstantInt::get(pc_reg->type, FLAGS_entry_address, false);
-    ir.SetInsertPoint(entry);
-    ir.CreateStore(trace_pc, pc_reg_ptr);
-
-    auto args_it = func->arg_begin();
-    for (auto &reg_name : input_reg_names) {
-      const auto reg = arch->RegisterByName(reg_name.str());
-      auto &arg = *++args_it;  // Pre-increment, as first arg is memory pointer.
-      arg.setName(reg_name);
-      CHECK_EQ(arg.getType(), reg->type);
-      auto reg_ptr = reg->AddressOf(state_ptr, entry);
-      ir.SetInsertPoint(entry);
-      ir.CreateStore(&arg, reg_ptr);
+    if (manager.stats) {
+      ok = SaveStats(*manager.stats) && ok;
     }
-
-    llvm::Value *mem_ptr = &*func->arg_begin();
-
-    llvm::Value *trace_args[remill::kNumBlockArgs] = {};
-    trace_args[remill::kStatePointerArgNum] = state_ptr;
-    trace_args[remill::kMemoryPointerArgNum] = mem_ptr;
-    trace_args[remill::kPCArgNum] = trace_pc;
-
-    mem_ptr = ir.CreateCall(entry_trace, trace_args);
-
-    // Go read all output registers out of the state and store them
-    // into the output parameters.
-    args_it = func->arg_begin();
-    for (size_t i = 0, j = 0; i < func->arg_size(); ++i, ++args_it) {
-      if (i < first_output_reg_index) {
-        continue;
-      }
-
-      const auto &reg_name = output_reg_names[j++];
-      const auto reg = arch->RegisterByName(reg_name.str());
-      auto &arg = *args_it;
-      arg.setName(reg_name + "_output");
-
-      auto reg_ptr = reg->AddressOf(state_ptr, entry);
-      ir.SetInsertPoint(entry);
-      ir.CreateStore(ir.CreateLoad(reg->type, reg_ptr), &arg);
+    if (time_trace) {
+      ok = SaveTimeTrace() && ok;
     }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
 
-    // Return the memory pointer, so that all memory accesses are
-    // preserved.
-    ir.CreateRet(mem_ptr);
-
-    // We want the stack-allocated `State` to be subject to scalarization
-    // and mem2reg, but to "encourage" that, we need to prevent the
-    // `alloca`d `State` from escaping.
-    MuteStateEscape(&dest_module, "__remill_error");
-    MuteStateEscape(&dest_module, "__remill_function_call");
-    MuteStateEscape(&dest_module, "__remill_function_return");
-    MuteStateEscape(&dest_module, "__remill_jump");
-    MuteStateEscape(&dest_module, "__remill_missing_block");
+  llvm::Module dest_module("lifted_code", context);
+  arch->PrepareModuleDataLayout(&dest_module);
 
-    guide.slp_vectorize = true;
-    guide.loop_vectorize = true;
-    remill::OptimizeBareModule(&dest_module, guide);
+  std::string error;
+  if (!LiftIntoModule(arch.get(), module, semantics.get(), inst_lifter,
+                      manager, FLAGS_entry_address, FLAGS_slice_inputs,
+                      FLAGS_slice_outputs, &dest_module, error)) {
+    std::cerr << error << std::endl;
+    return EXIT_FAILURE;
   }
 
   int ret = EXIT_SUCCESS;
@@ -443,6 +1158,12 @@ int main(int argc, char *argv[]) {
       ret = EXIT_FAILURE;
     }
   }
+  if (manager.stats && !SaveStats(*manager.stats)) {
+    ret = EXIT_FAILURE;
+  }
+  if (time_trace && !SaveTimeTrace()) {
+    ret = EXIT_FAILURE;
+  }
 
   return ret;
 }
@@ -128,6 +128,22 @@ struct Register {
   void CompteGEPAccessors(const llvm::DataLayout &dl, llvm::Type *state_type);
 };
 
+// The parts of a decoded instruction that are needed to discover control
+// flow. See `Arch::DecodeControlFlow`.
+struct ControlFlowInfo {
+  // Length, in bytes, of the instruction.
+  uint64_t size{0};
+
+  Instruction::Category category{Instruction::kCategoryInvalid};
+
+  // Direct branch targets, as in `Instruction`.
+  uint64_t branch_taken_pc{0};
+  uint64_t branch_not_taken_pc{0};
+
+  // Whether or not the instruction may have a delay slot.
+  bool has_delay_slot{false};
+};
+
 class Arch {
  public:
   using ArchPtr = std::unique_ptr<const Arch>;
@@ -169,6 +185,14 @@ class Arch {
   // Return information about a register, given its name.
   const Register *RegisterByName(std::string_view name) const;
 
+  // Returns the address of `reg` in the current register window, computed at
+  // the end of `block`, or `nullptr` if `reg` is always at the same offset in
+  // the `State` structure. These addresses change as the program runs, so
+  // they must not be cached.
+  virtual llvm::Value *WindowedRegisterAddress(llvm::BasicBlock *block,
+                                               llvm::Value *state_ptr,
+                                               const Register *reg) const;
+
   // Returns the name of the stack pointer register.
   virtual std::string_view StackPointerRegisterName(void) const = 0;
 
@@ -231,6 +255,22 @@ class Arch {
   virtual bool DecodeInstruction(uint64_t address, std::string_view instr_bytes,
                                  Instruction &inst) const = 0;
 
+  // Decode only the length, category, and direct branch targets of an
+  // instruction. This is much cheaper than `DecodeInstruction` on some
+  // architectures, because no operands or semantics function names are
+  // produced. The default implementation does a full decode.
+  //
+  // NOTE: An implementation may accept some encodings that `DecodeInstruction`
+  //       rejects because it can't decode their operands. The trace lifter
+  //       will still report those as errors.
+  virtual bool DecodeControlFlow(uint64_t address, std::string_view instr_bytes,
+                                 ControlFlowInfo &info) const;
+
+  // Returns `true` if `DecodeControlFlow` works without first initializing
+  // this architecture from its semantics module. The default implementation
+  // of `DecodeControlFlow` does a full decode, which needs the semantics.
+  virtual bool DecodesControlFlowWithoutSemantics(void) const;
+
   // Decode an instruction that is within a delay slot.
   bool DecodeDelayedInstruction(uint64_t address, std::string_view instr_bytes,
                                 Instruction &inst) const {
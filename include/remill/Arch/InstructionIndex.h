@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace remill {
+
+class Arch;
+class Instruction;
+
+enum OSName : uint32_t;
+enum ArchName : uint32_t;
+
+// A compact index of the instructions found by a linear sweep over a range of
+// executable bytes. The sweep is split into chunks that are decoded in
+// parallel, and then stitched back together so that the result is the same
+// as a serial sweep. The sweep only decodes control flow (see
+// `Arch::DecodeControlFlow`), and only that summary of each instruction is
+// kept; full `Instruction`s are re-materialized on demand.
+class InstructionIndex {
+ public:
+  struct Entry {
+    // Direct branch targets, as in `Instruction`.
+    uint64_t branch_taken_pc;
+    uint64_t branch_not_taken_pc;
+
+    // Offset of the first byte of the instruction from `BaseAddress()`.
+    uint32_t offset;
+
+    // Number of bytes in the instruction.
+    uint8_t size;
+
+    // The `Instruction::Category` of the instruction.
+    uint8_t category;
+
+    // Whether the instruction may be followed by a delay slot.
+    bool has_delay_slot;
+  };
+
+  // Chunks of bytes smaller than this aren't worth a thread.
+  static constexpr uint64_t kDefaultMinChunkSize = 64 * 1024;
+
+  // Linear sweep `bytes`, starting at `base_address`, using `num_threads`
+  // decoder threads, each of which sweeps a chunk of at least
+  // `min_chunk_size` bytes. If `num_threads` is zero, then one thread per
+  // core is used. Each thread gets its own `llvm::LLVMContext` and `Arch`,
+  // built from `os_name` and `arch_name`. Architectures whose
+  // `DecodeControlFlow` needs the semantics module also load one copy of it
+  // per thread. Returns `nullptr` if the bytes can't be indexed.
+  static std::unique_ptr<InstructionIndex>
+  Build(OSName os_name, ArchName arch_name, uint64_t base_address,
+        std::string bytes, unsigned num_threads = 0,
+        uint64_t min_chunk_size = kDefaultMinChunkSize);
+
+  inline uint64_t BaseAddress(void) const {
+    return base_address;
+  }
+
+  // Returns `true` if `address` is within the indexed range of bytes.
+  inline bool Contains(uint64_t address) const {
+    return address >= base_address && (address - base_address) < bytes.size();
+  }
+
+  // Returns the indexed instructions, sorted by offset.
+  inline const std::vector<Entry> &Entries(void) const {
+    return entries;
+  }
+
+  // Returns the entry of the instruction starting at `address`, or `nullptr`
+  // if the linear sweep did not find an instruction starting there.
+  const Entry *Find(uint64_t address) const;
+
+  // Returns up to `max_size` indexed bytes starting at `address`.
+  std::string_view BytesAt(uint64_t address, size_t max_size) const;
+
+  // Fully decode the instruction of `entry` into `inst`, using `arch`.
+  bool Materialize(const Arch *arch, const Entry &entry,
+                   Instruction &inst) const;
+
+ private:
+  InstructionIndex(ArchName arch_name_, uint64_t base_address_,
+                   std::string bytes_);
+
+  const ArchName arch_name;
+  const uint64_t base_address;
+  const std::string bytes;
+  std::vector<Entry> entries;
+};
+
+}  // namespace remill
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace llvm {
+class MemoryBuffer;
+}  // namespace llvm
+
+namespace remill {
+
+class Arch;
+class Instruction;
+
+enum ArchName : uint32_t;
+
+// Serializes a sequence of decoded `Instruction`s into a compact, versioned
+// binary format, so that they can later be lifted without being re-decoded.
+// Register names, variable names, and semantics function names are interned
+// into a string table. Operand expressions are serialized as trees, whose
+// registers are resolved by name when the instructions are read back.
+//
+// The format uses the host's byte order, and is only meant to be read back
+// by the same version of remill that wrote it.
+class InstructionStreamWriter {
+ public:
+  explicit InstructionStreamWriter(ArchName arch_name_);
+  ~InstructionStreamWriter(void);
+
+  // Append `inst` to the stream. Returns `false` if `inst` can't be
+  // serialized, e.g. because one of its operand expressions has a
+  // non-integer constant or type.
+  bool Add(const Instruction &inst);
+
+  // Returns the number of instructions added so far.
+  inline size_t Size(void) const {
+    return inst_offsets.size();
+  }
+
+  // Write out the stream to `file_name`.
+  bool WriteToFile(const std::filesystem::path &file_name) const;
+
+ private:
+  InstructionStreamWriter(void) = delete;
+
+  uint32_t Intern(std::string_view str);
+
+  const ArchName arch_name;
+
+  // Serialized instruction records, and the offset of each record.
+  std::string records;
+  std::vector<uint64_t> inst_offsets;
+
+  // Interned strings.
+  std::vector<std::string> strings;
+  std::unordered_map<std::string, uint32_t> string_ids;
+};
+
+// Reads instructions serialized by an `InstructionStreamWriter`. The file is
+// memory-mapped, and instructions are materialized directly from the mapped
+// records, without running the decoder.
+class InstructionStream {
+ public:
+  ~InstructionStream(void);
+
+  // Map in the instruction stream in `file_name`. Returns `nullptr` if the
+  // file can't be read, or if it is not a valid instruction stream.
+  static std::unique_ptr<InstructionStream>
+  Open(const std::filesystem::path &file_name);
+
+  // Name of the architecture that decoded the instructions.
+  inline ArchName GetArchName(void) const {
+    return arch_name;
+  }
+
+  // Returns the number of instructions in the stream.
+  inline size_t Size(void) const {
+    return num_insts;
+  }
+
+  // Returns the address of the `i`th instruction, without materializing it.
+  uint64_t Address(size_t i) const;
+
+  // Materialize the `i`th instruction into `inst`, using `arch` to resolve
+  // register names and LLVM types. The result can be given directly to
+  // `InstructionLifter::LiftIntoBlock`.
+  bool Read(size_t i, const Arch *arch, Instruction &inst) const;
+
+ private:
+  InstructionStream(void) = default;
+
+  std::string_view String(uint32_t id) const;
+
+  std::unique_ptr<llvm::MemoryBuffer> buffer;
+  std::string_view data;
+
+  ArchName arch_name;
+  size_t num_insts{0};
+  size_t num_strings{0};
+  uint64_t inst_offsets_offset{0};
+  uint64_t strings_offset{0};
+};
+
+}  // namespace remill
@@ -89,6 +89,8 @@ class SyncHyperCall {
     kSPARCTrapCondNEG,
     kSPARCTrapCondVC,
     kSPARCTrapCondVS,
+
+    kSPARCWindowOverflow,  // Overflow when SAVEing a register window.
   };
 } __attribute__((packed));
 
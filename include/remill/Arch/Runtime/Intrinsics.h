@@ -70,6 +70,35 @@ __remill_write_memory_f80(Memory *, addr_t, const native_float80_t &);
 [[gnu::used]] extern Memory *__remill_write_memory_f128(Memory *, addr_t,
                                                         float128_t);
 
+// Bulk memory intrinsics. These let runtimes implement string operations,
+// e.g. x86's `REP MOVS`, with `memmove`, `memset`, and `memcmp`, rather than
+// one memory access intrinsic call per element.
+
+// Copy `size` bytes from `src` to `dst`. Like `memmove`, the source and
+// destination may overlap.
+[[gnu::used, gnu::const]] extern Memory *
+__remill_memory_copy(Memory *, addr_t dst, addr_t src, addr_t size);
+
+// Fill `count` consecutive elements starting at `dst` with `value`.
+[[gnu::used, gnu::const]] extern Memory *
+__remill_memory_fill_8(Memory *, addr_t dst, uint8_t value, addr_t count);
+
+[[gnu::used, gnu::const]] extern Memory *
+__remill_memory_fill_16(Memory *, addr_t dst, uint16_t value, addr_t count);
+
+[[gnu::used, gnu::const]] extern Memory *
+__remill_memory_fill_32(Memory *, addr_t dst, uint32_t value, addr_t count);
+
+[[gnu::used, gnu::const]] extern Memory *
+__remill_memory_fill_64(Memory *, addr_t dst, uint64_t value, addr_t count);
+
+// Compare the `size` bytes starting at `lhs` with those starting at `rhs`,
+// and return the number of leading bytes that are the same, i.e. the offset
+// of the first differing byte, or `size` if there is none. No bytes past the
+// first differing byte are read.
+[[gnu::used, gnu::const]] extern addr_t
+__remill_memory_compare(Memory *, addr_t lhs, addr_t rhs, addr_t size);
+
 [[gnu::used, gnu::const]] extern uint8_t __remill_undefined_8(void);
 
 [[gnu::used, gnu::const]] extern uint16_t __remill_undefined_16(void);
@@ -1097,6 +1097,114 @@ ALWAYS_INLINE static bool BNot(bool a) {
                               make_float_broadcast(F##op, 32, floats) \
                                   make_float_broadcast(F##op, 64, doubles)
 
+// Binary comparison broadcast operator. Each element of the result has all
+// of its bits set if the comparison is true, and is zero otherwise.
+#define MAKE_CMP_BROADCAST(op, size, accessor) \
+  template <typename T> \
+  ALWAYS_INLINE static T op##V##size(const T &L, const T &R) { \
+    typedef typename VectorType<T>::BT BT; \
+    T ret{}; \
+    _Pragma("unroll") for (auto i = 0UL; i < NumVectorElems(L); ++i) { \
+      ret.elems[i] = op(L.elems[i], R.elems[i]) \
+                         ? static_cast<BT>(~static_cast<BT>(0)) \
+                         : static_cast<BT>(0); \
+    } \
+    return ret; \
+  }
+
+#ifdef REMILL_NATIVE_VECTORS
+
+template <typename N, typename T>
+ALWAYS_INLINE static N _ToNativeV(const T &vec) {
+  static_assert(sizeof(N) == sizeof(T), "Invalid native vector type.");
+  N ret;
+  __builtin_memcpy(&ret, &vec, sizeof(ret));
+  return ret;
+}
+
+template <typename T, typename N>
+ALWAYS_INLINE static T _FromNativeV(const N &vec) {
+  static_assert(sizeof(N) == sizeof(T), "Invalid native vector type.");
+  T ret;
+  __builtin_memcpy(&ret, &vec, sizeof(ret));
+  return ret;
+}
+
+// Binary broadcast operator, as a single vector operation.
+#  define MAKE_NATIVE_BIN_BROADCAST(op, size, native_op) \
+    template <typename T> \
+    ALWAYS_INLINE static T op##V##size(const T &L, const T &R) { \
+      typedef typename NativeVectorType<T>::UT NT; \
+      return _FromNativeV<T>(_ToNativeV<NT>(L) native_op _ToNativeV<NT>(R)); \
+    }
+
+// Unary broadcast operator, as a single vector operation.
+#  define MAKE_NATIVE_UN_BROADCAST(op, size, native_op) \
+    template <typename T> \
+    ALWAYS_INLINE static T op##V##size(const T &R) { \
+      typedef typename NativeVectorType<T>::UT NT; \
+      return _FromNativeV<T>(native_op _ToNativeV<NT>(R)); \
+    }
+
+// Comparison broadcast operator, as a single vector comparison. Comparing
+// native vectors produces all-ones or all-zeros elements. This uses the
+// signedness of `T`'s elements.
+#  define MAKE_NATIVE_CMP_BROADCAST(op, size, native_op) \
+    template <typename T> \
+    ALWAYS_INLINE static T op##V##size(const T &L, const T &R) { \
+      typedef typename NativeVectorType<T>::T NT; \
+      return _FromNativeV<T>(_ToNativeV<NT>(L) native_op _ToNativeV<NT>(R)); \
+    }
+
+#  define MAKE_NATIVE_BROADCASTS(op, native_op, make_int_broadcast, \
+                                 make_float_broadcast) \
+    make_int_broadcast(U##op, 8, native_op) \
+    make_int_broadcast(U##op, 16, native_op) \
+    make_int_broadcast(U##op, 32, native_op) \
+    make_int_broadcast(U##op, 64, native_op) \
+    make_int_broadcast(S##op, 8, native_op) \
+    make_int_broadcast(S##op, 16, native_op) \
+    make_int_broadcast(S##op, 32, native_op) \
+    make_int_broadcast(S##op, 64, native_op) \
+    make_float_broadcast(F##op, 32, native_op) \
+    make_float_broadcast(F##op, 64, native_op)
+
+// Integer division and shifts stay as per-element operations, because their
+// scalar versions are defined for inputs (e.g. shifting by the element size)
+// where the vector instructions are not.
+MAKE_NATIVE_BROADCASTS(Add, +, MAKE_NATIVE_BIN_BROADCAST,
+                       MAKE_NATIVE_BIN_BROADCAST)
+MAKE_NATIVE_BROADCASTS(Sub, -, MAKE_NATIVE_BIN_BROADCAST,
+                       MAKE_NATIVE_BIN_BROADCAST)
+MAKE_NATIVE_BROADCASTS(Mul, *, MAKE_NATIVE_BIN_BROADCAST,
+                       MAKE_NATIVE_BIN_BROADCAST)
+MAKE_BROADCASTS(Div, MAKE_BIN_BROADCAST, MAKE_NOP)
+MAKE_NATIVE_BROADCASTS(Div, /, MAKE_NOP, MAKE_NATIVE_BIN_BROADCAST)
+MAKE_BROADCASTS(Rem, MAKE_BIN_BROADCAST, MAKE_NOP)
+MAKE_NATIVE_BROADCASTS(And, &, MAKE_NATIVE_BIN_BROADCAST, MAKE_NOP)
+MAKE_NATIVE_BROADCASTS(AndN, &~, MAKE_NATIVE_BIN_BROADCAST, MAKE_NOP)
+MAKE_NATIVE_BROADCASTS(Or, |, MAKE_NATIVE_BIN_BROADCAST, MAKE_NOP)
+MAKE_NATIVE_BROADCASTS(Xor, ^, MAKE_NATIVE_BIN_BROADCAST, MAKE_NOP)
+MAKE_BROADCASTS(Shl, MAKE_BIN_BROADCAST, MAKE_NOP)
+MAKE_BROADCASTS(Shr, MAKE_BIN_BROADCAST, MAKE_NOP)
+MAKE_NATIVE_BROADCASTS(Neg, -, MAKE_NATIVE_UN_BROADCAST,
+                       MAKE_NATIVE_UN_BROADCAST)
+MAKE_NATIVE_BROADCASTS(Not, ~, MAKE_NATIVE_UN_BROADCAST, MAKE_NOP)
+
+MAKE_NATIVE_BROADCASTS(CmpEq, ==, MAKE_NATIVE_CMP_BROADCAST, MAKE_NOP)
+MAKE_NATIVE_BROADCASTS(CmpNeq, !=, MAKE_NATIVE_CMP_BROADCAST, MAKE_NOP)
+MAKE_NATIVE_BROADCASTS(CmpLt, <, MAKE_NATIVE_CMP_BROADCAST, MAKE_NOP)
+MAKE_NATIVE_BROADCASTS(CmpLte, <=, MAKE_NATIVE_CMP_BROADCAST, MAKE_NOP)
+MAKE_NATIVE_BROADCASTS(CmpGt, >, MAKE_NATIVE_CMP_BROADCAST, MAKE_NOP)
+MAKE_NATIVE_BROADCASTS(CmpGte, >=, MAKE_NATIVE_CMP_BROADCAST, MAKE_NOP)
+
+#  undef MAKE_NATIVE_BIN_BROADCAST
+#  undef MAKE_NATIVE_UN_BROADCAST
+#  undef MAKE_NATIVE_CMP_BROADCAST
+#  undef MAKE_NATIVE_BROADCASTS
+
+#else
+
 MAKE_BROADCASTS(Add, MAKE_BIN_BROADCAST, MAKE_BIN_BROADCAST)
 MAKE_BROADCASTS(Sub, MAKE_BIN_BROADCAST, MAKE_BIN_BROADCAST)
 MAKE_BROADCASTS(Mul, MAKE_BIN_BROADCAST, MAKE_BIN_BROADCAST)
@@ -1111,8 +1219,18 @@ MAKE_BROADCASTS(Shr, MAKE_BIN_BROADCAST, MAKE_NOP)
 MAKE_BROADCASTS(Neg, MAKE_UN_BROADCAST, MAKE_NOP)
 MAKE_BROADCASTS(Not, MAKE_UN_BROADCAST, MAKE_NOP)
 
+MAKE_BROADCASTS(CmpEq, MAKE_CMP_BROADCAST, MAKE_NOP)
+MAKE_BROADCASTS(CmpNeq, MAKE_CMP_BROADCAST, MAKE_NOP)
+MAKE_BROADCASTS(CmpLt, MAKE_CMP_BROADCAST, MAKE_NOP)
+MAKE_BROADCASTS(CmpLte, MAKE_CMP_BROADCAST, MAKE_NOP)
+MAKE_BROADCASTS(CmpGt, MAKE_CMP_BROADCAST, MAKE_NOP)
+MAKE_BROADCASTS(CmpGte, MAKE_CMP_BROADCAST, MAKE_NOP)
+
+#endif  // REMILL_NATIVE_VECTORS
+
 #undef MAKE_BIN_BROADCAST
 #undef MAKE_UN_BROADCAST
+#undef MAKE_CMP_BROADCAST
 
 // Binary broadcast operator.
 #define MAKE_ACCUMULATE(op, size, accessor) \
@@ -327,6 +327,95 @@ MAKE_VECTOR(double, float64, 2, 128, 16);
 MAKE_VECTOR(double, float64, 4, 256, 32);
 MAKE_VECTOR(double, float64, 8, 512, 64);
 
+#ifdef REMILL_NATIVE_VECTORS
+
+// Native vector types, which Clang lowers to LLVM vector types, e.g.
+// `<4 x float>` for `float32v4_t`. These are only used for the values inside
+// of the vector operators (e.g. `FAddV32`), so that those become a single
+// vector instruction instead of one instruction per element. The `State`
+// structure keeps using the array-based vector types above, so its layout is
+// the same in both build modes.
+//
+// `UT` is the native type with unsigned elements, on which integer operators
+// are performed so that they wrap like the scalar operators do.
+template <typename T>
+struct NativeVectorType;
+
+#  define MAKE_NATIVE_VECTOR(base_type, unsigned_base_type, prefix, nelems, \
+                             width_bytes) \
+    template <> \
+    struct NativeVectorType<prefix##v##nelems##_t> { \
+      typedef base_type T __attribute__((vector_size(width_bytes))); \
+      typedef unsigned_base_type UT __attribute__((vector_size(width_bytes))); \
+    };
+
+MAKE_NATIVE_VECTOR(uint8_t, uint8_t, uint8, 1, 1)
+MAKE_NATIVE_VECTOR(uint8_t, uint8_t, uint8, 2, 2)
+MAKE_NATIVE_VECTOR(uint8_t, uint8_t, uint8, 4, 4)
+MAKE_NATIVE_VECTOR(uint8_t, uint8_t, uint8, 8, 8)
+MAKE_NATIVE_VECTOR(uint8_t, uint8_t, uint8, 16, 16)
+MAKE_NATIVE_VECTOR(uint8_t, uint8_t, uint8, 32, 32)
+MAKE_NATIVE_VECTOR(uint8_t, uint8_t, uint8, 64, 64)
+
+MAKE_NATIVE_VECTOR(uint16_t, uint16_t, uint16, 1, 2)
+MAKE_NATIVE_VECTOR(uint16_t, uint16_t, uint16, 2, 4)
+MAKE_NATIVE_VECTOR(uint16_t, uint16_t, uint16, 4, 8)
+MAKE_NATIVE_VECTOR(uint16_t, uint16_t, uint16, 8, 16)
+MAKE_NATIVE_VECTOR(uint16_t, uint16_t, uint16, 16, 32)
+MAKE_NATIVE_VECTOR(uint16_t, uint16_t, uint16, 32, 64)
+
+MAKE_NATIVE_VECTOR(uint32_t, uint32_t, uint32, 1, 4)
+MAKE_NATIVE_VECTOR(uint32_t, uint32_t, uint32, 2, 8)
+MAKE_NATIVE_VECTOR(uint32_t, uint32_t, uint32, 4, 16)
+MAKE_NATIVE_VECTOR(uint32_t, uint32_t, uint32, 8, 32)
+MAKE_NATIVE_VECTOR(uint32_t, uint32_t, uint32, 16, 64)
+
+MAKE_NATIVE_VECTOR(uint64_t, uint64_t, uint64, 1, 8)
+MAKE_NATIVE_VECTOR(uint64_t, uint64_t, uint64, 2, 16)
+MAKE_NATIVE_VECTOR(uint64_t, uint64_t, uint64, 4, 32)
+MAKE_NATIVE_VECTOR(uint64_t, uint64_t, uint64, 8, 64)
+
+MAKE_NATIVE_VECTOR(int8_t, uint8_t, int8, 1, 1)
+MAKE_NATIVE_VECTOR(int8_t, uint8_t, int8, 2, 2)
+MAKE_NATIVE_VECTOR(int8_t, uint8_t, int8, 4, 4)
+MAKE_NATIVE_VECTOR(int8_t, uint8_t, int8, 8, 8)
+MAKE_NATIVE_VECTOR(int8_t, uint8_t, int8, 16, 16)
+MAKE_NATIVE_VECTOR(int8_t, uint8_t, int8, 32, 32)
+MAKE_NATIVE_VECTOR(int8_t, uint8_t, int8, 64, 64)
+
+MAKE_NATIVE_VECTOR(int16_t, uint16_t, int16, 1, 2)
+MAKE_NATIVE_VECTOR(int16_t, uint16_t, int16, 2, 4)
+MAKE_NATIVE_VECTOR(int16_t, uint16_t, int16, 4, 8)
+MAKE_NATIVE_VECTOR(int16_t, uint16_t, int16, 8, 16)
+MAKE_NATIVE_VECTOR(int16_t, uint16_t, int16, 16, 32)
+MAKE_NATIVE_VECTOR(int16_t, uint16_t, int16, 32, 64)
+
+MAKE_NATIVE_VECTOR(int32_t, uint32_t, int32, 1, 4)
+MAKE_NATIVE_VECTOR(int32_t, uint32_t, int32, 2, 8)
+MAKE_NATIVE_VECTOR(int32_t, uint32_t, int32, 4, 16)
+MAKE_NATIVE_VECTOR(int32_t, uint32_t, int32, 8, 32)
+MAKE_NATIVE_VECTOR(int32_t, uint32_t, int32, 16, 64)
+
+MAKE_NATIVE_VECTOR(int64_t, uint64_t, int64, 1, 8)
+MAKE_NATIVE_VECTOR(int64_t, uint64_t, int64, 2, 16)
+MAKE_NATIVE_VECTOR(int64_t, uint64_t, int64, 4, 32)
+MAKE_NATIVE_VECTOR(int64_t, uint64_t, int64, 8, 64)
+
+MAKE_NATIVE_VECTOR(float, float, float32, 1, 4)
+MAKE_NATIVE_VECTOR(float, float, float32, 2, 8)
+MAKE_NATIVE_VECTOR(float, float, float32, 4, 16)
+MAKE_NATIVE_VECTOR(float, float, float32, 8, 32)
+MAKE_NATIVE_VECTOR(float, float, float32, 16, 64)
+
+MAKE_NATIVE_VECTOR(double, double, float64, 1, 8)
+MAKE_NATIVE_VECTOR(double, double, float64, 2, 16)
+MAKE_NATIVE_VECTOR(double, double, float64, 4, 32)
+MAKE_NATIVE_VECTOR(double, double, float64, 8, 64)
+
+#  undef MAKE_NATIVE_VECTOR
+
+#endif  // REMILL_NATIVE_VECTORS
+
 #define NumVectorElems(val) \
   static_cast<addr_t>(VectorType<decltype(val)>::kNumElems)
 
@@ -289,6 +289,17 @@ struct PSR {
   uint8_t gl;
 } __attribute__((packed));
 
+#if defined(REMILL_SPARC_WINDOW_RING)
+
+// Number of register windows in `State::window_regs`. The runtime should
+// start out with `CANSAVE` equal to `kNumRegisterWindows - 2`, as in SPARC v9.
+static constexpr unsigned kNumRegisterWindows = 8;
+
+// Each window adds eight inputs and eight locals to the ring. Its outputs are
+// the inputs of the next window.
+static constexpr unsigned kNumWindowedRegisters = kNumRegisterWindows * 16;
+#endif
+
 struct RegisterWindow {
   volatile addr_t _0;
   addr_t l0;
@@ -356,6 +367,16 @@ struct alignas(16) SPARC64State : public ArchState {
   static_assert(sizeof(RegisterWindow *) == 8,
                 "Invalid size of `RegisterWindow`");
 #endif
+
+#if defined(REMILL_SPARC_WINDOW_RING)
+
+  // The inputs and locals of every register window. In window `CWP`, `%iN`
+  // is `window_regs[(CWP * 16 + N) % kNumWindowedRegisters]`, `%lN` is eight
+  // slots after `%iN`, and `%oN` is the `%iN` of window `CWP + 1`. The `%i`,
+  // `%l`, and `%o` registers in `gpr` go unused. These go after `window` so
+  // that enabling the ring doesn't change the offsets of any registers.
+  Reg window_regs[kNumWindowedRegisters];
+#endif
 };
 
 struct State : public SPARC64State {};
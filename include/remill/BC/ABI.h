@@ -40,6 +40,11 @@ extern const std::string_view kBranchTakenVariableName;
 
 extern const std::string_view kInvalidInstructionISelName;
 extern const std::string_view kUnsupportedInstructionISelName;
+extern const std::string_view kAtomicISelPrefix;
 extern const std::string_view kIgnoreNextPCVariableName;
 
+extern const std::string_view kBlockCountsVariableName;
+extern const std::string_view kBlockPCsVariableName;
+extern const std::string_view kNumBlockCountsVariableName;
+
 }  // namespace remill
@@ -66,6 +66,13 @@ class InstructionLifter {
 
   InstructionLifter(const Arch *arch_, const IntrinsicTable *intrinsics_);
 
+  // Lift into the module of `intrinsics_`, but look up the semantics functions
+  // in `semantics_`. The semantics functions are declared in the lifted module
+  // as they are needed, and `semantics_` is never modified, so one semantics
+  // module can be shared by many thin lifted modules. See `LinkSemantics`.
+  InstructionLifter(const Arch *arch_, const IntrinsicTable *intrinsics_,
+                    llvm::Module *semantics_);
+
   // Lift a single instruction into a basic block. `is_delayed` signifies that
   // this instruction will execute within the delay slot of another instruction.
   virtual LiftStatus LiftIntoBlock(Instruction &inst, llvm::BasicBlock *block,
@@ -88,6 +95,24 @@ class InstructionLifter {
   // Clear out the cache of the current register values/addresses loaded.
   void ClearCache(void) const;
 
+  // Lift atomic read-modify-write instructions (e.g. x86 `LOCK ADD`) using
+  // their `ATOMIC_`-prefixed semantics functions, which call the atomic memory
+  // intrinsics (e.g. `__remill_fetch_and_add_32`) directly, instead of
+  // surrounding them with `__remill_atomic_begin` and `__remill_atomic_end`.
+  // Atomic instructions without such a semantics function are still
+  // surrounded, so a runtime must make those regions atomic with respect to
+  // the atomic memory intrinsics.
+  void SetDirectAtomics(bool enable);
+
+  // Stamp the body of each instruction's semantics function into the lifted
+  // block, instead of calling it. The body comes from a template that is made
+  // once per semantics function, and that has its callees inlined and has
+  // been simplified, so that the optimizer doesn't redo this work for every
+  // lifted instruction. Semantics functions whose simplified bodies still
+  // have control flow are called as usual, as are all semantics functions
+  // when lifting into a thin module.
+  void SetInlineSemantics(bool enable);
+
  protected:
   // Lift an operand to an instruction.
   virtual llvm::Value *LiftOperand(Instruction &inst, llvm::BasicBlock *block,
@@ -66,6 +66,14 @@ class IntrinsicTable {
   llvm::Function *const write_memory_f80;
   llvm::Function *const write_memory_f128;
 
+  // Bulk memory intrinsics.
+  llvm::Function *const memory_copy;
+  llvm::Function *const memory_fill_8;
+  llvm::Function *const memory_fill_16;
+  llvm::Function *const memory_fill_32;
+  llvm::Function *const memory_fill_64;
+  llvm::Function *const memory_compare;
+
   // Memory barriers.
   llvm::Function *const barrier_load_load;
   llvm::Function *const barrier_load_store;
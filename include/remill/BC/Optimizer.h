@@ -30,24 +30,164 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 namespace llvm {
 class Function;
+class raw_ostream;
 }  // namespace llvm
 namespace remill {
 
 class Arch;
 
+// Reads `size` bytes of memory starting at `addr` into `bytes`. Returns `false`
+// if any of those bytes aren't known to be constant, i.e. read-only.
+using ConstantMemoryReader =
+    std::function<bool(uint64_t addr, uint64_t size, uint8_t *bytes)>;
+
+// Statistics about one trace optimized by `OptimizeModule`. Pass times are
+// wall times, in seconds, and are summed over every time that the pass ran.
+struct TraceStats {
+  // Number of instructions decoded and lifted into the trace. This isn't known
+  // to the optimizer, and so is filled in by the user of the trace lifter
+  // (see `TraceLifter::NumDecodedInstructions`).
+  uint64_t num_decoded_insts{0};
+
+  // Number of LLVM instructions in the trace before and after optimization.
+  // "Before" is once the semantics functions have been inlined into the
+  // trace, as the lifted calls to them say little about its size.
+  uint64_t num_ir_insts_before{0};
+  uint64_t num_ir_insts_after{0};
+
+  // Number of calls to memory read and write intrinsics in the trace before
+  // and after optimization. These are made by the semantics functions, so
+  // "before" is also once those have been inlined.
+  uint64_t num_memory_intrinsics_before{0};
+  uint64_t num_memory_intrinsics_after{0};
+
+  // Wall time, in seconds, of each step of optimizing the trace, e.g. the
+  // `"function_pipeline"`.
+  std::map<std::string, double> pass_seconds;
+
+  // Wall time, in seconds, of each LLVM pass in the function pipelines run
+  // over the trace, by pass name, as in `-time-passes`.
+  std::map<std::string, double> llvm_pass_seconds;
+
+  // Why the trace was optimized less than normal because it went over one of
+  // the budgets of the `OptimizationGuide`, or empty if it wasn't. One of
+  // `"cheap_pipeline"`, `"unoptimized"`, or `"time_budget"`.
+  std::string demotion;
+};
+
+// Statistics collected by `OptimizeModule` and `OptimizeBareModule`. The same
+// `OptimizationStats` can be passed to many calls, e.g. one per batch of
+// traces.
+struct OptimizationStats {
+  // Statistics about each trace, indexed by the name of the trace.
+  std::map<std::string, TraceStats> traces;
+
+  // Wall time, in seconds, of the passes that run over whole modules.
+  std::map<std::string, double> pass_seconds;
+
+  // Wall time, in seconds, of each LLVM pass in the pipelines that run over
+  // whole modules, by pass name, as in `-time-passes`.
+  std::map<std::string, double> llvm_pass_seconds;
+};
+
+// Write out `stats` as a JSON object.
+void WriteOptimizationStats(const OptimizationStats &stats,
+                            llvm::raw_ostream &os);
+
 struct OptimizationGuide {
   bool slp_vectorize;
   bool loop_vectorize;
   bool verify_input;
   bool verify_output;
+
+  // Traces whose profiled entry count (see `TraceManager::GetExecutionProfile`)
+  // is below this threshold are considered cold, and are given a cheaper,
+  // size-oriented optimization treatment. Zero disables this.
+  uint64_t cold_entry_count;
+
+  // Traces with more LLVM instructions than this, once their semantics
+  // functions are inlined, are given the same cheaper function pipeline as
+  // cold traces, and are then left alone by the module pipeline. Zero disables
+  // this.
+  uint64_t cheap_trace_ir_insts;
+
+  // Traces with more LLVM instructions than this, once their semantics
+  // functions are inlined, are otherwise left unoptimized. Zero disables this.
+  uint64_t unoptimized_trace_ir_insts;
+
+  // Traces whose optimization takes longer than this many milliseconds aren't
+  // optimized again (e.g. after promoting their stack frames). Traces that
+  // couldn't afford the module pipeline, estimated as one more run of their
+  // function pipeline, are left alone by it. This is checked between passes,
+  // so it isn't a hard limit. Zero disables this.
+  uint64_t trace_time_budget_ms;
+
+  // If set, then memory reads from constant addresses whose bytes this returns
+  // (e.g. via `TraceManager::TryReadConstantMemory`) are folded into constants,
+  // and the traces containing them are optimized again.
+  ConstantMemoryReader read_constant_memory;
+
+  // Promote accesses to each trace's own stack frame into accesses to an
+  // `alloca` (see `PromoteStackFrame`), and optimize the trace again.
+  bool promote_stack_frames;
+
+  // Fuse adjacent memory reads, and adjacent memory writes, into wider ones
+  // (see `CoalesceMemoryAccesses`), and optimize the trace again.
+  bool coalesce_memory_accesses;
+
+  // Once the module is optimized, turn traces that are structurally identical
+  // to an earlier trace into thunks that tail-call that trace (see
+  // `MergeIdenticalTraces`).
+  bool merge_traces;
+
+  // If set, then statistics about the optimized traces, and the time spent in
+  // each pass, are added to this.
+  OptimizationStats *stats;
 };
 
+// Replace the memory read intrinsic calls in `func` whose addresses are
+// constants, and whose bytes `read_constant_memory` returns, with the values
+// that they read. Returns the number of folded reads.
+unsigned
+FoldConstantMemoryReads(llvm::Function *func,
+                        const ConstantMemoryReader &read_constant_memory);
+
+// Replace the memory accesses in the lifted function `func` that are below
+// the stack pointer's value on entry to `func`, i.e. to `func`'s own stack
+// frame, with accesses to an `alloca`, which can then be promoted to SSA
+// values. Returns the number of promoted accesses.
+//
+// Nothing is promoted unless every access is at a constant offset from the
+// entry stack pointer, the stack pointer doesn't escape, and `func` doesn't
+// call anything that could observe its frame. `func` ending with a call to
+// `__remill_function_return` is the only way for it to exit. Every read of the
+// frame also has to be dominated by a write of the same bytes, because `func`
+// may not start at a function entry.
+unsigned PromoteStackFrame(const Arch *arch, llvm::Function *func);
+
+// Fuse pairs of equally sized memory reads of adjacent bytes in `func` into
+// one read that is twice as wide, up to 64 bits, and likewise for memory
+// writes, taking `arch`'s endianness into account. Repeats until no more
+// pairs can be fused. Returns the number of removed memory intrinsic calls.
+//
+// Reads are only fused if they read the same `Memory *`, and are in the same
+// block with no calls that may access memory between them. Writes are only
+// fused if the second directly consumes the `Memory *` of the first.
+unsigned CoalesceMemoryAccesses(const Arch *arch, llvm::Function *func);
+
+// Turn each trace in `traces` that is structurally identical to an earlier
+// trace in `traces` into a thunk that tail-calls the earlier trace, and
+// redirect all uses of it to the earlier trace. Returns the number of traces
+// turned into thunks.
+unsigned MergeIdenticalTraces(const std::vector<llvm::Function *> &traces);
+
 template <typename T>
 inline static void
 OptimizeModule(const std::unique_ptr<const remill::Arch> &arch,
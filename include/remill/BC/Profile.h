@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace remill {
+
+// Execution counts gathered from running the code being lifted, e.g. from
+// hardware traces or sampling profiles. Block counts are keyed by the address
+// of the first instruction of a block, and edge counts by the address of the
+// branching instruction and the address of the branch target.
+class ExecutionProfile {
+ public:
+  // Add `count` executions of the block starting at `addr`.
+  void AddBlockCount(uint64_t addr, uint64_t count);
+
+  // Add `count` traversals of the control-flow edge from the instruction at
+  // `from_addr` to the instruction at `to_addr`.
+  void AddEdgeCount(uint64_t from_addr, uint64_t to_addr, uint64_t count);
+
+  // Returns the number of executions of the block starting at `addr`, or zero
+  // if the block was never executed.
+  uint64_t BlockCount(uint64_t addr) const;
+
+  // Returns the number of traversals of the edge from the instruction at
+  // `from_addr` to the instruction at `to_addr`.
+  uint64_t EdgeCount(uint64_t from_addr, uint64_t to_addr) const;
+
+  inline bool empty(void) const {
+    return block_counts.empty() && edge_counts.empty();
+  }
+
+  // Parse a textual profile, adding its counts to this profile. Each line is
+  // one of:
+  //
+  //    block <addr> <count>
+  //    edge <from_addr> <to_addr> <count>
+  //
+  // Numbers can be decimal, or hexadecimal with a `0x` prefix. Empty lines
+  // and lines starting with `#` are ignored. Returns `false` and sets
+  // `error` if the profile is malformed.
+  bool Parse(std::string_view text, std::string &error);
+
+ private:
+  std::unordered_map<uint64_t, uint64_t> block_counts;
+  std::map<std::pair<uint64_t, uint64_t>, uint64_t> edge_counts;
+};
+
+// Load a textual execution profile from a file.
+std::unique_ptr<ExecutionProfile>
+LoadExecutionProfileFromFile(std::filesystem::path file_name);
+
+// Write the block execution counts gathered by instrumented lifted code (see
+// `DefineBlockCounters`) to `os` as a textual execution profile, with one
+// `block <addr> <count>` line per executed block. The result can be passed
+// back to the lifter as a profile. A runtime would typically call this at
+// exit, with the values of `__remill_block_pcs`, `__remill_block_counts` and
+// `__remill_num_block_counts`.
+void WriteBlockCounts(std::ostream &os, const uint64_t *block_pcs,
+                      const uint64_t *block_counts, uint64_t num_blocks);
+
+}  // namespace remill
@@ -20,9 +20,13 @@
 
 #include <functional>
 #include <unordered_map>
+#include <vector>
 
 namespace remill {
 
+class ExecutionProfile;
+class InstructionIndex;
+
 using TraceMap = std::unordered_map<uint64_t, llvm::Function *>;
 
 enum class DevirtualizedTargetKind { kTraceLocal, kTraceHead };
@@ -66,6 +70,15 @@ class TraceManager {
   //       it is checking if some trace has already been lifted.
   virtual llvm::Function *GetLiftedTraceDefinition(uint64_t addr);
 
+  // Called when the trace starting at `addr` has been invalidated, i.e. some
+  // of the bytes that it was decoded from have changed. If `lifted_func` was
+  // in the trace lifter's module, then its body has been deleted, leaving
+  // behind a declaration so that existing callers remain valid. The derived
+  // class should forget about the definition of this trace; the trace will
+  // be lifted again (into `lifted_func`) the next time it is reached.
+  virtual void ClearLiftedTraceDefinition(uint64_t addr,
+                                          llvm::Function *lifted_func);
+
   // Apply a callback that gives the decoder access to multiple
   // targets of this instruction (indirect call or jump). This enables the
   // lifter to support devirtualization, e.g. handling jump tables as
@@ -75,10 +88,43 @@ class TraceManager {
       const Instruction &inst,
       std::function<void(uint64_t, DevirtualizedTargetKind)> func);
 
+  // Returns the maximum number of instructions that the function at `addr`
+  // can have for it to be inlined into the traces of its direct callers.
+  // Returning zero, which is the default, disables inlining, and direct calls
+  // to `addr` are lifted as calls to the lifted trace for `addr`.
+  //
+  // NOTE: Only functions made of straight-line code, local branches, and
+  //       returns are inlined. Calls to anything else, as well as recursive
+  //       calls, are always lifted as calls.
+  virtual unsigned MaxInlinedCallInstructions(uint64_t addr);
+
+  // Returns an execution profile of the code being lifted, or `nullptr`, which
+  // is the default, if there is none. When a profile is available, the
+  // hottest traces are lifted first, lifted traces are given their profiled
+  // entry counts, and lifted conditional branches are given branch weights.
+  virtual const ExecutionProfile *GetExecutionProfile(void);
+
+  // Returns a pre-decoded index of the executable code, or `nullptr`, which
+  // is the default, if there is none. Instruction bytes within the indexed
+  // range are read from the index, rather than one byte at a time through
+  // `TryReadExecutableByte`.
+  virtual const InstructionIndex *GetInstructionIndex(void);
+
   // Try to read an executable byte of memory. Returns `true` of the byte
   // at address `addr` is executable and readable, and updates the byte
   // pointed to by `byte` with the read value.
   virtual bool TryReadExecutableByte(uint64_t addr, uint8_t *byte) = 0;
+
+  // Try to read `size` bytes of read-only memory, e.g. from a constant table,
+  // a vtable, or a literal pool. Returns `true` if all bytes in the range
+  // `[addr, addr + size)` are known never to change, and updates the bytes
+  // pointed to by `bytes` with the read values. Returning `false`, which is
+  // the default, means that reads of those bytes won't be folded.
+  //
+  // NOTE: This is used by passing it as the `read_constant_memory` callback
+  //       of the `OptimizationGuide`.
+  virtual bool TryReadConstantMemory(uint64_t addr, uint64_t size,
+                                     uint8_t *bytes);
 };
 
 // Implements a recursive decoder that lifts a trace of instructions to bitcode.
@@ -94,11 +140,35 @@ class TraceLifter {
   static void NullCallback(uint64_t, llvm::Function *);
 
   // Lift one or more traces starting from `addr`. Calls `callback` with each
-  // lifted trace.
+  // lifted trace, once the manager has been given its definition.
   bool
   Lift(uint64_t addr,
        std::function<void(uint64_t, llvm::Function *)> callback = NullCallback);
 
+  // Invalidate every trace lifted by this trace lifter whose instructions
+  // were decoded from any of the bytes in the range `[addr, addr + size)`.
+  // Returns the addresses of the invalidated traces. Passing any of these
+  // addresses to `Lift` will re-lift the corresponding trace. An empty range
+  // invalidates nothing. From then on, the bytes in the range are always read
+  // through `TryReadExecutableByte`, even if they're covered by the index.
+  std::vector<uint64_t> Invalidate(uint64_t addr, uint64_t size);
+
+  // Returns the number of instructions that were decoded and lifted into the
+  // trace starting at `addr`, including inlined and delayed instructions, or
+  // zero if this trace lifter hasn't lifted that trace.
+  uint64_t NumDecodedInstructions(uint64_t addr) const;
+
+  // Count the executions of each lifted guest block. The first lifted block
+  // of every guest basic block, i.e. of every trace head and branch target,
+  // increments an element of the external `__remill_block_counts` array.
+  // Each guest block has one counter ID, which indexes into that array, no
+  // matter how many traces it has been lifted into. See `DefineBlockCounters`.
+  void SetCountBlockExecutions(bool enable);
+
+  // Returns the address of each counted guest block, indexed by its counter
+  // ID.
+  const std::vector<uint64_t> &CountedBlockAddresses(void) const;
+
  private:
   TraceLifter(void) = delete;
 
@@ -107,4 +177,17 @@ class TraceLifter {
   std::unique_ptr<Impl> impl;
 };
 
+// Define the block execution counters that traces lifted with
+// `TraceLifter::SetCountBlockExecutions` increment, given the addresses of
+// the counted blocks returned by `TraceLifter::CountedBlockAddresses`. This
+// defines three external variables in `module`:
+//
+//    uint64_t __remill_block_counts[N];       // Zero-initialized.
+//    const uint64_t __remill_block_pcs[N];    // Guest block addresses.
+//    const uint64_t __remill_num_block_counts = N;
+//
+// A runtime can dump them with `WriteBlockCounts`.
+void DefineBlockCounters(llvm::Module *module,
+                         const std::vector<uint64_t> &block_pcs);
+
 }  // namespace remill
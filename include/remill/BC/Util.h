@@ -237,6 +237,21 @@ unsigned ReplaceAllUsesOfConstant(llvm::Constant *old_c, llvm::Constant *new_c,
 // Move a function from one module into another module.
 void MoveFunctionIntoModule(llvm::Function *func, llvm::Module *dest_module);
 
+// Create an empty module named `name` to lift into, which declares the
+// intrinsics of the semantics module `semantics`, but holds none of its
+// semantics functions. `semantics` isn't modified, so it can be shared by
+// many such thin modules, and lifting into a thin module doesn't grow it.
+std::unique_ptr<llvm::Module> CreateThinModule(const Arch *arch,
+                                               llvm::Module *semantics,
+                                               std::string_view name);
+
+// Link into `module` the definitions of the semantics functions that it
+// declares, along with everything that they use, from `semantics`. The linked
+// definitions are internal to `module`, so that they can be deleted once
+// they have been inlined. `semantics` isn't modified. Returns the number of
+// semantics functions that were linked in.
+unsigned LinkSemantics(llvm::Module *module, llvm::Module *semantics);
+
 // Get an instance of `type` that belongs to `context`.
 llvm::Type *RecontextualizeType(llvm::Type *type, llvm::LLVMContext &context);
 
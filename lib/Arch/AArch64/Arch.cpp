@@ -123,6 +123,12 @@ class AArch64Arch final : public Arch {
   bool DecodeInstruction(uint64_t address, std::string_view instr_bytes,
                          Instruction &inst) const final;
 
+  // Decode only the length, category, and direct branch targets of an
+  // instruction.
+  bool DecodeControlFlow(uint64_t address, std::string_view instr_bytes,
+                         ControlFlowInfo &info) const final;
+  bool DecodesControlFlowWithoutSemantics(void) const final;
+
   // Align/Minimum/Maximum number of bytes in an instruction.
   uint64_t MinInstructionAlign(void) const final;
   uint64_t MinInstructionSize(void) const final;
@@ -1281,6 +1287,69 @@ bool AArch64Arch::DecodeInstruction(uint64_t address,
   return true;
 }
 
+// Decode only the length, category, and direct branch targets of an
+// instruction. Only the bit fields are extracted; operands aren't decoded.
+bool AArch64Arch::DecodeControlFlow(uint64_t address,
+                                    std::string_view inst_bytes,
+                                    ControlFlowInfo &info) const {
+  info = {};
+
+  aarch64::InstData dinst = {};
+  auto bytes = reinterpret_cast<const uint8_t *>(inst_bytes.data());
+  if (kInstructionSize != inst_bytes.size() ||
+      0 != (address % kInstructionSize) || !aarch64::TryExtract(bytes, dinst)) {
+    return false;
+  }
+
+  const auto pc = static_cast<int64_t>(address);
+  const auto next_pc = address + kInstructionSize;
+  info.size = kInstructionSize;
+  info.category = InstCategory(dinst);
+
+  switch (dinst.iform) {
+    case aarch64::InstForm::B_ONLY_BRANCH_IMM:
+      info.branch_taken_pc =
+          static_cast<uint64_t>(pc + (dinst.imm26.simm26 << 2LL));
+      break;
+
+    case aarch64::InstForm::BL_ONLY_BRANCH_IMM:
+      info.branch_taken_pc =
+          static_cast<uint64_t>(pc + (dinst.imm26.simm26 << 2LL));
+      info.branch_not_taken_pc = next_pc;
+      break;
+
+    case aarch64::InstForm::BLR_64_BRANCH_REG:
+      info.branch_not_taken_pc = next_pc;
+      break;
+
+    case aarch64::InstForm::B_ONLY_CONDBRANCH:
+    case aarch64::InstForm::CBZ_32_COMPBRANCH:
+    case aarch64::InstForm::CBZ_64_COMPBRANCH:
+    case aarch64::InstForm::CBNZ_32_COMPBRANCH:
+    case aarch64::InstForm::CBNZ_64_COMPBRANCH:
+      info.branch_taken_pc =
+          static_cast<uint64_t>(pc + (dinst.imm19.simm19 << 2LL));
+      info.branch_not_taken_pc = next_pc;
+      break;
+
+    case aarch64::InstForm::TBZ_ONLY_TESTBRANCH:
+    case aarch64::InstForm::TBNZ_ONLY_TESTBRANCH:
+      info.branch_taken_pc =
+          static_cast<uint64_t>(pc + (dinst.imm14.simm14 << 2LL));
+      info.branch_not_taken_pc = next_pc;
+      break;
+
+    default: break;
+  }
+
+  return true;
+}
+
+// Decoding control flow only extracts bit fields.
+bool AArch64Arch::DecodesControlFlowWithoutSemantics(void) const {
+  return true;
+}
+
 }  // namespace
 
 namespace aarch64 {
@@ -4890,6 +4959,268 @@ bool TryDecodeSTLXR_SR64_LDSTEXCL(const InstData &data, Instruction &inst) {
   return true;
 }
 
+// <OPCODE>  <Ws>, <Wt>, [<Xn|SP>]
+//
+// Armv8.1 atomic memory operations. These are implemented with the atomic
+// memory intrinsics, so they don't need to be surrounded by atomic begin/end.
+static bool TryDecodeRs_RtW_MemOp(const InstData &data, Instruction &inst,
+                                  RegClass rclass, uint64_t access_size) {
+  AddRegOperand(inst, kActionRead, rclass, kUseAsValue, data.Rs);
+  AddRegOperand(inst, kActionWrite, rclass, kUseAsValue, data.Rt);
+  AddBasePlusOffsetMemOp(inst, kActionWrite, access_size, data.Rn, 0);
+  return true;
+}
+
+// <OPCODE>  <Ws>, <Wt>, [<Xn|SP>{,#0}]
+static bool TryDecodeRsW_Rs_Rt_CAS(const InstData &data, Instruction &inst,
+                                   RegClass rclass, uint64_t access_size) {
+  AddRegOperand(inst, kActionWrite, rclass, kUseAsValue, data.Rs);
+  AddRegOperand(inst, kActionRead, rclass, kUseAsValue, data.Rs);
+  AddRegOperand(inst, kActionRead, rclass, kUseAsValue, data.Rt);
+  AddBasePlusOffsetMemOp(inst, kActionWrite, access_size, data.Rn, 0);
+  return true;
+}
+
+// LDADD  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDADD_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 32);
+}
+
+// LDADDA  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDADDA_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 32);
+}
+
+// LDADDAL  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDADDAL_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 32);
+}
+
+// LDADDL  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDADDL_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 32);
+}
+
+// LDADD  <Xs>, <Xt>, [<Xn|SP>]
+bool TryDecodeLDADD_64_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegX, 64);
+}
+
+// LDADDA  <Xs>, <Xt>, [<Xn|SP>]
+bool TryDecodeLDADDA_64_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegX, 64);
+}
+
+// LDADDAL  <Xs>, <Xt>, [<Xn|SP>]
+bool TryDecodeLDADDAL_64_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegX, 64);
+}
+
+// LDADDL  <Xs>, <Xt>, [<Xn|SP>]
+bool TryDecodeLDADDL_64_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegX, 64);
+}
+
+// LDADDB  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDADDB_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 8);
+}
+
+// LDADDAB  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDADDAB_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 8);
+}
+
+// LDADDALB  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDADDALB_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 8);
+}
+
+// LDADDLB  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDADDLB_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 8);
+}
+
+// LDADDH  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDADDH_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 16);
+}
+
+// LDADDAH  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDADDAH_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 16);
+}
+
+// LDADDALH  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDADDALH_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 16);
+}
+
+// LDADDLH  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDADDLH_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 16);
+}
+
+// SWP  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeSWP_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 32);
+}
+
+// SWPA  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeSWPA_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 32);
+}
+
+// SWPAL  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeSWPAL_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 32);
+}
+
+// SWPL  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeSWPL_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 32);
+}
+
+// SWP  <Xs>, <Xt>, [<Xn|SP>]
+bool TryDecodeSWP_64_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegX, 64);
+}
+
+// SWPA  <Xs>, <Xt>, [<Xn|SP>]
+bool TryDecodeSWPA_64_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegX, 64);
+}
+
+// SWPAL  <Xs>, <Xt>, [<Xn|SP>]
+bool TryDecodeSWPAL_64_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegX, 64);
+}
+
+// SWPL  <Xs>, <Xt>, [<Xn|SP>]
+bool TryDecodeSWPL_64_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegX, 64);
+}
+
+// SWPB  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeSWPB_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 8);
+}
+
+// SWPAB  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeSWPAB_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 8);
+}
+
+// SWPALB  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeSWPALB_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 8);
+}
+
+// SWPLB  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeSWPLB_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 8);
+}
+
+// SWPH  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeSWPH_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 16);
+}
+
+// SWPAH  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeSWPAH_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 16);
+}
+
+// SWPALH  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeSWPALH_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 16);
+}
+
+// SWPLH  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeSWPLH_32_MEMOP(const InstData &data, Instruction &inst) {
+  return TryDecodeRs_RtW_MemOp(data, inst, kRegW, 16);
+}
+
+// CAS  <Ws>, <Wt>, [<Xn|SP>{,#0}]
+bool TryDecodeCAS_C32_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegW, 32);
+}
+
+// CASA  <Ws>, <Wt>, [<Xn|SP>{,#0}]
+bool TryDecodeCASA_C32_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegW, 32);
+}
+
+// CASAL  <Ws>, <Wt>, [<Xn|SP>{,#0}]
+bool TryDecodeCASAL_C32_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegW, 32);
+}
+
+// CASL  <Ws>, <Wt>, [<Xn|SP>{,#0}]
+bool TryDecodeCASL_C32_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegW, 32);
+}
+
+// CAS  <Xs>, <Xt>, [<Xn|SP>{,#0}]
+bool TryDecodeCAS_C64_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegX, 64);
+}
+
+// CASA  <Xs>, <Xt>, [<Xn|SP>{,#0}]
+bool TryDecodeCASA_C64_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegX, 64);
+}
+
+// CASAL  <Xs>, <Xt>, [<Xn|SP>{,#0}]
+bool TryDecodeCASAL_C64_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegX, 64);
+}
+
+// CASL  <Xs>, <Xt>, [<Xn|SP>{,#0}]
+bool TryDecodeCASL_C64_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegX, 64);
+}
+
+// CASB  <Ws>, <Wt>, [<Xn|SP>{,#0}]
+bool TryDecodeCASB_C32_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegW, 8);
+}
+
+// CASAB  <Ws>, <Wt>, [<Xn|SP>{,#0}]
+bool TryDecodeCASAB_C32_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegW, 8);
+}
+
+// CASALB  <Ws>, <Wt>, [<Xn|SP>{,#0}]
+bool TryDecodeCASALB_C32_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegW, 8);
+}
+
+// CASLB  <Ws>, <Wt>, [<Xn|SP>{,#0}]
+bool TryDecodeCASLB_C32_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegW, 8);
+}
+
+// CASH  <Ws>, <Wt>, [<Xn|SP>{,#0}]
+bool TryDecodeCASH_C32_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegW, 16);
+}
+
+// CASAH  <Ws>, <Wt>, [<Xn|SP>{,#0}]
+bool TryDecodeCASAH_C32_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegW, 16);
+}
+
+// CASALH  <Ws>, <Wt>, [<Xn|SP>{,#0}]
+bool TryDecodeCASALH_C32_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegW, 16);
+}
+
+// CASLH  <Ws>, <Wt>, [<Xn|SP>{,#0}]
+bool TryDecodeCASLH_C32_LDSTEXCL(const InstData &data, Instruction &inst) {
+  return TryDecodeRsW_Rs_Rt_CAS(data, inst, kRegW, 16);
+}
+
 static uint64_t ConcatABCDEFGHToU8(const InstData &data) {
   uint64_t imm = data.a;
   imm = (imm << 1) | data.b;
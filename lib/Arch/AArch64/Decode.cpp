@@ -5430,310 +5430,6 @@ bool TryDecodeSUB_ASISDSAME_ONLY(const InstData &, Instruction &) {
   return false;
 }
 
-// SWPA SWPA_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 1 size     1
-// SWPA  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeSWPA_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// SWPAL SWPAL_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 1 size     1
-// SWPAL  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeSWPAL_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// SWP SWP_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 0 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 1 size     1
-// SWP  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeSWP_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// SWPL SWPL_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 0 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 1 size     1
-// SWPL  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeSWPL_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// SWPA SWPA_64_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 1 size     1
-// SWPA  <Xs>, <Xt>, [<Xn|SP>]
-bool TryDecodeSWPA_64_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// SWPAL SWPAL_64_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 1 size     1
-// SWPAL  <Xs>, <Xt>, [<Xn|SP>]
-bool TryDecodeSWPAL_64_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// SWP SWP_64_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 0 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 1 size     1
-// SWP  <Xs>, <Xt>, [<Xn|SP>]
-bool TryDecodeSWP_64_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// SWPL SWPL_64_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 0 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 1 size     1
-// SWPL  <Xs>, <Xt>, [<Xn|SP>]
-bool TryDecodeSWPL_64_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
 // SMC SMC_EX_exception:
 //   0 1 LL       0
 //   1 1 LL       1
@@ -9421,158 +9117,6 @@ bool TryDecodeLDSETLH_32_MEMOP(const InstData &, Instruction &) {
   return false;
 }
 
-// LDADDAH LDADDAH_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 0 size     1
-// LDADDAH  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDADDAH_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// LDADDALH LDADDALH_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 0 size     1
-// LDADDALH  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDADDALH_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// LDADDH LDADDH_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 0 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 0 size     1
-// LDADDH  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDADDH_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// LDADDLH LDADDLH_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 0 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 0 size     1
-// LDADDLH  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDADDLH_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
 // LD3 LD3_asisdlsep_I3_i:
 //   0 x Rt       0
 //   1 x Rt       1
@@ -11582,88 +11126,12 @@ bool TryDecodeST3_ASISDLSOP_H3_I3H(const InstData &, Instruction &) {
 //  29 0
 //  30 x Q        0
 //  31 0
-// ST3  { <Vt>.H, <Vt2>.H, <Vt3>.H }[<index>], [<Xn|SP>], <Xm>
-bool TryDecodeST3_ASISDLSOP_HX3_R3H(const InstData &, Instruction &) {
-  return false;
-}
-
-// ST3 ST3_asisdlsop_S3_i3s:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0 size     0
-//  11 0 size     1
-//  12 x S        0
-//  13 1 opcode   0
-//  14 0 opcode   1
-//  15 1 opcode   2
-//  16 1 Rm       0
-//  17 1 Rm       1
-//  18 1 Rm       2
-//  19 1 Rm       3
-//  20 1 Rm       4
-//  21 0 R        0
-//  22 0 L        0
-//  23 1
-//  24 1
-//  25 0
-//  26 1
-//  27 1
-//  28 0
-//  29 0
-//  30 x Q        0
-//  31 0
-// ST3  { <Vt>.S, <Vt2>.S, <Vt3>.S }[<index>], [<Xn|SP>], #12
-bool TryDecodeST3_ASISDLSOP_S3_I3S(const InstData &, Instruction &) {
-  return false;
-}
-
-// ST3 ST3_asisdlsop_SX3_r3s:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0 size     0
-//  11 0 size     1
-//  12 x S        0
-//  13 1 opcode   0
-//  14 0 opcode   1
-//  15 1 opcode   2
-//  16 x Rm       0
-//  17 x Rm       1
-//  18 x Rm       2
-//  19 x Rm       3
-//  20 x Rm       4
-//  21 0 R        0
-//  22 0 L        0
-//  23 1
-//  24 1
-//  25 0
-//  26 1
-//  27 1
-//  28 0
-//  29 0
-//  30 x Q        0
-//  31 0
-// ST3  { <Vt>.S, <Vt2>.S, <Vt3>.S }[<index>], [<Xn|SP>], <Xm>
-bool TryDecodeST3_ASISDLSOP_SX3_R3S(const InstData &, Instruction &) {
+// ST3  { <Vt>.H, <Vt2>.H, <Vt3>.H }[<index>], [<Xn|SP>], <Xm>
+bool TryDecodeST3_ASISDLSOP_HX3_R3H(const InstData &, Instruction &) {
   return false;
 }
 
-// ST3 ST3_asisdlsop_D3_i3d:
+// ST3 ST3_asisdlsop_S3_i3s:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -11674,9 +11142,9 @@ bool TryDecodeST3_ASISDLSOP_SX3_R3S(const InstData &, Instruction &) {
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 1 size     0
+//  10 0 size     0
 //  11 0 size     1
-//  12 0 S        0
+//  12 x S        0
 //  13 1 opcode   0
 //  14 0 opcode   1
 //  15 1 opcode   2
@@ -11696,12 +11164,12 @@ bool TryDecodeST3_ASISDLSOP_SX3_R3S(const InstData &, Instruction &) {
 //  29 0
 //  30 x Q        0
 //  31 0
-// ST3  { <Vt>.D, <Vt2>.D, <Vt3>.D }[<index>], [<Xn|SP>], #24
-bool TryDecodeST3_ASISDLSOP_D3_I3D(const InstData &, Instruction &) {
+// ST3  { <Vt>.S, <Vt2>.S, <Vt3>.S }[<index>], [<Xn|SP>], #12
+bool TryDecodeST3_ASISDLSOP_S3_I3S(const InstData &, Instruction &) {
   return false;
 }
 
-// ST3 ST3_asisdlsop_DX3_r3d:
+// ST3 ST3_asisdlsop_SX3_r3s:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -11712,9 +11180,9 @@ bool TryDecodeST3_ASISDLSOP_D3_I3D(const InstData &, Instruction &) {
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 1 size     0
+//  10 0 size     0
 //  11 0 size     1
-//  12 0 S        0
+//  12 x S        0
 //  13 1 opcode   0
 //  14 0 opcode   1
 //  15 1 opcode   2
@@ -11734,241 +11202,12 @@ bool TryDecodeST3_ASISDLSOP_D3_I3D(const InstData &, Instruction &) {
 //  29 0
 //  30 x Q        0
 //  31 0
-// ST3  { <Vt>.D, <Vt2>.D, <Vt3>.D }[<index>], [<Xn|SP>], <Xm>
-bool TryDecodeST3_ASISDLSOP_DX3_R3D(const InstData &, Instruction &) {
-  return false;
-}
-
-
-// LDADDA LDADDA_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 1 size     1
-// LDADDA  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDADDA_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// LDADDAL LDADDAL_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 1 size     1
-// LDADDAL  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDADDAL_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// LDADD LDADD_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 0 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 1 size     1
-// LDADD  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDADD_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// LDADDL LDADDL_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 0 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 1 size     1
-// LDADDL  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDADDL_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// LDADDA LDADDA_64_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 1 size     1
-// LDADDA  <Xs>, <Xt>, [<Xn|SP>]
-bool TryDecodeLDADDA_64_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// LDADDAL LDADDAL_64_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 1 size     1
-// LDADDAL  <Xs>, <Xt>, [<Xn|SP>]
-bool TryDecodeLDADDAL_64_MEMOP(const InstData &, Instruction &) {
+// ST3  { <Vt>.S, <Vt2>.S, <Vt3>.S }[<index>], [<Xn|SP>], <Xm>
+bool TryDecodeST3_ASISDLSOP_SX3_R3S(const InstData &, Instruction &) {
   return false;
 }
 
-// LDADD LDADD_64_memop:
+// ST3 ST3_asisdlsop_D3_i3d:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -11979,34 +11218,34 @@ bool TryDecodeLDADDAL_64_MEMOP(const InstData &, Instruction &) {
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 0 A        0
-//  24 0
+//  10 1 size     0
+//  11 0 size     1
+//  12 0 S        0
+//  13 1 opcode   0
+//  14 0 opcode   1
+//  15 1 opcode   2
+//  16 1 Rm       0
+//  17 1 Rm       1
+//  18 1 Rm       2
+//  19 1 Rm       3
+//  20 1 Rm       4
+//  21 0 R        0
+//  22 0 L        0
+//  23 1
+//  24 1
 //  25 0
-//  26 0 V        0
+//  26 1
 //  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 1 size     1
-// LDADD  <Xs>, <Xt>, [<Xn|SP>]
-bool TryDecodeLDADD_64_MEMOP(const InstData &, Instruction &) {
+//  28 0
+//  29 0
+//  30 x Q        0
+//  31 0
+// ST3  { <Vt>.D, <Vt2>.D, <Vt3>.D }[<index>], [<Xn|SP>], #24
+bool TryDecodeST3_ASISDLSOP_D3_I3D(const InstData &, Instruction &) {
   return false;
 }
 
-// LDADDL LDADDL_64_memop:
+// ST3 ST3_asisdlsop_DX3_r3d:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -12017,33 +11256,34 @@ bool TryDecodeLDADD_64_MEMOP(const InstData &, Instruction &) {
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 0 A        0
-//  24 0
+//  10 1 size     0
+//  11 0 size     1
+//  12 0 S        0
+//  13 1 opcode   0
+//  14 0 opcode   1
+//  15 1 opcode   2
+//  16 x Rm       0
+//  17 x Rm       1
+//  18 x Rm       2
+//  19 x Rm       3
+//  20 x Rm       4
+//  21 0 R        0
+//  22 0 L        0
+//  23 1
+//  24 1
 //  25 0
-//  26 0 V        0
+//  26 1
 //  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 1 size     1
-// LDADDL  <Xs>, <Xt>, [<Xn|SP>]
-bool TryDecodeLDADDL_64_MEMOP(const InstData &, Instruction &) {
+//  28 0
+//  29 0
+//  30 x Q        0
+//  31 0
+// ST3  { <Vt>.D, <Vt2>.D, <Vt3>.D }[<index>], [<Xn|SP>], <Xm>
+bool TryDecodeST3_ASISDLSOP_DX3_R3D(const InstData &, Instruction &) {
   return false;
 }
 
+
 // FCVTZS FCVTZS_asisdshf_C:
 //   0 x Rd       0
 //   1 x Rd       1
@@ -12804,197 +12044,7 @@ bool TryDecodeSTR_H_LDST_IMMPOST(const InstData &, Instruction &) {
   return false;
 }
 
-// STR STR_S_ldst_immpost:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1
-//  11 0
-//  12 x imm9     0
-//  13 x imm9     1
-//  14 x imm9     2
-//  15 x imm9     3
-//  16 x imm9     4
-//  17 x imm9     5
-//  18 x imm9     6
-//  19 x imm9     7
-//  20 x imm9     8
-//  21 0
-//  22 0 opc      0
-//  23 0 opc      1
-//  24 0
-//  25 0
-//  26 1 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 1 size     1
-// STR  <St>, [<Xn|SP>], #<simm>
-bool TryDecodeSTR_S_LDST_IMMPOST(const InstData &, Instruction &) {
-  return false;
-}
-
-// STR STR_D_ldst_immpost:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1
-//  11 0
-//  12 x imm9     0
-//  13 x imm9     1
-//  14 x imm9     2
-//  15 x imm9     3
-//  16 x imm9     4
-//  17 x imm9     5
-//  18 x imm9     6
-//  19 x imm9     7
-//  20 x imm9     8
-//  21 0
-//  22 0 opc      0
-//  23 0 opc      1
-//  24 0
-//  25 0
-//  26 1 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 1 size     1
-// STR  <Dt>, [<Xn|SP>], #<simm>
-bool TryDecodeSTR_D_LDST_IMMPOST(const InstData &, Instruction &) {
-  return false;
-}
-
-// STR STR_Q_ldst_immpost:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1
-//  11 0
-//  12 x imm9     0
-//  13 x imm9     1
-//  14 x imm9     2
-//  15 x imm9     3
-//  16 x imm9     4
-//  17 x imm9     5
-//  18 x imm9     6
-//  19 x imm9     7
-//  20 x imm9     8
-//  21 0
-//  22 0 opc      0
-//  23 1 opc      1
-//  24 0
-//  25 0
-//  26 1 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 0 size     1
-// STR  <Qt>, [<Xn|SP>], #<simm>
-bool TryDecodeSTR_Q_LDST_IMMPOST(const InstData &, Instruction &) {
-  return false;
-}
-
-// STR STR_B_ldst_immpre:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1
-//  11 1
-//  12 x imm9     0
-//  13 x imm9     1
-//  14 x imm9     2
-//  15 x imm9     3
-//  16 x imm9     4
-//  17 x imm9     5
-//  18 x imm9     6
-//  19 x imm9     7
-//  20 x imm9     8
-//  21 0
-//  22 0 opc      0
-//  23 0 opc      1
-//  24 0
-//  25 0
-//  26 1 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 0 size     1
-// STR  <Bt>, [<Xn|SP>, #<simm>]!
-bool TryDecodeSTR_B_LDST_IMMPRE(const InstData &, Instruction &) {
-  return false;
-}
-
-// STR STR_H_ldst_immpre:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1
-//  11 1
-//  12 x imm9     0
-//  13 x imm9     1
-//  14 x imm9     2
-//  15 x imm9     3
-//  16 x imm9     4
-//  17 x imm9     5
-//  18 x imm9     6
-//  19 x imm9     7
-//  20 x imm9     8
-//  21 0
-//  22 0 opc      0
-//  23 0 opc      1
-//  24 0
-//  25 0
-//  26 1 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 0 size     1
-// STR  <Ht>, [<Xn|SP>, #<simm>]!
-bool TryDecodeSTR_H_LDST_IMMPRE(const InstData &, Instruction &) {
-  return false;
-}
-
-// STR STR_S_ldst_immpre:
+// STR STR_S_ldst_immpost:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -13006,7 +12056,7 @@ bool TryDecodeSTR_H_LDST_IMMPRE(const InstData &, Instruction &) {
 //   8 x Rn       3
 //   9 x Rn       4
 //  10 1
-//  11 1
+//  11 0
 //  12 x imm9     0
 //  13 x imm9     1
 //  14 x imm9     2
@@ -13027,12 +12077,12 @@ bool TryDecodeSTR_H_LDST_IMMPRE(const InstData &, Instruction &) {
 //  29 1
 //  30 0 size     0
 //  31 1 size     1
-// STR  <St>, [<Xn|SP>, #<simm>]!
-bool TryDecodeSTR_S_LDST_IMMPRE(const InstData &, Instruction &) {
+// STR  <St>, [<Xn|SP>], #<simm>
+bool TryDecodeSTR_S_LDST_IMMPOST(const InstData &, Instruction &) {
   return false;
 }
 
-// STR STR_D_ldst_immpre:
+// STR STR_D_ldst_immpost:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -13044,7 +12094,7 @@ bool TryDecodeSTR_S_LDST_IMMPRE(const InstData &, Instruction &) {
 //   8 x Rn       3
 //   9 x Rn       4
 //  10 1
-//  11 1
+//  11 0
 //  12 x imm9     0
 //  13 x imm9     1
 //  14 x imm9     2
@@ -13065,50 +12115,12 @@ bool TryDecodeSTR_S_LDST_IMMPRE(const InstData &, Instruction &) {
 //  29 1
 //  30 1 size     0
 //  31 1 size     1
-// STR  <Dt>, [<Xn|SP>, #<simm>]!
-bool TryDecodeSTR_D_LDST_IMMPRE(const InstData &, Instruction &) {
-  return false;
-}
-
-// LDSETAB LDSETAB_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 1 opc      0
-//  13 1 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 0 size     1
-// LDSETAB  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDSETAB_32_MEMOP(const InstData &, Instruction &) {
+// STR  <Dt>, [<Xn|SP>], #<simm>
+bool TryDecodeSTR_D_LDST_IMMPOST(const InstData &, Instruction &) {
   return false;
 }
 
-// LDSETALB LDSETALB_32_memop:
+// STR STR_Q_ldst_immpost:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -13119,34 +12131,34 @@ bool TryDecodeLDSETAB_32_MEMOP(const InstData &, Instruction &) {
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 0
+//  10 1
 //  11 0
-//  12 1 opc      0
-//  13 1 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 1 A        0
+//  12 x imm9     0
+//  13 x imm9     1
+//  14 x imm9     2
+//  15 x imm9     3
+//  16 x imm9     4
+//  17 x imm9     5
+//  18 x imm9     6
+//  19 x imm9     7
+//  20 x imm9     8
+//  21 0
+//  22 0 opc      0
+//  23 1 opc      1
 //  24 0
 //  25 0
-//  26 0 V        0
+//  26 1 V        0
 //  27 1
 //  28 1
 //  29 1
 //  30 0 size     0
 //  31 0 size     1
-// LDSETALB  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDSETALB_32_MEMOP(const InstData &, Instruction &) {
+// STR  <Qt>, [<Xn|SP>], #<simm>
+bool TryDecodeSTR_Q_LDST_IMMPOST(const InstData &, Instruction &) {
   return false;
 }
 
-// LDSETB LDSETB_32_memop:
+// STR STR_B_ldst_immpre:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -13157,34 +12169,34 @@ bool TryDecodeLDSETALB_32_MEMOP(const InstData &, Instruction &) {
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 0
-//  11 0
-//  12 1 opc      0
-//  13 1 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 0 A        0
+//  10 1
+//  11 1
+//  12 x imm9     0
+//  13 x imm9     1
+//  14 x imm9     2
+//  15 x imm9     3
+//  16 x imm9     4
+//  17 x imm9     5
+//  18 x imm9     6
+//  19 x imm9     7
+//  20 x imm9     8
+//  21 0
+//  22 0 opc      0
+//  23 0 opc      1
 //  24 0
 //  25 0
-//  26 0 V        0
+//  26 1 V        0
 //  27 1
 //  28 1
 //  29 1
 //  30 0 size     0
 //  31 0 size     1
-// LDSETB  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDSETB_32_MEMOP(const InstData &, Instruction &) {
+// STR  <Bt>, [<Xn|SP>, #<simm>]!
+bool TryDecodeSTR_B_LDST_IMMPRE(const InstData &, Instruction &) {
   return false;
 }
 
-// LDSETLB LDSETLB_32_memop:
+// STR STR_H_ldst_immpre:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -13195,148 +12207,34 @@ bool TryDecodeLDSETB_32_MEMOP(const InstData &, Instruction &) {
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 0
-//  11 0
-//  12 1 opc      0
-//  13 1 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 0 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 0 size     1
-// LDSETLB  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDSETLB_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// FRINTP FRINTP_H_floatdp1:
-//   0 x Rd       0
-//   1 x Rd       1
-//   2 x Rd       2
-//   3 x Rd       3
-//   4 x Rd       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0
-//  13 0
-//  14 1
-//  15 1 rmode    0
-//  16 0 rmode    1
-//  17 0 rmode    2
-//  18 1
-//  19 0
-//  20 0
-//  21 1
-//  22 1 type     0
-//  23 1 type     1
-//  24 0
-//  25 1
-//  26 1
-//  27 1
-//  28 1
-//  29 0 S        0
-//  30 0
-//  31 0 M        0
-// FRINTP  <Hd>, <Hn>
-bool TryDecodeFRINTP_H_FLOATDP1(const InstData &, Instruction &) {
-  return false;
-}
-
-// FRINTP FRINTP_S_floatdp1:
-//   0 x Rd       0
-//   1 x Rd       1
-//   2 x Rd       2
-//   3 x Rd       3
-//   4 x Rd       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0
-//  13 0
-//  14 1
-//  15 1 rmode    0
-//  16 0 rmode    1
-//  17 0 rmode    2
-//  18 1
-//  19 0
-//  20 0
-//  21 1
-//  22 0 type     0
-//  23 0 type     1
-//  24 0
-//  25 1
-//  26 1
-//  27 1
-//  28 1
-//  29 0 S        0
-//  30 0
-//  31 0 M        0
-// FRINTP  <Sd>, <Sn>
-bool TryDecodeFRINTP_S_FLOATDP1(const InstData &, Instruction &) {
-  return false;
-}
-
-// FRINTP FRINTP_D_floatdp1:
-//   0 x Rd       0
-//   1 x Rd       1
-//   2 x Rd       2
-//   3 x Rd       3
-//   4 x Rd       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0
-//  13 0
-//  14 1
-//  15 1 rmode    0
-//  16 0 rmode    1
-//  17 0 rmode    2
-//  18 1
-//  19 0
-//  20 0
-//  21 1
-//  22 1 type     0
-//  23 0 type     1
+//  10 1
+//  11 1
+//  12 x imm9     0
+//  13 x imm9     1
+//  14 x imm9     2
+//  15 x imm9     3
+//  16 x imm9     4
+//  17 x imm9     5
+//  18 x imm9     6
+//  19 x imm9     7
+//  20 x imm9     8
+//  21 0
+//  22 0 opc      0
+//  23 0 opc      1
 //  24 0
-//  25 1
-//  26 1
+//  25 0
+//  26 1 V        0
 //  27 1
 //  28 1
-//  29 0 S        0
-//  30 0
-//  31 0 M        0
-// FRINTP  <Dd>, <Dn>
-bool TryDecodeFRINTP_D_FLOATDP1(const InstData &, Instruction &) {
+//  29 1
+//  30 1 size     0
+//  31 0 size     1
+// STR  <Ht>, [<Xn|SP>, #<simm>]!
+bool TryDecodeSTR_H_LDST_IMMPRE(const InstData &, Instruction &) {
   return false;
 }
 
-// CASA CASA_C32_ldstexcl:
+// STR STR_S_ldst_immpre:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -13347,34 +12245,34 @@ bool TryDecodeFRINTP_D_FLOATDP1(const InstData &, Instruction &) {
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 0 o0       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1 o1       0
-//  22 1 L        0
-//  23 1 o2       0
+//  10 1
+//  11 1
+//  12 x imm9     0
+//  13 x imm9     1
+//  14 x imm9     2
+//  15 x imm9     3
+//  16 x imm9     4
+//  17 x imm9     5
+//  18 x imm9     6
+//  19 x imm9     7
+//  20 x imm9     8
+//  21 0
+//  22 0 opc      0
+//  23 0 opc      1
 //  24 0
 //  25 0
-//  26 0
+//  26 1 V        0
 //  27 1
-//  28 0
-//  29 0
+//  28 1
+//  29 1
 //  30 0 size     0
 //  31 1 size     1
-// CASA  <Ws>, <Wt>, [<Xn|SP>{,#0}]
-bool TryDecodeCASA_C32_LDSTEXCL(const InstData &, Instruction &) {
+// STR  <St>, [<Xn|SP>, #<simm>]!
+bool TryDecodeSTR_S_LDST_IMMPRE(const InstData &, Instruction &) {
   return false;
 }
 
-// CASAL CASAL_C32_ldstexcl:
+// STR STR_D_ldst_immpre:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -13385,34 +12283,34 @@ bool TryDecodeCASA_C32_LDSTEXCL(const InstData &, Instruction &) {
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 1 o0       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1 o1       0
-//  22 1 L        0
-//  23 1 o2       0
+//  10 1
+//  11 1
+//  12 x imm9     0
+//  13 x imm9     1
+//  14 x imm9     2
+//  15 x imm9     3
+//  16 x imm9     4
+//  17 x imm9     5
+//  18 x imm9     6
+//  19 x imm9     7
+//  20 x imm9     8
+//  21 0
+//  22 0 opc      0
+//  23 0 opc      1
 //  24 0
 //  25 0
-//  26 0
+//  26 1 V        0
 //  27 1
-//  28 0
-//  29 0
-//  30 0 size     0
+//  28 1
+//  29 1
+//  30 1 size     0
 //  31 1 size     1
-// CASAL  <Ws>, <Wt>, [<Xn|SP>{,#0}]
-bool TryDecodeCASAL_C32_LDSTEXCL(const InstData &, Instruction &) {
+// STR  <Dt>, [<Xn|SP>, #<simm>]!
+bool TryDecodeSTR_D_LDST_IMMPRE(const InstData &, Instruction &) {
   return false;
 }
 
-// CAS CAS_C32_ldstexcl:
+// LDSETAB LDSETAB_32_memop:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -13423,34 +12321,34 @@ bool TryDecodeCASAL_C32_LDSTEXCL(const InstData &, Instruction &) {
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 0 o0       0
+//  10 0
+//  11 0
+//  12 1 opc      0
+//  13 1 opc      1
+//  14 0 opc      2
+//  15 0 o3       0
 //  16 x Rs       0
 //  17 x Rs       1
 //  18 x Rs       2
 //  19 x Rs       3
 //  20 x Rs       4
-//  21 1 o1       0
-//  22 0 L        0
-//  23 1 o2       0
+//  21 1
+//  22 0 R        0
+//  23 1 A        0
 //  24 0
 //  25 0
-//  26 0
+//  26 0 V        0
 //  27 1
-//  28 0
-//  29 0
+//  28 1
+//  29 1
 //  30 0 size     0
-//  31 1 size     1
-// CAS  <Ws>, <Wt>, [<Xn|SP>{,#0}]
-bool TryDecodeCAS_C32_LDSTEXCL(const InstData &, Instruction &) {
+//  31 0 size     1
+// LDSETAB  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDSETAB_32_MEMOP(const InstData &, Instruction &) {
   return false;
 }
 
-// CASL CASL_C32_ldstexcl:
+// LDSETALB LDSETALB_32_memop:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -13461,34 +12359,34 @@ bool TryDecodeCAS_C32_LDSTEXCL(const InstData &, Instruction &) {
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 1 o0       0
+//  10 0
+//  11 0
+//  12 1 opc      0
+//  13 1 opc      1
+//  14 0 opc      2
+//  15 0 o3       0
 //  16 x Rs       0
 //  17 x Rs       1
 //  18 x Rs       2
 //  19 x Rs       3
 //  20 x Rs       4
-//  21 1 o1       0
-//  22 0 L        0
-//  23 1 o2       0
+//  21 1
+//  22 1 R        0
+//  23 1 A        0
 //  24 0
 //  25 0
-//  26 0
+//  26 0 V        0
 //  27 1
-//  28 0
-//  29 0
+//  28 1
+//  29 1
 //  30 0 size     0
-//  31 1 size     1
-// CASL  <Ws>, <Wt>, [<Xn|SP>{,#0}]
-bool TryDecodeCASL_C32_LDSTEXCL(const InstData &, Instruction &) {
+//  31 0 size     1
+// LDSETALB  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDSETALB_32_MEMOP(const InstData &, Instruction &) {
   return false;
 }
 
-// CASA CASA_C64_ldstexcl:
+// LDSETB LDSETB_32_memop:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -13499,34 +12397,34 @@ bool TryDecodeCASL_C32_LDSTEXCL(const InstData &, Instruction &) {
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 0 o0       0
+//  10 0
+//  11 0
+//  12 1 opc      0
+//  13 1 opc      1
+//  14 0 opc      2
+//  15 0 o3       0
 //  16 x Rs       0
 //  17 x Rs       1
 //  18 x Rs       2
 //  19 x Rs       3
 //  20 x Rs       4
-//  21 1 o1       0
-//  22 1 L        0
-//  23 1 o2       0
+//  21 1
+//  22 0 R        0
+//  23 0 A        0
 //  24 0
 //  25 0
-//  26 0
+//  26 0 V        0
 //  27 1
-//  28 0
-//  29 0
-//  30 1 size     0
-//  31 1 size     1
-// CASA  <Xs>, <Xt>, [<Xn|SP>{,#0}]
-bool TryDecodeCASA_C64_LDSTEXCL(const InstData &, Instruction &) {
+//  28 1
+//  29 1
+//  30 0 size     0
+//  31 0 size     1
+// LDSETB  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDSETB_32_MEMOP(const InstData &, Instruction &) {
   return false;
 }
 
-// CASAL CASAL_C64_ldstexcl:
+// LDSETLB LDSETLB_32_memop:
 //   0 x Rt       0
 //   1 x Rt       1
 //   2 x Rt       2
@@ -13537,106 +12435,144 @@ bool TryDecodeCASA_C64_LDSTEXCL(const InstData &, Instruction &) {
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 1 o0       0
+//  10 0
+//  11 0
+//  12 1 opc      0
+//  13 1 opc      1
+//  14 0 opc      2
+//  15 0 o3       0
 //  16 x Rs       0
 //  17 x Rs       1
 //  18 x Rs       2
 //  19 x Rs       3
 //  20 x Rs       4
-//  21 1 o1       0
-//  22 1 L        0
-//  23 1 o2       0
+//  21 1
+//  22 1 R        0
+//  23 0 A        0
 //  24 0
 //  25 0
-//  26 0
+//  26 0 V        0
 //  27 1
-//  28 0
-//  29 0
-//  30 1 size     0
-//  31 1 size     1
-// CASAL  <Xs>, <Xt>, [<Xn|SP>{,#0}]
-bool TryDecodeCASAL_C64_LDSTEXCL(const InstData &, Instruction &) {
+//  28 1
+//  29 1
+//  30 0 size     0
+//  31 0 size     1
+// LDSETLB  <Ws>, <Wt>, [<Xn|SP>]
+bool TryDecodeLDSETLB_32_MEMOP(const InstData &, Instruction &) {
+  return false;
+}
+
+// FRINTP FRINTP_H_floatdp1:
+//   0 x Rd       0
+//   1 x Rd       1
+//   2 x Rd       2
+//   3 x Rd       3
+//   4 x Rd       4
+//   5 x Rn       0
+//   6 x Rn       1
+//   7 x Rn       2
+//   8 x Rn       3
+//   9 x Rn       4
+//  10 0
+//  11 0
+//  12 0
+//  13 0
+//  14 1
+//  15 1 rmode    0
+//  16 0 rmode    1
+//  17 0 rmode    2
+//  18 1
+//  19 0
+//  20 0
+//  21 1
+//  22 1 type     0
+//  23 1 type     1
+//  24 0
+//  25 1
+//  26 1
+//  27 1
+//  28 1
+//  29 0 S        0
+//  30 0
+//  31 0 M        0
+// FRINTP  <Hd>, <Hn>
+bool TryDecodeFRINTP_H_FLOATDP1(const InstData &, Instruction &) {
   return false;
 }
 
-// CAS CAS_C64_ldstexcl:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
+// FRINTP FRINTP_S_floatdp1:
+//   0 x Rd       0
+//   1 x Rd       1
+//   2 x Rd       2
+//   3 x Rd       3
+//   4 x Rd       4
 //   5 x Rn       0
 //   6 x Rn       1
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 0 o0       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1 o1       0
-//  22 0 L        0
-//  23 1 o2       0
+//  10 0
+//  11 0
+//  12 0
+//  13 0
+//  14 1
+//  15 1 rmode    0
+//  16 0 rmode    1
+//  17 0 rmode    2
+//  18 1
+//  19 0
+//  20 0
+//  21 1
+//  22 0 type     0
+//  23 0 type     1
 //  24 0
-//  25 0
-//  26 0
+//  25 1
+//  26 1
 //  27 1
-//  28 0
-//  29 0
-//  30 1 size     0
-//  31 1 size     1
-// CAS  <Xs>, <Xt>, [<Xn|SP>{,#0}]
-bool TryDecodeCAS_C64_LDSTEXCL(const InstData &, Instruction &) {
+//  28 1
+//  29 0 S        0
+//  30 0
+//  31 0 M        0
+// FRINTP  <Sd>, <Sn>
+bool TryDecodeFRINTP_S_FLOATDP1(const InstData &, Instruction &) {
   return false;
 }
 
-// CASL CASL_C64_ldstexcl:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
+// FRINTP FRINTP_D_floatdp1:
+//   0 x Rd       0
+//   1 x Rd       1
+//   2 x Rd       2
+//   3 x Rd       3
+//   4 x Rd       4
 //   5 x Rn       0
 //   6 x Rn       1
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 1 o0       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1 o1       0
-//  22 0 L        0
-//  23 1 o2       0
+//  10 0
+//  11 0
+//  12 0
+//  13 0
+//  14 1
+//  15 1 rmode    0
+//  16 0 rmode    1
+//  17 0 rmode    2
+//  18 1
+//  19 0
+//  20 0
+//  21 1
+//  22 1 type     0
+//  23 0 type     1
 //  24 0
-//  25 0
-//  26 0
+//  25 1
+//  26 1
 //  27 1
-//  28 0
-//  29 0
-//  30 1 size     0
-//  31 1 size     1
-// CASL  <Xs>, <Xt>, [<Xn|SP>{,#0}]
-bool TryDecodeCASL_C64_LDSTEXCL(const InstData &, Instruction &) {
+//  28 1
+//  29 0 S        0
+//  30 0
+//  31 0 M        0
+// FRINTP  <Dd>, <Dn>
+bool TryDecodeFRINTP_D_FLOATDP1(const InstData &, Instruction &) {
   return false;
 }
 
@@ -20889,240 +19825,88 @@ bool TryDecodeFCMLT_ASIMDMISCFP16_FZ(const InstData &, Instruction &) {
 //  25 1
 //  26 1
 //  27 1
-//  28 0
-//  29 0 U        0
-//  30 x Q        0
-//  31 0
-// FCMLT  <Vd>.<T>, <Vn>.<T>, #0.0
-bool TryDecodeFCMLT_ASIMDMISC_FZ(const InstData &, Instruction &) {
-  return false;
-}
-
-// SQRDMULH SQRDMULH_asisdsame_only:
-//   0 x Rd       0
-//   1 x Rd       1
-//   2 x Rd       2
-//   3 x Rd       3
-//   4 x Rd       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1
-//  11 0 opcode   0
-//  12 1 opcode   1
-//  13 1 opcode   2
-//  14 0 opcode   3
-//  15 1 opcode   4
-//  16 x Rm       0
-//  17 x Rm       1
-//  18 x Rm       2
-//  19 x Rm       3
-//  20 x Rm       4
-//  21 1
-//  22 x size     0
-//  23 x size     1
-//  24 0
-//  25 1
-//  26 1
-//  27 1
-//  28 1
-//  29 1 U        0
-//  30 1
-//  31 0
-// SQRDMULH  <V><d>, <V><n>, <V><m>
-bool TryDecodeSQRDMULH_ASISDSAME_ONLY(const InstData &, Instruction &) {
-  return false;
-}
-
-// SQRDMULH SQRDMULH_asimdsame_only:
-//   0 x Rd       0
-//   1 x Rd       1
-//   2 x Rd       2
-//   3 x Rd       3
-//   4 x Rd       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1
-//  11 0 opcode   0
-//  12 1 opcode   1
-//  13 1 opcode   2
-//  14 0 opcode   3
-//  15 1 opcode   4
-//  16 x Rm       0
-//  17 x Rm       1
-//  18 x Rm       2
-//  19 x Rm       3
-//  20 x Rm       4
-//  21 1
-//  22 x size     0
-//  23 x size     1
-//  24 0
-//  25 1
-//  26 1
-//  27 1
-//  28 0
-//  29 1 U        0
-//  30 x Q        0
-//  31 0
-// SQRDMULH  <Vd>.<T>, <Vn>.<T>, <Vm>.<T>
-bool TryDecodeSQRDMULH_ASIMDSAME_ONLY(const InstData &, Instruction &) {
-  return false;
-}
-
-// SWPAH SWPAH_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 0 size     1
-// SWPAH  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeSWPAH_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// SWPALH SWPALH_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 0 size     1
-// SWPALH  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeSWPALH_32_MEMOP(const InstData &, Instruction &) {
+//  28 0
+//  29 0 U        0
+//  30 x Q        0
+//  31 0
+// FCMLT  <Vd>.<T>, <Vn>.<T>, #0.0
+bool TryDecodeFCMLT_ASIMDMISC_FZ(const InstData &, Instruction &) {
   return false;
 }
 
-// SWPH SWPH_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
+// SQRDMULH SQRDMULH_asisdsame_only:
+//   0 x Rd       0
+//   1 x Rd       1
+//   2 x Rd       2
+//   3 x Rd       3
+//   4 x Rd       4
 //   5 x Rn       0
 //   6 x Rn       1
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
+//  10 1
+//  11 0 opcode   0
+//  12 1 opcode   1
+//  13 1 opcode   2
+//  14 0 opcode   3
+//  15 1 opcode   4
+//  16 x Rm       0
+//  17 x Rm       1
+//  18 x Rm       2
+//  19 x Rm       3
+//  20 x Rm       4
 //  21 1
-//  22 0 R        0
-//  23 0 A        0
+//  22 x size     0
+//  23 x size     1
 //  24 0
-//  25 0
-//  26 0 V        0
+//  25 1
+//  26 1
 //  27 1
 //  28 1
-//  29 1
-//  30 1 size     0
-//  31 0 size     1
-// SWPH  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeSWPH_32_MEMOP(const InstData &, Instruction &) {
+//  29 1 U        0
+//  30 1
+//  31 0
+// SQRDMULH  <V><d>, <V><n>, <V><m>
+bool TryDecodeSQRDMULH_ASISDSAME_ONLY(const InstData &, Instruction &) {
   return false;
 }
 
-// SWPLH SWPLH_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
+// SQRDMULH SQRDMULH_asimdsame_only:
+//   0 x Rd       0
+//   1 x Rd       1
+//   2 x Rd       2
+//   3 x Rd       3
+//   4 x Rd       4
 //   5 x Rn       0
 //   6 x Rn       1
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
+//  10 1
+//  11 0 opcode   0
+//  12 1 opcode   1
+//  13 1 opcode   2
+//  14 0 opcode   3
+//  15 1 opcode   4
+//  16 x Rm       0
+//  17 x Rm       1
+//  18 x Rm       2
+//  19 x Rm       3
+//  20 x Rm       4
 //  21 1
-//  22 1 R        0
-//  23 0 A        0
+//  22 x size     0
+//  23 x size     1
 //  24 0
-//  25 0
-//  26 0 V        0
+//  25 1
+//  26 1
 //  27 1
-//  28 1
-//  29 1
-//  30 1 size     0
-//  31 0 size     1
-// SWPLH  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeSWPLH_32_MEMOP(const InstData &, Instruction &) {
+//  28 0
+//  29 1 U        0
+//  30 x Q        0
+//  31 0
+// SQRDMULH  <Vd>.<T>, <Vn>.<T>, <Vm>.<T>
+bool TryDecodeSQRDMULH_ASIMDSAME_ONLY(const InstData &, Instruction &) {
   return false;
 }
 
@@ -21577,236 +20361,84 @@ bool TryDecodeLDUMAXL_64_MEMOP(const InstData &, Instruction &) {
 //  29 1 U        0
 //  30 1
 //  31 0
-// SQNEG  <V><d>, <V><n>
-bool TryDecodeSQNEG_ASISDMISC_R(const InstData &, Instruction &) {
-  return false;
-}
-
-// SQNEG SQNEG_asimdmisc_R:
-//   0 x Rd       0
-//   1 x Rd       1
-//   2 x Rd       2
-//   3 x Rd       3
-//   4 x Rd       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 1
-//  12 1 opcode   0
-//  13 1 opcode   1
-//  14 1 opcode   2
-//  15 0 opcode   3
-//  16 0 opcode   4
-//  17 0
-//  18 0
-//  19 0
-//  20 0
-//  21 1
-//  22 x size     0
-//  23 x size     1
-//  24 0
-//  25 1
-//  26 1
-//  27 1
-//  28 0
-//  29 1 U        0
-//  30 x Q        0
-//  31 0
-// SQNEG  <Vd>.<T>, <Vn>.<T>
-bool TryDecodeSQNEG_ASIMDMISC_R(const InstData &, Instruction &) {
-  return false;
-}
-
-// UHADD UHADD_asimdsame_only:
-//   0 x Rd       0
-//   1 x Rd       1
-//   2 x Rd       2
-//   3 x Rd       3
-//   4 x Rd       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1
-//  11 0 opcode   0
-//  12 0 opcode   1
-//  13 0 opcode   2
-//  14 0 opcode   3
-//  15 0 opcode   4
-//  16 x Rm       0
-//  17 x Rm       1
-//  18 x Rm       2
-//  19 x Rm       3
-//  20 x Rm       4
-//  21 1
-//  22 x size     0
-//  23 x size     1
-//  24 0
-//  25 1
-//  26 1
-//  27 1
-//  28 0
-//  29 1 U        0
-//  30 x Q        0
-//  31 0
-// UHADD  <Vd>.<T>, <Vn>.<T>, <Vm>.<T>
-bool TryDecodeUHADD_ASIMDSAME_ONLY(const InstData &, Instruction &) {
-  return false;
-}
-
-// CASAH CASAH_C32_ldstexcl:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 0 o0       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1 o1       0
-//  22 1 L        0
-//  23 1 o2       0
-//  24 0
-//  25 0
-//  26 0
-//  27 1
-//  28 0
-//  29 0
-//  30 1 size     0
-//  31 0 size     1
-// CASAH  <Ws>, <Wt>, [<Xn|SP>{,#0}]
-bool TryDecodeCASAH_C32_LDSTEXCL(const InstData &, Instruction &) {
-  return false;
-}
-
-// CASALH CASALH_C32_ldstexcl:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 1 o0       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1 o1       0
-//  22 1 L        0
-//  23 1 o2       0
-//  24 0
-//  25 0
-//  26 0
-//  27 1
-//  28 0
-//  29 0
-//  30 1 size     0
-//  31 0 size     1
-// CASALH  <Ws>, <Wt>, [<Xn|SP>{,#0}]
-bool TryDecodeCASALH_C32_LDSTEXCL(const InstData &, Instruction &) {
+// SQNEG  <V><d>, <V><n>
+bool TryDecodeSQNEG_ASISDMISC_R(const InstData &, Instruction &) {
   return false;
 }
 
-// CASH CASH_C32_ldstexcl:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
+// SQNEG SQNEG_asimdmisc_R:
+//   0 x Rd       0
+//   1 x Rd       1
+//   2 x Rd       2
+//   3 x Rd       3
+//   4 x Rd       4
 //   5 x Rn       0
 //   6 x Rn       1
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 0 o0       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1 o1       0
-//  22 0 L        0
-//  23 1 o2       0
+//  10 0
+//  11 1
+//  12 1 opcode   0
+//  13 1 opcode   1
+//  14 1 opcode   2
+//  15 0 opcode   3
+//  16 0 opcode   4
+//  17 0
+//  18 0
+//  19 0
+//  20 0
+//  21 1
+//  22 x size     0
+//  23 x size     1
 //  24 0
-//  25 0
-//  26 0
+//  25 1
+//  26 1
 //  27 1
 //  28 0
-//  29 0
-//  30 1 size     0
-//  31 0 size     1
-// CASH  <Ws>, <Wt>, [<Xn|SP>{,#0}]
-bool TryDecodeCASH_C32_LDSTEXCL(const InstData &, Instruction &) {
+//  29 1 U        0
+//  30 x Q        0
+//  31 0
+// SQNEG  <Vd>.<T>, <Vn>.<T>
+bool TryDecodeSQNEG_ASIMDMISC_R(const InstData &, Instruction &) {
   return false;
 }
 
-// CASLH CASLH_C32_ldstexcl:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
+// UHADD UHADD_asimdsame_only:
+//   0 x Rd       0
+//   1 x Rd       1
+//   2 x Rd       2
+//   3 x Rd       3
+//   4 x Rd       4
 //   5 x Rn       0
 //   6 x Rn       1
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 1 o0       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1 o1       0
-//  22 0 L        0
-//  23 1 o2       0
+//  10 1
+//  11 0 opcode   0
+//  12 0 opcode   1
+//  13 0 opcode   2
+//  14 0 opcode   3
+//  15 0 opcode   4
+//  16 x Rm       0
+//  17 x Rm       1
+//  18 x Rm       2
+//  19 x Rm       3
+//  20 x Rm       4
+//  21 1
+//  22 x size     0
+//  23 x size     1
 //  24 0
-//  25 0
-//  26 0
+//  25 1
+//  26 1
 //  27 1
 //  28 0
-//  29 0
-//  30 1 size     0
-//  31 0 size     1
-// CASLH  <Ws>, <Wt>, [<Xn|SP>{,#0}]
-bool TryDecodeCASLH_C32_LDSTEXCL(const InstData &, Instruction &) {
+//  29 1 U        0
+//  30 x Q        0
+//  31 0
+// UHADD  <Vd>.<T>, <Vn>.<T>, <Vm>.<T>
+bool TryDecodeUHADD_ASIMDSAME_ONLY(const InstData &, Instruction &) {
   return false;
 }
 
@@ -23671,232 +22303,80 @@ bool TryDecodeSLI_ASIMDSHF_R(const InstData &, Instruction &) {
 bool TryDecodeLDAXRH_LR32_LDSTEXCL(const InstData &, Instruction &) {
   return false;
 }
-
-// BFM BFI_BFM_32M_bitfield:
-//   0 x Rd       0
-//   1 x Rd       1
-//   2 x Rd       2
-//   3 x Rd       3
-//   4 x Rd       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 x imms     0
-//  11 x imms     1
-//  12 x imms     2
-//  13 x imms     3
-//  14 x imms     4
-//  15 x imms     5
-//  16 x immr     0
-//  17 x immr     1
-//  18 x immr     2
-//  19 x immr     3
-//  20 x immr     4
-//  21 x immr     5
-//  22 0 N        0
-//  23 0
-//  24 1
-//  25 1
-//  26 0
-//  27 0
-//  28 1
-//  29 1 opc      0
-//  30 0 opc      1
-//  31 0 sf       0
-// BFI  <Wd>, <Wn>, #<lsb>, #<width>
-bool TryDecodeBFI_BFM_32M_BITFIELD(const InstData &, Instruction &) {
-  return false;
-}
-
-// BFM BFI_BFM_64M_bitfield:
-//   0 x Rd       0
-//   1 x Rd       1
-//   2 x Rd       2
-//   3 x Rd       3
-//   4 x Rd       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 x imms     0
-//  11 x imms     1
-//  12 x imms     2
-//  13 x imms     3
-//  14 x imms     4
-//  15 x imms     5
-//  16 x immr     0
-//  17 x immr     1
-//  18 x immr     2
-//  19 x immr     3
-//  20 x immr     4
-//  21 x immr     5
-//  22 1 N        0
-//  23 0
-//  24 1
-//  25 1
-//  26 0
-//  27 0
-//  28 1
-//  29 1 opc      0
-//  30 0 opc      1
-//  31 1 sf       0
-// BFI  <Xd>, <Xn>, #<lsb>, #<width>
-bool TryDecodeBFI_BFM_64M_BITFIELD(const InstData &, Instruction &) {
-  return false;
-}
-
-// LDADDAB LDADDAB_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 0 size     1
-// LDADDAB  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDADDAB_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// LDADDALB LDADDALB_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 0 size     1
-// LDADDALB  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDADDALB_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// LDADDB LDADDB_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
+
+// BFM BFI_BFM_32M_bitfield:
+//   0 x Rd       0
+//   1 x Rd       1
+//   2 x Rd       2
+//   3 x Rd       3
+//   4 x Rd       4
 //   5 x Rn       0
 //   6 x Rn       1
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 0 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
+//  10 x imms     0
+//  11 x imms     1
+//  12 x imms     2
+//  13 x imms     3
+//  14 x imms     4
+//  15 x imms     5
+//  16 x immr     0
+//  17 x immr     1
+//  18 x immr     2
+//  19 x immr     3
+//  20 x immr     4
+//  21 x immr     5
+//  22 0 N        0
+//  23 0
+//  24 1
+//  25 1
+//  26 0
+//  27 0
 //  28 1
-//  29 1
-//  30 0 size     0
-//  31 0 size     1
-// LDADDB  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDADDB_32_MEMOP(const InstData &, Instruction &) {
+//  29 1 opc      0
+//  30 0 opc      1
+//  31 0 sf       0
+// BFI  <Wd>, <Wn>, #<lsb>, #<width>
+bool TryDecodeBFI_BFM_32M_BITFIELD(const InstData &, Instruction &) {
   return false;
 }
 
-// LDADDLB LDADDLB_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
+// BFM BFI_BFM_64M_bitfield:
+//   0 x Rd       0
+//   1 x Rd       1
+//   2 x Rd       2
+//   3 x Rd       3
+//   4 x Rd       4
 //   5 x Rn       0
 //   6 x Rn       1
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 0 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 0 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
+//  10 x imms     0
+//  11 x imms     1
+//  12 x imms     2
+//  13 x imms     3
+//  14 x imms     4
+//  15 x imms     5
+//  16 x immr     0
+//  17 x immr     1
+//  18 x immr     2
+//  19 x immr     3
+//  20 x immr     4
+//  21 x immr     5
+//  22 1 N        0
+//  23 0
+//  24 1
+//  25 1
+//  26 0
+//  27 0
 //  28 1
-//  29 1
-//  30 0 size     0
-//  31 0 size     1
-// LDADDLB  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeLDADDLB_32_MEMOP(const InstData &, Instruction &) {
+//  29 1 opc      0
+//  30 0 opc      1
+//  31 1 sf       0
+// BFI  <Xd>, <Xn>, #<lsb>, #<width>
+bool TryDecodeBFI_BFM_64M_BITFIELD(const InstData &, Instruction &) {
   return false;
 }
 
@@ -24494,245 +22974,93 @@ bool TryDecodeFRINTM_ASIMDMISC_R(const InstData &, Instruction &) {
 //  20 x immh     1
 //  21 x immh     2
 //  22 x immh     3
-//  23 0
-//  24 1
-//  25 1
-//  26 1
-//  27 1
-//  28 1
-//  29 1 U        0
-//  30 1
-//  31 0
-// SQSHLU  <V><d>, <V><n>, #<shift>
-bool TryDecodeSQSHLU_ASISDSHF_R(const InstData &, Instruction &) {
-  return false;
-}
-
-// SQSHLU SQSHLU_asimdshf_R:
-//   0 x Rd       0
-//   1 x Rd       1
-//   2 x Rd       2
-//   3 x Rd       3
-//   4 x Rd       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1
-//  11 0
-//  12 0 op       0
-//  13 1
-//  14 1
-//  15 0
-//  16 x immb     0
-//  17 x immb     1
-//  18 x immb     2
-//  19 x immh     0
-//  20 x immh     1
-//  21 x immh     2
-//  22 x immh     3
-//  23 0
-//  24 1
-//  25 1
-//  26 1
-//  27 1
-//  28 0
-//  29 1 U        0
-//  30 x Q        0
-//  31 0
-// SQSHLU  <Vd>.<T>, <Vn>.<T>, #<shift>
-bool TryDecodeSQSHLU_ASIMDSHF_R(const InstData &, Instruction &) {
-  return false;
-}
-
-// UMULL UMULL_asimdelem_L:
-//   0 x Rd       0
-//   1 x Rd       1
-//   2 x Rd       2
-//   3 x Rd       3
-//   4 x Rd       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 x H        0
-//  12 0 opcode   0
-//  13 1 opcode   1
-//  14 0 opcode   2
-//  15 1 opcode   3
-//  16 x Rm       0
-//  17 x Rm       1
-//  18 x Rm       2
-//  19 x Rm       3
-//  20 x M        0
-//  21 x L        0
-//  22 x size     0
-//  23 x size     1
-//  24 1
-//  25 1
-//  26 1
-//  27 1
-//  28 0
-//  29 1 U        0
-//  30 x Q        0
-//  31 0
-// UMULL{2}  <Vd>.<Ta>, <Vn>.<Tb>, <Vm>.<Ts>[<index>]
-bool TryDecodeUMULL_ASIMDELEM_L(const InstData &, Instruction &) {
-  return false;
-}
-
-// SWPAB SWPAB_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
-//  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 0 size     1
-// SWPAB  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeSWPAB_32_MEMOP(const InstData &, Instruction &) {
-  return false;
-}
-
-// SWPALB SWPALB_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 1 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
+//  23 0
+//  24 1
+//  25 1
+//  26 1
 //  27 1
 //  28 1
-//  29 1
-//  30 0 size     0
-//  31 0 size     1
-// SWPALB  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeSWPALB_32_MEMOP(const InstData &, Instruction &) {
+//  29 1 U        0
+//  30 1
+//  31 0
+// SQSHLU  <V><d>, <V><n>, #<shift>
+bool TryDecodeSQSHLU_ASISDSHF_R(const InstData &, Instruction &) {
   return false;
 }
 
-// SWPB SWPB_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
+// SQSHLU SQSHLU_asimdshf_R:
+//   0 x Rd       0
+//   1 x Rd       1
+//   2 x Rd       2
+//   3 x Rd       3
+//   4 x Rd       4
 //   5 x Rn       0
 //   6 x Rn       1
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
-//  10 0
+//  10 1
 //  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 0 R        0
-//  23 0 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
+//  12 0 op       0
+//  13 1
+//  14 1
+//  15 0
+//  16 x immb     0
+//  17 x immb     1
+//  18 x immb     2
+//  19 x immh     0
+//  20 x immh     1
+//  21 x immh     2
+//  22 x immh     3
+//  23 0
+//  24 1
+//  25 1
+//  26 1
 //  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 0 size     1
-// SWPB  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeSWPB_32_MEMOP(const InstData &, Instruction &) {
+//  28 0
+//  29 1 U        0
+//  30 x Q        0
+//  31 0
+// SQSHLU  <Vd>.<T>, <Vn>.<T>, #<shift>
+bool TryDecodeSQSHLU_ASIMDSHF_R(const InstData &, Instruction &) {
   return false;
 }
 
-// SWPLB SWPLB_32_memop:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
+// UMULL UMULL_asimdelem_L:
+//   0 x Rd       0
+//   1 x Rd       1
+//   2 x Rd       2
+//   3 x Rd       3
+//   4 x Rd       4
 //   5 x Rn       0
 //   6 x Rn       1
 //   7 x Rn       2
 //   8 x Rn       3
 //   9 x Rn       4
 //  10 0
-//  11 0
-//  12 0 opc      0
-//  13 0 opc      1
-//  14 0 opc      2
-//  15 1 o3       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1
-//  22 1 R        0
-//  23 0 A        0
-//  24 0
-//  25 0
-//  26 0 V        0
+//  11 x H        0
+//  12 0 opcode   0
+//  13 1 opcode   1
+//  14 0 opcode   2
+//  15 1 opcode   3
+//  16 x Rm       0
+//  17 x Rm       1
+//  18 x Rm       2
+//  19 x Rm       3
+//  20 x M        0
+//  21 x L        0
+//  22 x size     0
+//  23 x size     1
+//  24 1
+//  25 1
+//  26 1
 //  27 1
-//  28 1
-//  29 1
-//  30 0 size     0
-//  31 0 size     1
-// SWPLB  <Ws>, <Wt>, [<Xn|SP>]
-bool TryDecodeSWPLB_32_MEMOP(const InstData &, Instruction &) {
+//  28 0
+//  29 1 U        0
+//  30 x Q        0
+//  31 0
+// UMULL{2}  <Vd>.<Ta>, <Vn>.<Tb>, <Vm>.<Ts>[<index>]
+bool TryDecodeUMULL_ASIMDELEM_L(const InstData &, Instruction &) {
   return false;
 }
 
@@ -28005,158 +26333,6 @@ bool TryDecodePRFM_P_LOADLIT(const InstData &, Instruction &) {
   return false;
 }
 
-// CASAB CASAB_C32_ldstexcl:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 0 o0       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1 o1       0
-//  22 1 L        0
-//  23 1 o2       0
-//  24 0
-//  25 0
-//  26 0
-//  27 1
-//  28 0
-//  29 0
-//  30 0 size     0
-//  31 0 size     1
-// CASAB  <Ws>, <Wt>, [<Xn|SP>{,#0}]
-bool TryDecodeCASAB_C32_LDSTEXCL(const InstData &, Instruction &) {
-  return false;
-}
-
-// CASALB CASALB_C32_ldstexcl:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 1 o0       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1 o1       0
-//  22 1 L        0
-//  23 1 o2       0
-//  24 0
-//  25 0
-//  26 0
-//  27 1
-//  28 0
-//  29 0
-//  30 0 size     0
-//  31 0 size     1
-// CASALB  <Ws>, <Wt>, [<Xn|SP>{,#0}]
-bool TryDecodeCASALB_C32_LDSTEXCL(const InstData &, Instruction &) {
-  return false;
-}
-
-// CASB CASB_C32_ldstexcl:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 0 o0       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1 o1       0
-//  22 0 L        0
-//  23 1 o2       0
-//  24 0
-//  25 0
-//  26 0
-//  27 1
-//  28 0
-//  29 0
-//  30 0 size     0
-//  31 0 size     1
-// CASB  <Ws>, <Wt>, [<Xn|SP>{,#0}]
-bool TryDecodeCASB_C32_LDSTEXCL(const InstData &, Instruction &) {
-  return false;
-}
-
-// CASLB CASLB_C32_ldstexcl:
-//   0 x Rt       0
-//   1 x Rt       1
-//   2 x Rt       2
-//   3 x Rt       3
-//   4 x Rt       4
-//   5 x Rn       0
-//   6 x Rn       1
-//   7 x Rn       2
-//   8 x Rn       3
-//   9 x Rn       4
-//  10 1 Rt2      0
-//  11 1 Rt2      1
-//  12 1 Rt2      2
-//  13 1 Rt2      3
-//  14 1 Rt2      4
-//  15 1 o0       0
-//  16 x Rs       0
-//  17 x Rs       1
-//  18 x Rs       2
-//  19 x Rs       3
-//  20 x Rs       4
-//  21 1 o1       0
-//  22 0 L        0
-//  23 1 o2       0
-//  24 0
-//  25 0
-//  26 0
-//  27 1
-//  28 0
-//  29 0
-//  30 0 size     0
-//  31 0 size     1
-// CASLB  <Ws>, <Wt>, [<Xn|SP>{,#0}]
-bool TryDecodeCASLB_C32_LDSTEXCL(const InstData &, Instruction &) {
-  return false;
-}
-
 // SUBS NEGS_SUBS_32_addsub_shift:
 //   0 x Rd       0
 //   1 x Rd       1
@@ -0,0 +1,309 @@
+# Copyright (c) 2020 Trail of Bits, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Emits the table-driven part of `Extract.cpp`. This is used by `GenOpMap.py`.
+#
+# Every encoding is described by a mask/value pair, its iform and iclass, and
+# a list of steps that fill in the fields of an `InstData`. Encodings with the
+# same steps share one field extractor function.
+#
+# Encodings are found by gathering a few "selector" bits of the instruction
+# into an index into a table of candidate lists. Each candidate list holds
+# the encodings whose fixed bits agree with the selector bits, in the same
+# order as the `first_level` chain that they came from, so the first match is
+# the same as it would be when trying the whole chain.
+
+FIELD = 'field'  # (FIELD, name, suffix, int_size, lo_bit, num_bits)
+NOT_EQUAL = 'neq'  # (NOT_EQUAL, name, suffix, value)
+IMM_HI_LO = 'hilo'  # (IMM_HI_LO, lo_size)
+
+
+class Encoding(object):
+  def __init__(self, iform, iclass, mask, value, steps):
+    self.iform = iform
+    self.iclass = iclass
+    self.mask = mask
+    self.value = value
+    self.steps = tuple(steps)
+
+  # Returns `True` if the encoding matches every instruction that agrees with
+  # the selector bits in `selector_mask`.
+  def is_decided_by(self, selector_mask):
+    if self.mask & ~selector_mask:
+      return False
+    return all(step[0] != NOT_EQUAL for step in self.steps)
+
+
+def _split(leaves, bit):
+  new_leaves = []
+  for encs in leaves:
+    zero, one = [], []
+    for enc in encs:
+      if not (enc.mask >> bit) & 1:
+        zero.append(enc)
+        one.append(enc)
+      elif (enc.value >> bit) & 1:
+        one.append(enc)
+      else:
+        zero.append(enc)
+    new_leaves.append(zero)
+    new_leaves.append(one)
+  return new_leaves
+
+
+def _cost(leaves):
+  return sum(len(encs) for encs in leaves) / float(len(leaves))
+
+
+def choose_selector_bits(first_level_bits, chains, max_bits):
+  """Greedily pick selector bits that minimize the average number of
+  candidates per leaf. The first level bits are always selected, so that
+  every leaf comes from exactly one chain."""
+  selector = list(first_level_bits)
+  leaves = [list(chain) for chain in chains]
+  while len(selector) < max_bits:
+    best = None
+    for bit in range(32):
+      if bit in selector:
+        continue
+      cost = _cost(_split(leaves, bit))
+      if best is None or cost < best[0]:
+        best = (cost, bit)
+    if best is None or best[0] >= _cost(leaves) * 0.9:
+      break
+    selector.append(best[1])
+    leaves = _split(leaves, best[1])
+  return selector
+
+
+def _leaf_candidates(index, selector, chains, num_first_level_bits):
+  chain = chains[index & ((1 << num_first_level_bits) - 1)]
+  selector_mask = 0
+  for bit in selector:
+    selector_mask |= 1 << bit
+
+  bits = 0
+  for k, bit in enumerate(selector):
+    bits |= ((index >> k) & 1) << bit
+
+  encs = []
+  for enc in chain:
+    if (bits & enc.mask & selector_mask) != (enc.value & selector_mask):
+      continue
+    encs.append(enc)
+
+    # Nothing after this encoding can ever be reached.
+    if enc.is_decided_by(selector_mask):
+      break
+  return encs
+
+
+def _disjoint(a, b):
+  return (a.mask & b.mask & (a.value ^ b.value)) != 0
+
+
+def _is_safe_hot_encoding(enc, selector, leaves):
+  """Returns `True` if trying `enc` before looking up the candidates can't
+  change which encoding is found. That is the case when, in every leaf that
+  `enc` can match, `enc` is a candidate, and no earlier candidate can match
+  the same instruction."""
+  selector_mask = 0
+  for bit in selector:
+    selector_mask |= 1 << bit
+
+  for index, encs in enumerate(leaves):
+    bits = 0
+    for k, bit in enumerate(selector):
+      bits |= ((index >> k) & 1) << bit
+    if (bits & enc.mask & selector_mask) != (enc.value & selector_mask):
+      continue
+    if enc not in encs:
+      return False
+    for other in encs[:encs.index(enc)]:
+      if not _disjoint(enc, other):
+        return False
+  return True
+
+
+def _step_lines(step):
+  if step[0] == FIELD:
+    _, name, suffix, int_size, lo, num_bits = step
+    val = 'bits'
+    if lo:
+      val = 'bits >> {}U'.format(lo)
+    if lo + num_bits < 32:
+      if lo:
+        val = '(' + val + ')'
+      val = '{} & 0x{:x}U'.format(val, (1 << num_bits) - 1)
+    return ['  inst.{}{} = static_cast<uint{}_t>({});'.format(
+        name, suffix, int_size, val)]
+
+  elif step[0] == NOT_EQUAL:
+    _, name, suffix, value = step
+    return ['  if (inst.{}{} == 0x{:x}) {{'.format(name, suffix, value),
+            '    return false;',
+            '  }']
+
+  elif step[0] == IMM_HI_LO:
+    return [
+        '  inst.immhi_immlo.uimm = static_cast<uint64_t>(inst.immhi.uimm);',
+        '  inst.immhi_immlo.uimm <<= static_cast<uint64_t>({}U);'.format(
+            step[1]),
+        '  inst.immhi_immlo.uimm |= static_cast<uint64_t>(inst.immlo.uimm);']
+
+  assert False, "Unknown step {}".format(step)
+
+
+def _write_int_list(impl, ints, per_line):
+  for i in range(0, len(ints), per_line):
+    impl.write('    {},\n'.format(', '.join(
+        str(n) for n in ints[i:i + per_line])))
+
+
+def emit(impl, encodings, first_level_bits, chains, hot_iforms=(),
+         max_selector_bits=11):
+  """Write out the extractors and tables into `impl`, inside of an anonymous
+  namespace. Returns the selector bits to pass to `emit_try_extract`.
+
+  `encodings` is the list of all encodings, `first_level_bits` are the bit
+  positions that index into `chains`, and each chain is a priority-ordered
+  list of the encodings that can match that index. The encodings of
+  `hot_iforms` are tried before the candidates are looked up, as long as
+  doing so can't change the result."""
+  # Candidate lists, indexed by the selector bits.
+  selector = choose_selector_bits(first_level_bits, chains, max_selector_bits)
+  leaves = []
+  for index in range(1 << len(selector)):
+    leaves.append(_leaf_candidates(index, selector, chains,
+                                   len(first_level_bits)))
+
+  # Only keep the encodings that are candidates. E.g. aliases never are.
+  used = set()
+  for encs in leaves:
+    used.update(enc.iform for enc in encs)
+  encodings = [enc for enc in encodings if enc.iform in used]
+
+  hot_encodings = []
+  for iform in hot_iforms:
+    enc = [enc for enc in encodings if enc.iform == iform]
+    assert len(enc) == 1, "Unknown hot iform {}".format(iform)
+    assert _is_safe_hot_encoding(enc[0], selector, leaves), \
+        "Hot iform {} can't be tried first".format(iform)
+    hot_encodings.append(enc[0])
+
+  enc_ids = {}
+  for enc in encodings:
+    enc_ids[enc.iform] = len(enc_ids)
+
+  extractor_ids = {}
+  extractors = []
+  for enc in encodings:
+    if enc.steps not in extractor_ids:
+      extractor_ids[enc.steps] = len(extractors)
+      extractors.append(enc.steps)
+
+  # Shared field extractors.
+  for i, steps in enumerate(extractors):
+    impl.write('static bool ExtractFields{}(InstData &inst, uint32_t bits) {{\n'.format(i))
+    for step in steps:
+      for line in _step_lines(step):
+        impl.write(line + '\n')
+    impl.write('  return true;\n')
+    impl.write('}\n\n')
+
+  impl.write('static bool (*const kExtractFields[])(InstData &, uint32_t) = {\n')
+  for i in range(len(extractors)):
+    impl.write('    ExtractFields{},\n'.format(i))
+  impl.write('};\n\n')
+
+  # One row per encoding.
+  impl.write('struct Encoding {\n')
+  impl.write('  uint32_t mask;\n')
+  impl.write('  uint32_t value;\n')
+  impl.write('  InstForm iform;\n')
+  impl.write('  InstName iclass;\n')
+  impl.write('  uint16_t extract_fields;\n')
+  impl.write('};\n\n')
+
+  impl.write('static const Encoding kEncodings[] = {\n')
+  for enc in encodings:
+    row = '    {{0x{:08x}U, 0x{:08x}U, InstForm::{},'.format(
+        enc.mask, enc.value, enc.iform)
+    rest = 'InstName::{}, {}}},'.format(enc.iclass, extractor_ids[enc.steps])
+    if len(row) + 1 + len(rest) <= 80:
+      impl.write('{} {}\n'.format(row, rest))
+    else:
+      impl.write('{}\n     {}\n'.format(row, rest))
+  impl.write('};\n\n')
+
+  leaf_begin = [0]
+  candidates = []
+  for encs in leaves:
+    candidates.extend(enc_ids[enc.iform] for enc in encs)
+    leaf_begin.append(len(candidates))
+
+  begin_type = 'uint16_t' if len(candidates) < (1 << 16) else 'uint32_t'
+  impl.write('// Start of the candidates for each combination of selector bits.\n')
+  impl.write('static const {} kLeafBegin[] = {{\n'.format(begin_type))
+  _write_int_list(impl, leaf_begin, 10)
+  impl.write('};\n\n')
+
+  impl.write('// Indices into `kEncodings`, in priority order.\n')
+  impl.write('static const uint16_t kCandidates[] = {\n')
+  _write_int_list(impl, candidates, 10)
+  impl.write('};\n\n')
+
+  impl.write('// Indices into `kEncodings` of the most common encodings, which are\n')
+  impl.write('// tried before looking up the candidates.\n')
+  impl.write('static const uint16_t kHotEncodings[] = {\n')
+  _write_int_list(impl, [enc_ids[enc.iform] for enc in hot_encodings] or [0], 10)
+  impl.write('};\n\n')
+  impl.write('static constexpr unsigned kNumHotEncodings = {}U;\n\n'.format(
+      len(hot_encodings)))
+
+  return selector
+
+
+def emit_try_extract(impl, selector):
+  """Write out `TryExtract`, which looks up the candidates using the
+  `selector` bits returned by `emit`."""
+  impl.write('bool TryExtract(const uint8_t *bytes, InstData &inst) {\n')
+  impl.write('  uint32_t bits = 0;\n')
+  impl.write('  bits = (bits << 8) | static_cast<uint32_t>(bytes[3]);\n')
+  impl.write('  bits = (bits << 8) | static_cast<uint32_t>(bytes[2]);\n')
+  impl.write('  bits = (bits << 8) | static_cast<uint32_t>(bytes[1]);\n')
+  impl.write('  bits = (bits << 8) | static_cast<uint32_t>(bytes[0]);\n')
+  impl.write('  for (auto i = 0U; i < kNumHotEncodings; ++i) {\n')
+  impl.write('    const auto &enc = kEncodings[kHotEncodings[i]];\n')
+  impl.write('    if ((bits & enc.mask) == enc.value &&\n')
+  impl.write('        kExtractFields[enc.extract_fields](inst, bits)) {\n')
+  impl.write('      inst.iform = enc.iform;\n')
+  impl.write('      inst.iclass = enc.iclass;\n')
+  impl.write('      return true;\n')
+  impl.write('    }\n')
+  impl.write('  }\n')
+  impl.write('  uint32_t index = 0;\n')
+  for k, bit in enumerate(selector):
+    impl.write('  index |= ((bits >> {}U) & 1U) << {}U;\n'.format(bit, k))
+  impl.write('  for (auto i = kLeafBegin[index]; i < kLeafBegin[index + 1]; ++i) {\n')
+  impl.write('    const auto &enc = kEncodings[kCandidates[i]];\n')
+  impl.write('    if ((bits & enc.mask) == enc.value &&\n')
+  impl.write('        kExtractFields[enc.extract_fields](inst, bits)) {\n')
+  impl.write('      inst.iform = enc.iform;\n')
+  impl.write('      inst.iclass = enc.iclass;\n')
+  impl.write('      return true;\n')
+  impl.write('    }\n')
+  impl.write('  }\n')
+  impl.write('  return false;\n')
+  impl.write('}\n\n')
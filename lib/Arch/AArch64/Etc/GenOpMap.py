@@ -31,6 +31,8 @@ import math
 import os
 import sys
 
+import ExtractTable
+
 try:
   import xml.etree.cElementTree as ET
 except:
@@ -763,96 +765,40 @@ for iform in iform_names:
   impl.write('  "{}",\n'.format(iform.upper()))
 impl.write('};\n\n')
 
-# Forward declare
-for base in ENCODINGS:
-  impl.write('static bool TryExtract{}(InstData &inst, uint32_t bits);\n'.format(
-      base.iform.upper()))
-
+# Describe how to extract the fields of each encoding. Aliases are
+# disabled for now (they were never tried), so they are not candidates.
+EXTRACT_ENCODINGS = {}
 for base in ENCODINGS:
-  #print_diag(base, impl)
-  impl.write('static bool TryExtract{}(InstData &inst, uint32_t bits) {{\n'.format(
-      base.iform.upper()))
-
-  # Deal with aliases.
-  #
-  # NOTE(pag): Added in `false` to always disable aliases for now...
-  if base.iform in ALIASES:
-    aliases = list(ALIASES[base.iform])
-    aliases.sort(key=lambda base: base.bits.count('x')-32)
-    for alias_base in aliases:
-      impl.write('  if (false && TryExtract{}(inst, bits)) return true;\n'.format(
-          alias_base.iform.upper()))
-
   # Decide whether or not the bits of the instruction are an encoding
   # represented by `base`.
-  mask = ["0"] * 32
-  accept = ["0"] * 32
+  mask = 0
+  accept = 0
   for i, bit in enumerate(reversed(base.bits)):
     if bit != 'x':
-      mask[i] = '1'
-      accept[i] = bit
-
-  mask = "".join(mask)
-  accept = "".join(accept)
-
-  impl.write('  //   bits\n')
-  impl.write('  // & {}\n'.format(mask))
-  impl.write('  //   {}\n'.format("-" * 32))
-  impl.write('  //   {}\n'.format(accept))
-  impl.write('  if ((bits & 0x{:x}U) != 0x{:x}U) {{\n'.format(int(mask, 2), int(accept, 2)))
-  impl.write('    return false;\n')
-  impl.write('  }\n')
-
-  # Make a structure that has the parts of the encoding.
-  impl.write('  union {\n');
-  impl.write('    uint32_t flat;\n')
-  impl.write('    struct {\n')
-  last_name = ""
-  last_name_count = 0
+      mask |= 1 << i
+      accept |= int(bit) << i
+
+  # Find where each named field of the encoding lives.
+  field_lo_bit = {}
   struct_names = set()
   for bit, n in enumerate(base.names):
-    if not n:
-      if last_name_count:
-        impl.write('{};\n'.format(last_name_count))
-        last_name_count = 0
-        last_name = ""
-      comment = ""
-      if base.bits[bit] != 'x':
-        comment = "  // {}".format(base.bits[bit])
-      impl.write('      uint32_t _{}:1;{}\n'.format(bit, comment))
-    else:
+    if n:
       name, index = n
       struct_names.add(name)
-      if name != last_name and last_name_count:
-        impl.write('{};\n'.format(last_name_count))
-        last_name_count = 0
-        last_name = ""
-
-      if not last_name_count:
-        impl.write('      uint32_t {}:'.format(name))
-        last_name_count = 1
-        last_name = name
-      else:
-        assert last_name
-        last_name_count += 1
-
-  if last_name_count:
-    impl.write('{};\n'.format(last_name_count))
-
-  impl.write('    } __attribute__((packed));\n')
-  impl.write('  } __attribute__((packed)) enc;\n')
-  impl.write('  static_assert(sizeof(enc) == 4, " ");\n')
-  impl.write("  enc.flat = bits;\n")
+      if name not in field_lo_bit:
+        field_lo_bit[name] = bit
 
+  steps = []
   has_imm_hilo = False
   for field_name in struct_names:
     suffix = ""
     if "imm" in field_name:
       suffix = ".uimm"
 
-    impl.write('  inst.{}{} = static_cast<uint{}_t>(enc.{});\n'.format(
-        field_name, suffix, field_name_intsize[field_name], field_name))
-    
+    steps.append((ExtractTable.FIELD, field_name, suffix,
+                  field_name_intsize[field_name], field_lo_bit[field_name],
+                  base.name_size[field_name]))
+
     if field_name in ('immhi', 'immlo'):
       has_imm_hilo = True
 
@@ -865,44 +811,13 @@ for base in ENCODINGS:
         for b in sel:
           our_bits = our_bits.replace('x', b, 1)
         neq_num = int(our_bits, 2)
+        steps.append((ExtractTable.NOT_EQUAL, field_name, suffix, neq_num))
 
-        impl.write('  if (!(inst.{}{} != 0x{:x})) return false;\n'.format(
-            field_name, suffix, neq_num))
-  
   if has_imm_hilo:
-    lo_size = field_name_size['immlo']
-    impl.write('  inst.immhi_immlo.uimm = static_cast<uint64_t>(inst.immhi.uimm);\n')
-    impl.write('  inst.immhi_immlo.uimm <<= static_cast<uint64_t>({}U);\n'.format(
-        base.name_size['immlo']))
-    impl.write('  inst.immhi_immlo.uimm |= static_cast<uint64_t>(inst.immlo.uimm);\n')
-  
-  # # # Fill in in the `ops` array with op names that are present in
-  # # # the instruction.
-  # seen_field_names = set()
-  # hilo_name = ""
-  # for n in base.names:
-  #   if not n:
-  #     continue
-  #   name, index = n
-  #   if name not in field_names:
-
-  #     field_names.append(name)
-  #     if name.endswith('hi') or name.endswith('lo'):
-  #       hilo_name = name[:-2]
-
-  # for field_name in field_names:
+    steps.append((ExtractTable.IMM_HI_LO, base.name_size['immlo']))
 
-
-  # for i, field_name in enumerate(field_names):
-  #   impl.write('  inst.ops[{}] = OpName::{};\n'.format(i, field_name.upper()))
-
-  # Only fill in this info once we know that we've decoded the instruction
-  # and satisfied all of the constraints.
-  impl.write('  inst.iform = InstForm::{};\n'.format(base.iform.upper()))
-  impl.write('  inst.iclass = InstName::{};\n'.format(base.iclass.upper()))
-
-  impl.write('  return true;\n')
-  impl.write('}\n\n')
+  EXTRACT_ENCODINGS[base.iform] = ExtractTable.Encoding(
+      base.iform.upper(), base.iclass.upper(), mask, accept, steps)
 
 # for iform in iform_names:
 #   decl.write('  {},\n'.format(iform.upper()))
@@ -911,6 +826,7 @@ mask_str = chosen_to_string(0xFFFFFFFF, chosen).replace('0', '1').replace('-', '
 mask = int(mask_str, 2)
 all_bases = set()
 
+CHAINS = []
 for i in xrange(int(2**len(chosen))):
 
   # Get a bitmask of what bits to select.
@@ -948,19 +864,19 @@ for i in xrange(int(2**len(chosen))):
   bases.sort(key=lambda b: num_var_bits[b])
 
   # exit()
-  impl.write("// {}\n".format(sel_mask_str))
-  impl.write('static bool TryExtract{}(InstData &inst, uint32_t bits) {{\n'.format(i))
-  impl.write('  return false')
-  for base in bases:
-    impl.write(' ||\n         TryExtract{}(inst, bits)'.format(
-        base.iform.upper()))
-  impl.write(';\n')
-  impl.write('}\n\n')
-
-impl.write('static bool (* const kFirstLevel[])(InstData &, uint32_t) = {\n')
-for i in xrange(int(2**len(chosen))):
-  impl.write('  TryExtract{},  // {}\n'.format(i, chosen_to_string(i, chosen)))
-impl.write('};\n\n')
+  CHAINS.append([EXTRACT_ENCODINGS[base.iform] for base in bases])
+
+# The most common encodings in compiled code, roughly in decreasing order of
+# frequency. These are tried before the selector bits are looked at.
+HOT_IFORMS = [
+  "LDR_64_LDST_POS", "STR_64_LDST_POS", "ADD_64_ADDSUB_IMM",
+  "BL_ONLY_BRANCH_IMM", "B_ONLY_BRANCH_IMM", "B_ONLY_CONDBRANCH",
+  "LDR_32_LDST_POS", "STR_32_LDST_POS", "ADD_32_ADDSUB_IMM",
+]
+
+selector = ExtractTable.emit(
+    impl, [EXTRACT_ENCODINGS[base.iform] for base in ENCODINGS], chosen,
+    CHAINS, HOT_IFORMS)
 
 impl.write("}  // namespace\n")
 
@@ -989,29 +905,7 @@ const char *InstFormToString(InstForm iform) {{
 
 """.format(iclass_names[-1].upper(), iform_names[-1].upper()))
 
-impl.write("""
-bool TryExtract(const uint8_t *bytes, InstData &inst) {
-  uint32_t bits = 0;
-  bits = (bits << 8) | static_cast<uint32_t>(bytes[3]);
-  bits = (bits << 8) | static_cast<uint32_t>(bytes[2]);
-  bits = (bits << 8) | static_cast<uint32_t>(bytes[1]);
-  bits = (bits << 8) | static_cast<uint32_t>(bytes[0]);
-  uint32_t index = 0;
-""")
-
-# impl.write('  union {\n')
-# impl.write('    uint32_t flat;\n')
-# impl.write('    struct {\n')
-# for i in xrange(32):
-#   impl.write('      uint32_t _{}:1;\n'.format(i))
-# impl.write('    } __attribute__((packed)); \n')
-# impl.write('  } __attribute__((packed)) x; \n')
-# impl.write('  x.flat = bits;\n')
-for i, bit in enumerate(reversed(chosen)):
-  impl.write('  index |= ((bits >> {}U) & 1U) << {}U;\n'.format(bit, len(chosen) - i - 1))
-impl.write('  return kFirstLevel[index](inst, bits);\n')
-impl.write('}\n\n')
-
+ExtractTable.emit_try_extract(impl, selector)
 
 impl.write("}  // namespace aarch64\n")
 impl.write("}  // namespace remill\n\n")
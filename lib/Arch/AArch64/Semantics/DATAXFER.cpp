@@ -327,6 +327,113 @@ DEF_ISEL(STLXR_SR64_LDSTEXCL) = STLXR<R64, M64W>;
 
 namespace {
 
+// Armv8.1 atomic memory operations. The acquire forms (e.g. `LDADDA`) order
+// later memory accesses after the atomic access, and the release forms (e.g.
+// `LDADDL`) order earlier memory accesses before it.
+template <bool kAcquire, bool kRelease, typename S, typename D, typename M>
+DEF_SEM(LDADD, S src, D dst, M addr) {
+  if (kRelease) {
+    memory = __remill_barrier_store_store(memory);
+  }
+  auto value = TruncTo<M>(Read(src));
+  WriteZExt(dst, UFetchAdd(addr, value));
+  if (kAcquire) {
+    memory = __remill_barrier_load_load(memory);
+  }
+  return memory;
+}
+
+// There is no atomic swap intrinsic, so retry the compare-exchange until it
+// succeeds. The first attempt expects the value that a plain read sees, which
+// is usually still current, and every failed attempt gives us the latest
+// value in memory.
+template <bool kAcquire, bool kRelease, typename S, typename D, typename M>
+DEF_SEM(SWP, S src, D dst, M addr) {
+  if (kRelease) {
+    memory = __remill_barrier_store_store(memory);
+  }
+  auto value = TruncTo<M>(Read(src));
+  decltype(value) old_value = Read(addr);
+  while (!UCmpXchg(addr, old_value, value)) {
+  }
+  WriteZExt(dst, old_value);
+  if (kAcquire) {
+    memory = __remill_barrier_load_load(memory);
+  }
+  return memory;
+}
+
+template <bool kAcquire, bool kRelease, typename D, typename S1, typename S2,
+          typename M>
+DEF_SEM(CAS, D dst, S1 src1, S2 src2, M addr) {
+  if (kRelease) {
+    memory = __remill_barrier_store_store(memory);
+  }
+  auto expected = TruncTo<M>(Read(src1));
+  auto desired = TruncTo<M>(Read(src2));
+  UCmpXchg(addr, expected, desired);
+  WriteZExt(dst, expected);
+  if (kAcquire) {
+    memory = __remill_barrier_load_load(memory);
+  }
+  return memory;
+}
+
+}  // namespace
+
+DEF_ISEL(LDADD_32_MEMOP) = LDADD<false, false, R32, R32W, M32W>;
+DEF_ISEL(LDADDA_32_MEMOP) = LDADD<true, false, R32, R32W, M32W>;
+DEF_ISEL(LDADDAL_32_MEMOP) = LDADD<true, true, R32, R32W, M32W>;
+DEF_ISEL(LDADDL_32_MEMOP) = LDADD<false, true, R32, R32W, M32W>;
+DEF_ISEL(LDADD_64_MEMOP) = LDADD<false, false, R64, R64W, M64W>;
+DEF_ISEL(LDADDA_64_MEMOP) = LDADD<true, false, R64, R64W, M64W>;
+DEF_ISEL(LDADDAL_64_MEMOP) = LDADD<true, true, R64, R64W, M64W>;
+DEF_ISEL(LDADDL_64_MEMOP) = LDADD<false, true, R64, R64W, M64W>;
+DEF_ISEL(LDADDB_32_MEMOP) = LDADD<false, false, R32, R32W, M8W>;
+DEF_ISEL(LDADDAB_32_MEMOP) = LDADD<true, false, R32, R32W, M8W>;
+DEF_ISEL(LDADDALB_32_MEMOP) = LDADD<true, true, R32, R32W, M8W>;
+DEF_ISEL(LDADDLB_32_MEMOP) = LDADD<false, true, R32, R32W, M8W>;
+DEF_ISEL(LDADDH_32_MEMOP) = LDADD<false, false, R32, R32W, M16W>;
+DEF_ISEL(LDADDAH_32_MEMOP) = LDADD<true, false, R32, R32W, M16W>;
+DEF_ISEL(LDADDALH_32_MEMOP) = LDADD<true, true, R32, R32W, M16W>;
+DEF_ISEL(LDADDLH_32_MEMOP) = LDADD<false, true, R32, R32W, M16W>;
+
+DEF_ISEL(SWP_32_MEMOP) = SWP<false, false, R32, R32W, M32W>;
+DEF_ISEL(SWPA_32_MEMOP) = SWP<true, false, R32, R32W, M32W>;
+DEF_ISEL(SWPAL_32_MEMOP) = SWP<true, true, R32, R32W, M32W>;
+DEF_ISEL(SWPL_32_MEMOP) = SWP<false, true, R32, R32W, M32W>;
+DEF_ISEL(SWP_64_MEMOP) = SWP<false, false, R64, R64W, M64W>;
+DEF_ISEL(SWPA_64_MEMOP) = SWP<true, false, R64, R64W, M64W>;
+DEF_ISEL(SWPAL_64_MEMOP) = SWP<true, true, R64, R64W, M64W>;
+DEF_ISEL(SWPL_64_MEMOP) = SWP<false, true, R64, R64W, M64W>;
+DEF_ISEL(SWPB_32_MEMOP) = SWP<false, false, R32, R32W, M8W>;
+DEF_ISEL(SWPAB_32_MEMOP) = SWP<true, false, R32, R32W, M8W>;
+DEF_ISEL(SWPALB_32_MEMOP) = SWP<true, true, R32, R32W, M8W>;
+DEF_ISEL(SWPLB_32_MEMOP) = SWP<false, true, R32, R32W, M8W>;
+DEF_ISEL(SWPH_32_MEMOP) = SWP<false, false, R32, R32W, M16W>;
+DEF_ISEL(SWPAH_32_MEMOP) = SWP<true, false, R32, R32W, M16W>;
+DEF_ISEL(SWPALH_32_MEMOP) = SWP<true, true, R32, R32W, M16W>;
+DEF_ISEL(SWPLH_32_MEMOP) = SWP<false, true, R32, R32W, M16W>;
+
+DEF_ISEL(CAS_C32_LDSTEXCL) = CAS<false, false, R32W, R32, R32, M32W>;
+DEF_ISEL(CASA_C32_LDSTEXCL) = CAS<true, false, R32W, R32, R32, M32W>;
+DEF_ISEL(CASAL_C32_LDSTEXCL) = CAS<true, true, R32W, R32, R32, M32W>;
+DEF_ISEL(CASL_C32_LDSTEXCL) = CAS<false, true, R32W, R32, R32, M32W>;
+DEF_ISEL(CAS_C64_LDSTEXCL) = CAS<false, false, R64W, R64, R64, M64W>;
+DEF_ISEL(CASA_C64_LDSTEXCL) = CAS<true, false, R64W, R64, R64, M64W>;
+DEF_ISEL(CASAL_C64_LDSTEXCL) = CAS<true, true, R64W, R64, R64, M64W>;
+DEF_ISEL(CASL_C64_LDSTEXCL) = CAS<false, true, R64W, R64, R64, M64W>;
+DEF_ISEL(CASB_C32_LDSTEXCL) = CAS<false, false, R32W, R32, R32, M8W>;
+DEF_ISEL(CASAB_C32_LDSTEXCL) = CAS<true, false, R32W, R32, R32, M8W>;
+DEF_ISEL(CASALB_C32_LDSTEXCL) = CAS<true, true, R32W, R32, R32, M8W>;
+DEF_ISEL(CASLB_C32_LDSTEXCL) = CAS<false, true, R32W, R32, R32, M8W>;
+DEF_ISEL(CASH_C32_LDSTEXCL) = CAS<false, false, R32W, R32, R32, M16W>;
+DEF_ISEL(CASAH_C32_LDSTEXCL) = CAS<true, false, R32W, R32, R32, M16W>;
+DEF_ISEL(CASALH_C32_LDSTEXCL) = CAS<true, true, R32W, R32, R32, M16W>;
+DEF_ISEL(CASLH_C32_LDSTEXCL) = CAS<false, true, R32W, R32, R32, M16W>;
+
+namespace {
+
 template <typename D, typename S, typename InterType>
 DEF_SEM(LoadSExt, D dst, S src) {
   WriteZExt(dst, SExtTo<InterType>(Read(src)));
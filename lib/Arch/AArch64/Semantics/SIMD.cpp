@@ -183,15 +183,26 @@ ALWAYS_INLINE static T UMax(T lhs, T rhs) {
     return memory; \
   }
 
-MAKE_BROADCAST(ADD, U, Add, 8)
-MAKE_BROADCAST(ADD, U, Add, 16)
-MAKE_BROADCAST(ADD, U, Add, 32)
-MAKE_BROADCAST(ADD, U, Add, 64)
+// Uses the vector operators, e.g. `UAddV8`, which are a single vector
+// operation when building with native vectors.
+#define MAKE_VECTOR_BROADCAST(op, prefix, binop, size) \
+  template <typename S, typename V> \
+  DEF_SEM(op##_##size, V128W dst, S src1, S src2) { \
+    auto vec1 = prefix##ReadV##size(src1); \
+    auto vec2 = prefix##ReadV##size(src2); \
+    prefix##WriteV##size(dst, prefix##binop##V##size(vec1, vec2)); \
+    return memory; \
+  }
+
+MAKE_VECTOR_BROADCAST(ADD, U, Add, 8)
+MAKE_VECTOR_BROADCAST(ADD, U, Add, 16)
+MAKE_VECTOR_BROADCAST(ADD, U, Add, 32)
+MAKE_VECTOR_BROADCAST(ADD, U, Add, 64)
 
-MAKE_BROADCAST(SUB, U, Sub, 8)
-MAKE_BROADCAST(SUB, U, Sub, 16)
-MAKE_BROADCAST(SUB, U, Sub, 32)
-MAKE_BROADCAST(SUB, U, Sub, 64)
+MAKE_VECTOR_BROADCAST(SUB, U, Sub, 8)
+MAKE_VECTOR_BROADCAST(SUB, U, Sub, 16)
+MAKE_VECTOR_BROADCAST(SUB, U, Sub, 32)
+MAKE_VECTOR_BROADCAST(SUB, U, Sub, 64)
 
 MAKE_BROADCAST(UMIN, U, Min, 8)
 MAKE_BROADCAST(UMIN, U, Min, 16)
@@ -380,27 +391,28 @@ ALWAYS_INLINE static bool UCmpTst(T lhs, T rhs) {
   return UCmpNeq(UAnd(lhs, rhs), T(0));
 }
 
-MAKE_CMP_BROADCAST(CMPEQ, S, CmpEq, 8)
-MAKE_CMP_BROADCAST(CMPEQ, S, CmpEq, 16)
-MAKE_CMP_BROADCAST(CMPEQ, S, CmpEq, 32)
-MAKE_CMP_BROADCAST(CMPEQ, S, CmpEq, 64)
+MAKE_VECTOR_BROADCAST(CMPEQ, S, CmpEq, 8)
+MAKE_VECTOR_BROADCAST(CMPEQ, S, CmpEq, 16)
+MAKE_VECTOR_BROADCAST(CMPEQ, S, CmpEq, 32)
+MAKE_VECTOR_BROADCAST(CMPEQ, S, CmpEq, 64)
 
 MAKE_CMP_BROADCAST(CMPTST, U, CmpTst, 8)
 MAKE_CMP_BROADCAST(CMPTST, U, CmpTst, 16)
 MAKE_CMP_BROADCAST(CMPTST, U, CmpTst, 32)
 MAKE_CMP_BROADCAST(CMPTST, U, CmpTst, 64)
 
-MAKE_CMP_BROADCAST(CMPGT, S, CmpGt, 8)
-MAKE_CMP_BROADCAST(CMPGT, S, CmpGt, 16)
-MAKE_CMP_BROADCAST(CMPGT, S, CmpGt, 32)
-MAKE_CMP_BROADCAST(CMPGT, S, CmpGt, 64)
+MAKE_VECTOR_BROADCAST(CMPGT, S, CmpGt, 8)
+MAKE_VECTOR_BROADCAST(CMPGT, S, CmpGt, 16)
+MAKE_VECTOR_BROADCAST(CMPGT, S, CmpGt, 32)
+MAKE_VECTOR_BROADCAST(CMPGT, S, CmpGt, 64)
 
-MAKE_CMP_BROADCAST(CMPGE, S, CmpGte, 8)
-MAKE_CMP_BROADCAST(CMPGE, S, CmpGte, 16)
-MAKE_CMP_BROADCAST(CMPGE, S, CmpGte, 32)
-MAKE_CMP_BROADCAST(CMPGE, S, CmpGte, 64)
+MAKE_VECTOR_BROADCAST(CMPGE, S, CmpGte, 8)
+MAKE_VECTOR_BROADCAST(CMPGE, S, CmpGte, 16)
+MAKE_VECTOR_BROADCAST(CMPGE, S, CmpGte, 32)
+MAKE_VECTOR_BROADCAST(CMPGE, S, CmpGte, 64)
 
 #undef MAKE_CMP_BROADCAST
+#undef MAKE_VECTOR_BROADCAST
 
 }  // namespace
 
@@ -86,6 +86,36 @@ bool Arch::MayHaveDelaySlot(const Instruction &) const {
   return false;
 }
 
+// Returns the address of `reg` in the current register window, or `nullptr`
+// if `reg` is always at the same offset in the `State` structure.
+llvm::Value *Arch::WindowedRegisterAddress(llvm::BasicBlock *, llvm::Value *,
+                                           const Register *) const {
+  return nullptr;
+}
+
+// Decode only the length, category, and direct branch targets of an
+// instruction.
+bool Arch::DecodeControlFlow(uint64_t address, std::string_view instr_bytes,
+                             ControlFlowInfo &info) const {
+  info = {};
+  Instruction inst;
+  if (!DecodeInstruction(address, instr_bytes, inst)) {
+    return false;
+  }
+
+  info.size = inst.NumBytes();
+  info.category = inst.category;
+  info.branch_taken_pc = inst.branch_taken_pc;
+  info.branch_not_taken_pc = inst.branch_not_taken_pc;
+  info.has_delay_slot = MayHaveDelaySlot(inst);
+  return true;
+}
+
+// Returns `true` if `DecodeControlFlow` works without the semantics module.
+bool Arch::DecodesControlFlowWithoutSemantics(void) const {
+  return false;
+}
+
 // Returns `true` if a given instruction might have a delay slot.
 bool Arch::NextInstructionIsDelayed(const Instruction &, const Instruction &,
                                     bool) const {
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "remill/Arch/InstructionIndex.h"
+
+#include <glog/logging.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#include "remill/Arch/Arch.h"
+#include "remill/Arch/Instruction.h"
+#include "remill/Arch/Name.h"
+#include "remill/BC/Util.h"
+#include "remill/OS/OS.h"
+
+namespace remill {
+namespace {
+
+// Everything that one thread needs to decode control flow. An `Arch` is tied
+// to its context, so each decoder needs its own context. Architectures that
+// fall back on a full decode also need their semantics.
+struct SweepDecoder {
+  SweepDecoder(OSName os_name, ArchName arch_name)
+      : arch(Arch::Build(&context, os_name, arch_name)) {
+    if (arch && !arch->DecodesControlFlowWithoutSemantics()) {
+      semantics = LoadArchSemantics(arch.get());
+    }
+  }
+
+  bool IsValid(void) const {
+    return arch && (semantics || arch->DecodesControlFlowWithoutSemantics());
+  }
+
+  llvm::LLVMContext context;
+  Arch::ArchPtr arch;
+  std::unique_ptr<llvm::Module> semantics;
+};
+
+// The result of sweeping one chunk of the bytes.
+struct SweepChunk {
+  // Offsets of the chunk. The last instruction of the chunk can extend
+  // beyond `end`, in which case `sweep_end` will be greater than `end`.
+  uint64_t begin{0};
+  uint64_t end{0};
+  uint64_t sweep_end{0};
+
+  std::vector<InstructionIndex::Entry> entries;
+};
+
+// Decode the control flow of the instruction at `offset`, and on success,
+// add an entry for it to `entries`. Returns the offset at which to decode the
+// next instruction.
+static uint64_t SweepOne(const Arch *arch, uint64_t base_address,
+                         std::string_view bytes, uint64_t offset,
+                         std::vector<InstructionIndex::Entry> &entries) {
+  const auto max_size = arch->MaxInstructionSize();
+  const auto align = std::max<uint64_t>(1u, arch->MinInstructionAlign());
+
+  ControlFlowInfo info;
+  if (!arch->DecodeControlFlow(base_address + offset,
+                               bytes.substr(offset, max_size), info) ||
+      Instruction::kCategoryInvalid == info.category || !info.size) {
+    return offset + align;
+  }
+
+  CHECK_LE(info.size, std::numeric_limits<uint8_t>::max());
+
+  auto &entry = entries.emplace_back();
+  entry.branch_taken_pc = info.branch_taken_pc;
+  entry.branch_not_taken_pc = info.branch_not_taken_pc;
+  entry.offset = static_cast<uint32_t>(offset);
+  entry.size = static_cast<uint8_t>(info.size);
+  entry.category = static_cast<uint8_t>(info.category);
+  entry.has_delay_slot = info.has_delay_slot;
+
+  return offset + info.size;
+}
+
+// Linear sweep a single chunk.
+static void SweepChunkBytes(const Arch *arch, uint64_t base_address,
+                            std::string_view bytes, SweepChunk &chunk) {
+  auto offset = chunk.begin;
+  while (offset < chunk.end) {
+    offset = SweepOne(arch, base_address, bytes, offset, chunk.entries);
+  }
+  chunk.sweep_end = offset;
+}
+
+}  // namespace
+
+InstructionIndex::InstructionIndex(ArchName arch_name_, uint64_t base_address_,
+                                   std::string bytes_)
+    : arch_name(arch_name_),
+      base_address(base_address_),
+      bytes(std::move(bytes_)) {}
+
+// Linear sweep `bytes`, starting at `base_address`, using `num_threads`
+// decoder threads.
+std::unique_ptr<InstructionIndex>
+InstructionIndex::Build(OSName os_name, ArchName arch_name,
+                        uint64_t base_address, std::string bytes,
+                        unsigned num_threads, uint64_t min_chunk_size) {
+  if (bytes.size() > std::numeric_limits<uint32_t>::max()) {
+    LOG(ERROR) << "Cannot index more than 4 GiB of bytes at once";
+    return {};
+  }
+
+  // The first decoder is built on this thread. Some decoders (e.g. XED) have
+  // global tables that are not safe to initialize concurrently.
+  std::vector<std::unique_ptr<SweepDecoder>> decoders;
+  decoders.emplace_back(new SweepDecoder(os_name, arch_name));
+  if (!decoders[0]->IsValid()) {
+    LOG(ERROR) << "Unable to build a decoder for architecture "
+               << GetArchName(arch_name);
+    return {};
+  }
+
+  const auto arch = decoders[0]->arch.get();
+  const auto align = std::max<uint64_t>(1u, arch->MinInstructionAlign());
+
+  // Split the bytes into at most one chunk per thread, where every chunk
+  // starts on an instruction alignment boundary.
+  if (!num_threads) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  uint64_t chunk_size =
+      std::max<uint64_t>({1u, min_chunk_size,
+                          (bytes.size() + num_threads - 1u) / num_threads});
+  chunk_size = (chunk_size + align - 1u) / align * align;
+
+  std::vector<SweepChunk> chunks;
+  for (uint64_t begin = 0; begin < bytes.size(); begin += chunk_size) {
+    auto &chunk = chunks.emplace_back();
+    chunk.begin = begin;
+    chunk.end = std::min<uint64_t>(begin + chunk_size, bytes.size());
+  }
+
+  decoders.resize(std::max<size_t>(1u, chunks.size()));
+
+  const std::string_view bytes_view = bytes;
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < chunks.size(); ++i) {
+    threads.emplace_back([=, &decoders, &chunks](void) {
+      decoders[i].reset(new SweepDecoder(os_name, arch_name));
+      if (decoders[i]->IsValid()) {
+        SweepChunkBytes(decoders[i]->arch.get(), base_address, bytes_view,
+                        chunks[i]);
+      } else {
+        chunks[i].sweep_end = chunks[i].begin;  // Re-swept when stitching.
+      }
+    });
+  }
+
+  if (!chunks.empty()) {
+    SweepChunkBytes(arch, base_address, bytes_view, chunks[0]);
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::unique_ptr<InstructionIndex> index(
+      new InstructionIndex(arch_name, base_address, std::move(bytes)));
+
+  // Stitch the chunks together. A chunk's sweep can start in the middle of
+  // an instruction from the previous chunk, so re-sweep from where the
+  // previous chunk's sweep ended, until we land on an instruction that this
+  // chunk's sweep also found. From there on, both sweeps agree. With fixed-
+  // size instructions, the sweeps always agree immediately.
+  uint64_t sweep_end = 0;
+  for (const auto &chunk : chunks) {
+    auto offset = sweep_end;
+    auto it = std::lower_bound(
+        chunk.entries.begin(), chunk.entries.end(), offset,
+        [](const Entry &entry, uint64_t off) { return entry.offset < off; });
+
+    while (offset < chunk.end) {
+      if (it != chunk.entries.end() && it->offset == offset) {
+        break;
+      }
+
+      offset = SweepOne(arch, base_address, index->bytes, offset,
+                        index->entries);
+      while (it != chunk.entries.end() && it->offset < offset) {
+        ++it;
+      }
+    }
+
+    if (offset < chunk.end) {
+      index->entries.insert(index->entries.end(), it, chunk.entries.end());
+      sweep_end = chunk.sweep_end;
+    } else {
+      sweep_end = offset;
+    }
+  }
+
+  DLOG(INFO) << "Indexed " << index->entries.size() << " instructions in "
+             << index->bytes.size() << " bytes using " << chunks.size()
+             << " chunks";
+
+  return index;
+}
+
+// Returns the entry of the instruction starting at `address`.
+const InstructionIndex::Entry *
+InstructionIndex::Find(uint64_t address) const {
+  if (!Contains(address)) {
+    return nullptr;
+  }
+
+  const auto offset = address - base_address;
+  auto it = std::lower_bound(
+      entries.begin(), entries.end(), offset,
+      [](const Entry &entry, uint64_t off) { return entry.offset < off; });
+  if (it != entries.end() && it->offset == offset) {
+    return &*it;
+  }
+  return nullptr;
+}
+
+// Returns up to `max_size` indexed bytes starting at `address`.
+std::string_view InstructionIndex::BytesAt(uint64_t address,
+                                           size_t max_size) const {
+  if (!Contains(address)) {
+    return {};
+  }
+  return std::string_view(bytes).substr(address - base_address, max_size);
+}
+
+// Fully decode the instruction of `entry` into `inst`, using `arch`.
+bool InstructionIndex::Materialize(const Arch *arch, const Entry &entry,
+                                   Instruction &inst) const {
+  CHECK_EQ(arch->arch_name, arch_name);
+  inst.Reset();
+
+  // Decode with the same number of bytes as the sweep did, so that the same
+  // idioms are fused.
+  const auto address = base_address + entry.offset;
+  return arch->DecodeInstruction(
+      address, BytesAt(address, arch->MaxInstructionSize()), inst);
+}
+
+}  // namespace remill
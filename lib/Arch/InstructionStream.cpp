@@ -0,0 +1,633 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "remill/Arch/InstructionStream.h"
+
+#include <glog/logging.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include "remill/Arch/Arch.h"
+#include "remill/Arch/Instruction.h"
+#include "remill/Arch/Name.h"
+
+namespace remill {
+namespace {
+
+// Bump this whenever any of the record layouts below change.
+static constexpr uint32_t kStreamVersion = 1;
+static constexpr char kStreamMagic[8] = {'R', 'E', 'M', 'I',
+                                         'L', 'L', 'I', 'S'};
+static constexpr uint32_t kByteOrderMark = 0x01020304u;
+
+static constexpr uint32_t kNoString = std::numeric_limits<uint32_t>::max();
+static constexpr uint8_t kNoExpr = std::numeric_limits<uint8_t>::max();
+
+// Same as `Instruction::kMaxNumExpr`.
+static constexpr unsigned kMaxNumExpr = 64u;
+
+// All records are plain old data, are a multiple of 8 bytes in size, and are
+// stored at 8-byte aligned offsets in the file.
+struct StreamHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t arch_name;
+  uint32_t num_strings;
+  uint64_t num_insts;
+
+  // Offset of the `uint64_t` offsets of the instruction records.
+  uint64_t inst_offsets_offset;
+
+  // Offset of the `StringRecord`s. The string data follows the records.
+  uint64_t strings_offset;
+};
+
+struct StringRecord {
+  uint32_t offset;  // Relative to the end of the string records.
+  uint32_t size;
+};
+
+struct InstRecord {
+  uint64_t pc;
+  uint64_t next_pc;
+  uint64_t delayed_pc;
+  uint64_t branch_taken_pc;
+  uint64_t branch_not_taken_pc;
+  uint32_t function;
+  uint32_t sub_arch_name;
+  uint32_t segment_override;
+  uint8_t category;
+  uint8_t flags;
+  uint8_t num_bytes;
+  uint8_t num_exprs;
+  uint16_t num_operands;
+  uint8_t padding[6];
+};
+
+// Bits of `InstRecord::flags`.
+static constexpr uint8_t kInstAtomicReadModifyWrite = 1u << 0;
+static constexpr uint8_t kInstBranchTakenDelaySlot = 1u << 1;
+static constexpr uint8_t kInstBranchNotTakenDelaySlot = 1u << 2;
+static constexpr uint8_t kInstInDelaySlot = 1u << 3;
+
+// An `OperandExpression`. Expressions are stored in post-order, so operands
+// of an expression always come before it.
+struct ExprRecord {
+  enum Kind : uint8_t {
+    kRegister,  // `name` is the register name.
+    kConstant,  // `value` is a `bits`-bit integer.
+    kVariable,  // `name` is the variable name, of a `bits`-bit integer type.
+    kUnaryOp,  // `opcode` cast of `op1` to a `bits`-bit integer type.
+    kBinaryOp,  // `opcode` applied to `op1` and `op2`.
+  };
+
+  uint64_t value;
+  uint32_t name_or_opcode;
+  uint16_t bits;
+  uint8_t kind;
+  uint8_t op1;
+  uint8_t op2;
+  uint8_t padding[7];
+};
+
+struct RegisterRecord {
+  uint64_t size;
+  uint32_t name;
+  uint32_t padding;
+};
+
+struct OperandRecord {
+  uint64_t size;
+  RegisterRecord reg;
+  RegisterRecord shift_reg;
+  uint64_t shift_size;
+  uint64_t extract_size;
+  uint64_t imm_val;
+  RegisterRecord segment_base_reg;
+  RegisterRecord base_reg;
+  RegisterRecord index_reg;
+  int64_t scale;
+  int64_t displacement;
+  uint64_t address_size;
+  uint8_t type;
+  uint8_t action;
+  uint8_t shift_op;
+  uint8_t extend_op;
+  uint8_t addr_kind;
+  uint8_t flags;
+  uint8_t expr;
+  uint8_t padding;
+};
+
+// Bits of `OperandRecord::flags`.
+static constexpr uint8_t kOperandShiftFirst = 1u << 0;
+static constexpr uint8_t kOperandCanShiftOpSize = 1u << 1;
+static constexpr uint8_t kOperandImmIsSigned = 1u << 2;
+
+static_assert(sizeof(StreamHeader) % 8 == 0);
+static_assert(sizeof(InstRecord) % 8 == 0);
+static_assert(sizeof(ExprRecord) % 8 == 0);
+static_assert(sizeof(OperandRecord) % 8 == 0);
+
+template <typename T>
+static void AppendRecord(std::string &out, const T &record) {
+  out.append(reinterpret_cast<const char *>(&record), sizeof(T));
+}
+
+static void AlignTo8(std::string &out) {
+  out.resize((out.size() + 7u) & ~size_t(7u), '\0');
+}
+
+// Copy a record out of the mapped file. This tolerates any alignment of the
+// mapping, and compiles down to plain loads.
+template <typename T>
+static bool ReadRecord(std::string_view data, uint64_t offset, T &record) {
+  if (offset > data.size() || (data.size() - offset) < sizeof(T)) {
+    return false;
+  }
+  memcpy(&record, data.data() + offset, sizeof(T));
+  return true;
+}
+
+// Returns the bit width of `type`, or zero if `type` isn't an integer type
+// that we can serialize.
+static uint16_t IntegerTypeBits(llvm::Type *type) {
+  auto int_type = llvm::dyn_cast_or_null<llvm::IntegerType>(type);
+  if (!int_type || int_type->getBitWidth() > 64) {
+    return 0;
+  }
+  return static_cast<uint16_t>(int_type->getBitWidth());
+}
+
+}  // namespace
+
+InstructionStreamWriter::InstructionStreamWriter(ArchName arch_name_)
+    : arch_name(arch_name_) {}
+
+InstructionStreamWriter::~InstructionStreamWriter(void) {}
+
+uint32_t InstructionStreamWriter::Intern(std::string_view str) {
+  auto [it, added] = string_ids.emplace(
+      std::string(str), static_cast<uint32_t>(strings.size()));
+  if (added) {
+    strings.emplace_back(str);
+  }
+  return it->second;
+}
+
+// Append `inst` to the stream.
+bool InstructionStreamWriter::Add(const Instruction &inst) {
+  if (inst.arch_name != arch_name) {
+    LOG(ERROR) << "Cannot add " << GetArchName(inst.arch_name)
+               << " instruction at " << std::hex << inst.pc << std::dec
+               << " to " << GetArchName(arch_name) << " instruction stream";
+    return false;
+  }
+
+  if (inst.bytes.size() > std::numeric_limits<uint8_t>::max() ||
+      inst.operands.size() > std::numeric_limits<uint16_t>::max()) {
+    LOG(ERROR) << "Instruction at " << std::hex << inst.pc << std::dec
+               << " is too big to serialize";
+    return false;
+  }
+
+  // Flatten the operand expression trees, in post-order.
+  std::vector<ExprRecord> exprs;
+  std::unordered_map<const OperandExpression *, uint8_t> expr_ids;
+
+  auto add_expr = [&](const OperandExpression *expr, auto &add_expr_) -> bool {
+    if (expr_ids.count(expr)) {
+      return true;
+    }
+
+    ExprRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.op1 = kNoExpr;
+    rec.op2 = kNoExpr;
+
+    if (auto llvm_op = std::get_if<LLVMOpExpr>(expr)) {
+      if (!add_expr_(llvm_op->op1, add_expr_)) {
+        return false;
+      }
+      rec.name_or_opcode = llvm_op->llvm_opcode;
+      rec.op1 = expr_ids[llvm_op->op1];
+      if (llvm_op->op2) {
+        if (!add_expr_(llvm_op->op2, add_expr_)) {
+          return false;
+        }
+        rec.kind = ExprRecord::kBinaryOp;
+        rec.op2 = expr_ids[llvm_op->op2];
+      } else {
+        rec.kind = ExprRecord::kUnaryOp;
+        rec.bits = IntegerTypeBits(expr->type);
+        if (!rec.bits) {
+          return false;
+        }
+      }
+
+    } else if (auto reg_op = std::get_if<const Register *>(expr)) {
+      rec.kind = ExprRecord::kRegister;
+      rec.name_or_opcode = Intern((*reg_op)->name);
+
+    } else if (auto const_op = std::get_if<llvm::Constant *>(expr)) {
+      auto ci = llvm::dyn_cast<llvm::ConstantInt>(*const_op);
+      rec.kind = ExprRecord::kConstant;
+      rec.bits = IntegerTypeBits((*const_op)->getType());
+      if (!ci || !rec.bits) {
+        return false;
+      }
+      rec.value = ci->getZExtValue();
+
+    } else if (auto var_op = std::get_if<std::string>(expr)) {
+      rec.kind = ExprRecord::kVariable;
+      rec.name_or_opcode = Intern(*var_op);
+      rec.bits = IntegerTypeBits(expr->type);
+      if (!rec.bits) {
+        return false;
+      }
+
+    } else {
+      return false;
+    }
+
+    if (exprs.size() >= kMaxNumExpr) {
+      return false;
+    }
+
+    expr_ids.emplace(expr, static_cast<uint8_t>(exprs.size()));
+    exprs.push_back(rec);
+    return true;
+  };
+
+  for (const auto &op : inst.operands) {
+    if (op.expr && !add_expr(op.expr, add_expr)) {
+      LOG(ERROR) << "Cannot serialize operand " << op.Serialize()
+                 << " of instruction at " << std::hex << inst.pc << std::dec;
+      return false;
+    }
+  }
+
+  auto intern_reg = [&](const Operand::Register &reg) {
+    RegisterRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.size = reg.size;
+    rec.name = reg.name.empty() ? kNoString : Intern(reg.name);
+    return rec;
+  };
+
+  InstRecord rec;
+  memset(&rec, 0, sizeof(rec));
+  rec.pc = inst.pc;
+  rec.next_pc = inst.next_pc;
+  rec.delayed_pc = inst.delayed_pc;
+  rec.branch_taken_pc = inst.branch_taken_pc;
+  rec.branch_not_taken_pc = inst.branch_not_taken_pc;
+  rec.function = Intern(inst.function);
+  rec.sub_arch_name = static_cast<uint32_t>(inst.sub_arch_name);
+  rec.segment_override =
+      inst.segment_override ? Intern(inst.segment_override->name) : kNoString;
+  rec.category = static_cast<uint8_t>(inst.category);
+  rec.flags = (inst.is_atomic_read_modify_write ? kInstAtomicReadModifyWrite
+                                                : 0u) |
+              (inst.has_branch_taken_delay_slot ? kInstBranchTakenDelaySlot
+                                                : 0u) |
+              (inst.has_branch_not_taken_delay_slot
+                   ? kInstBranchNotTakenDelaySlot
+                   : 0u) |
+              (inst.in_delay_slot ? kInstInDelaySlot : 0u);
+  rec.num_bytes = static_cast<uint8_t>(inst.bytes.size());
+  rec.num_exprs = static_cast<uint8_t>(exprs.size());
+  rec.num_operands = static_cast<uint16_t>(inst.operands.size());
+
+  inst_offsets.push_back(records.size());
+  AppendRecord(records, rec);
+
+  for (const auto &expr : exprs) {
+    AppendRecord(records, expr);
+  }
+
+  for (const auto &op : inst.operands) {
+    OperandRecord op_rec;
+    memset(&op_rec, 0, sizeof(op_rec));
+    op_rec.size = op.size;
+    op_rec.reg = intern_reg(op.reg);
+    op_rec.shift_reg = intern_reg(op.shift_reg.reg);
+    op_rec.shift_size = op.shift_reg.shift_size;
+    op_rec.extract_size = op.shift_reg.extract_size;
+    op_rec.imm_val = op.imm.val;
+    op_rec.segment_base_reg = intern_reg(op.addr.segment_base_reg);
+    op_rec.base_reg = intern_reg(op.addr.base_reg);
+    op_rec.index_reg = intern_reg(op.addr.index_reg);
+    op_rec.scale = op.addr.scale;
+    op_rec.displacement = op.addr.displacement;
+    op_rec.address_size = op.addr.address_size;
+    op_rec.type = static_cast<uint8_t>(op.type);
+    op_rec.action = static_cast<uint8_t>(op.action);
+    op_rec.shift_op = static_cast<uint8_t>(op.shift_reg.shift_op);
+    op_rec.extend_op = static_cast<uint8_t>(op.shift_reg.extend_op);
+    op_rec.addr_kind = static_cast<uint8_t>(op.addr.kind);
+    op_rec.flags =
+        (op.shift_reg.shift_first ? kOperandShiftFirst : 0u) |
+        (op.shift_reg.can_shift_op_size ? kOperandCanShiftOpSize : 0u) |
+        (op.imm.is_signed ? kOperandImmIsSigned : 0u);
+    op_rec.expr = op.expr ? expr_ids[op.expr] : kNoExpr;
+    AppendRecord(records, op_rec);
+  }
+
+  records.append(inst.bytes);
+  AlignTo8(records);
+  return true;
+}
+
+// Write out the stream to `file_name`.
+bool InstructionStreamWriter::WriteToFile(
+    const std::filesystem::path &file_name) const {
+  std::string out;
+
+  StreamHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kStreamMagic, sizeof(kStreamMagic));
+  header.version = kStreamVersion;
+  header.byte_order = kByteOrderMark;
+  header.arch_name = static_cast<uint32_t>(arch_name);
+  header.num_strings = static_cast<uint32_t>(strings.size());
+  header.num_insts = inst_offsets.size();
+  header.inst_offsets_offset = sizeof(header) + records.size();
+  header.strings_offset =
+      header.inst_offsets_offset + inst_offsets.size() * sizeof(uint64_t);
+
+  AppendRecord(out, header);
+  out.append(records);
+
+  for (auto offset : inst_offsets) {
+    AppendRecord(out, static_cast<uint64_t>(sizeof(header) + offset));
+  }
+
+  uint32_t string_offset = 0;
+  for (const auto &str : strings) {
+    StringRecord rec = {string_offset, static_cast<uint32_t>(str.size())};
+    AppendRecord(out, rec);
+    string_offset += rec.size;
+  }
+  for (const auto &str : strings) {
+    out.append(str);
+  }
+
+  std::ofstream os(file_name, std::ios::binary | std::ios::trunc);
+  if (!os || !os.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+    LOG(ERROR) << "Unable to write instruction stream to " << file_name;
+    return false;
+  }
+  return true;
+}
+
+InstructionStream::~InstructionStream(void) {}
+
+// Map in the instruction stream in `file_name`.
+std::unique_ptr<InstructionStream>
+InstructionStream::Open(const std::filesystem::path &file_name) {
+  auto buff = llvm::MemoryBuffer::getFile(
+      file_name.string(), false /* IsText */,
+      false /* RequiresNullTerminator */);
+  if (!buff) {
+    LOG(ERROR) << "Unable to read instruction stream " << file_name << ": "
+               << buff.getError().message();
+    return {};
+  }
+
+  std::unique_ptr<InstructionStream> stream(new InstructionStream);
+  stream->buffer = std::move(*buff);
+  stream->data = std::string_view(stream->buffer->getBufferStart(),
+                                  stream->buffer->getBufferSize());
+
+  StreamHeader header;
+  if (!ReadRecord(stream->data, 0, header) ||
+      memcmp(header.magic, kStreamMagic, sizeof(kStreamMagic))) {
+    LOG(ERROR) << "File " << file_name << " is not an instruction stream";
+    return {};
+  }
+
+  if (header.version != kStreamVersion ||
+      header.byte_order != kByteOrderMark) {
+    LOG(ERROR) << "Instruction stream " << file_name
+               << " was written by an incompatible version of remill";
+    return {};
+  }
+
+  const auto size = stream->data.size();
+  if (header.inst_offsets_offset > size ||
+      header.num_insts > (size - header.inst_offsets_offset) / 8u ||
+      header.strings_offset > size ||
+      header.num_strings > (size - header.strings_offset) / 8u) {
+    LOG(ERROR) << "Instruction stream " << file_name << " is truncated";
+    return {};
+  }
+
+  stream->arch_name = static_cast<ArchName>(header.arch_name);
+  stream->num_insts = header.num_insts;
+  stream->num_strings = header.num_strings;
+  stream->inst_offsets_offset = header.inst_offsets_offset;
+  stream->strings_offset = header.strings_offset;
+
+  // The string data is at the end of the file, and the last string ends
+  // where the data ends.
+  StringRecord last_string = {0, 0};
+  if (header.num_strings &&
+      !ReadRecord(stream->data,
+                  header.strings_offset +
+                      (header.num_strings - 1u) * sizeof(StringRecord),
+                  last_string)) {
+    LOG(ERROR) << "Instruction stream " << file_name << " is truncated";
+    return {};
+  }
+
+  const auto chars_offset =
+      header.strings_offset + header.num_strings * sizeof(StringRecord);
+  if (uint64_t(last_string.offset) + last_string.size != size - chars_offset) {
+    LOG(ERROR) << "Instruction stream " << file_name << " is truncated";
+    return {};
+  }
+
+  return stream;
+}
+
+std::string_view InstructionStream::String(uint32_t id) const {
+  StringRecord rec;
+  if (id >= num_strings ||
+      !ReadRecord(data, strings_offset + id * sizeof(StringRecord), rec)) {
+    return {};
+  }
+  const auto chars_offset = strings_offset + num_strings * sizeof(rec);
+  const auto chars = data.substr(std::min<uint64_t>(chars_offset, data.size()));
+  if (rec.offset > chars.size()) {
+    return {};
+  }
+  return chars.substr(rec.offset, rec.size);
+}
+
+// Returns the address of the `i`th instruction.
+uint64_t InstructionStream::Address(size_t i) const {
+  uint64_t offset = 0;
+  InstRecord rec;
+  CHECK_LT(i, num_insts);
+  CHECK(ReadRecord(data, inst_offsets_offset + i * sizeof(offset), offset) &&
+        ReadRecord(data, offset, rec));
+  return rec.pc;
+}
+
+// Materialize the `i`th instruction into `inst`.
+bool InstructionStream::Read(size_t i, const Arch *arch,
+                             Instruction &inst) const {
+  CHECK_EQ(arch->arch_name, arch_name);
+  inst.Reset();
+
+  uint64_t offset = 0;
+  InstRecord rec;
+  if (i >= num_insts ||
+      !ReadRecord(data, inst_offsets_offset + i * sizeof(offset), offset) ||
+      !ReadRecord(data, offset, rec) || rec.num_exprs > kMaxNumExpr) {
+    return false;
+  }
+  offset += sizeof(rec);
+
+  inst.pc = rec.pc;
+  inst.next_pc = rec.next_pc;
+  inst.delayed_pc = rec.delayed_pc;
+  inst.branch_taken_pc = rec.branch_taken_pc;
+  inst.branch_not_taken_pc = rec.branch_not_taken_pc;
+  inst.arch_name = arch_name;
+  inst.sub_arch_name = static_cast<ArchName>(rec.sub_arch_name);
+  inst.arch = arch;
+  inst.function = String(rec.function);
+  inst.category = static_cast<Instruction::Category>(rec.category);
+  inst.is_atomic_read_modify_write = rec.flags & kInstAtomicReadModifyWrite;
+  inst.has_branch_taken_delay_slot = rec.flags & kInstBranchTakenDelaySlot;
+  inst.has_branch_not_taken_delay_slot =
+      rec.flags & kInstBranchNotTakenDelaySlot;
+  inst.in_delay_slot = rec.flags & kInstInDelaySlot;
+  if (rec.segment_override != kNoString) {
+    inst.segment_override = arch->RegisterByName(String(rec.segment_override));
+  }
+
+  auto int_type = [=](unsigned bits) {
+    return llvm::Type::getIntNTy(*arch->context, bits);
+  };
+
+  // Re-create the expressions. They are in post-order, so operands always
+  // refer to expressions that we've already made.
+  OperandExpression *exprs[kMaxNumExpr] = {};
+  for (unsigned e = 0; e < rec.num_exprs; ++e, offset += sizeof(ExprRecord)) {
+    ExprRecord expr;
+    if (!ReadRecord(data, offset, expr)) {
+      return false;
+    }
+
+    const bool ops_ok = expr.op1 < e && (expr.kind != ExprRecord::kBinaryOp ||
+                                         expr.op2 < e);
+    switch (expr.kind) {
+      case ExprRecord::kRegister:
+        if (auto reg = arch->RegisterByName(String(expr.name_or_opcode))) {
+          exprs[e] = inst.EmplaceRegister(reg);
+        } else {
+          LOG(ERROR) << "Unknown register "
+                     << String(expr.name_or_opcode)
+                     << " in instruction stream";
+          return false;
+        }
+        break;
+      case ExprRecord::kConstant:
+        exprs[e] = inst.EmplaceConstant(
+            llvm::ConstantInt::get(int_type(expr.bits), expr.value));
+        break;
+      case ExprRecord::kVariable:
+        exprs[e] = inst.EmplaceVariable(String(expr.name_or_opcode),
+                                        int_type(expr.bits));
+        break;
+      case ExprRecord::kUnaryOp:
+        if (!ops_ok) {
+          return false;
+        }
+        exprs[e] = inst.EmplaceUnaryOp(expr.name_or_opcode, exprs[expr.op1],
+                                       int_type(expr.bits));
+        break;
+      case ExprRecord::kBinaryOp:
+        if (!ops_ok) {
+          return false;
+        }
+        exprs[e] = inst.EmplaceBinaryOp(expr.name_or_opcode, exprs[expr.op1],
+                                        exprs[expr.op2]);
+        break;
+      default: return false;
+    }
+  }
+
+  auto read_reg = [=](const RegisterRecord &reg_rec, Operand::Register &reg) {
+    reg.size = reg_rec.size;
+    if (reg_rec.name != kNoString) {
+      reg.name = String(reg_rec.name);
+    }
+  };
+
+  inst.operands.reserve(rec.num_operands);
+  for (unsigned o = 0; o < rec.num_operands;
+       ++o, offset += sizeof(OperandRecord)) {
+    OperandRecord op_rec;
+    if (!ReadRecord(data, offset, op_rec) ||
+        (op_rec.expr != kNoExpr && op_rec.expr >= rec.num_exprs)) {
+      return false;
+    }
+
+    auto &op = inst.operands.emplace_back();
+    op.type = static_cast<Operand::Type>(op_rec.type);
+    op.action = static_cast<Operand::Action>(op_rec.action);
+    op.size = op_rec.size;
+    read_reg(op_rec.reg, op.reg);
+    read_reg(op_rec.shift_reg, op.shift_reg.reg);
+    op.shift_reg.shift_size = op_rec.shift_size;
+    op.shift_reg.extract_size = op_rec.extract_size;
+    op.shift_reg.shift_first = op_rec.flags & kOperandShiftFirst;
+    op.shift_reg.can_shift_op_size = op_rec.flags & kOperandCanShiftOpSize;
+    op.shift_reg.shift_op =
+        static_cast<Operand::ShiftRegister::Shift>(op_rec.shift_op);
+    op.shift_reg.extend_op =
+        static_cast<Operand::ShiftRegister::Extend>(op_rec.extend_op);
+    op.imm.val = op_rec.imm_val;
+    op.imm.is_signed = op_rec.flags & kOperandImmIsSigned;
+    read_reg(op_rec.segment_base_reg, op.addr.segment_base_reg);
+    read_reg(op_rec.base_reg, op.addr.base_reg);
+    read_reg(op_rec.index_reg, op.addr.index_reg);
+    op.addr.scale = op_rec.scale;
+    op.addr.displacement = op_rec.displacement;
+    op.addr.address_size = op_rec.address_size;
+    op.addr.kind = static_cast<Operand::Address::Kind>(op_rec.addr_kind);
+    op.expr = op_rec.expr != kNoExpr ? exprs[op_rec.expr] : nullptr;
+  }
+
+  const auto bytes = data.substr(std::min<uint64_t>(offset, data.size()));
+  if (bytes.size() < rec.num_bytes) {
+    return false;
+  }
+  inst.bytes = bytes.substr(0, rec.num_bytes);
+  return true;
+}
+
+}  // namespace remill
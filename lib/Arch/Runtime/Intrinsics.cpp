@@ -51,6 +51,13 @@ extern "C" void __remill_mark_as_used(const void *);
   USED(__remill_write_memory_f80);
   USED(__remill_write_memory_f128);
 
+  USED(__remill_memory_copy);
+  USED(__remill_memory_fill_8);
+  USED(__remill_memory_fill_16);
+  USED(__remill_memory_fill_32);
+  USED(__remill_memory_fill_64);
+  USED(__remill_memory_compare);
+
   USED(__remill_barrier_load_load);
   USED(__remill_barrier_load_store);
   USED(__remill_barrier_store_load);
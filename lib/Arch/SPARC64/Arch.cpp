@@ -83,6 +83,15 @@ class SPARC64Arch final : public Arch {
   void FinishLiftedFunctionInitialization(
       llvm::Module *module, llvm::Function *bb_func) const override;
 
+#if defined(REMILL_SPARC_WINDOW_RING)
+
+  // Returns the address of `reg` in the current register window if it is one
+  // of the `%i`, `%l`, or `%o` registers.
+  llvm::Value *WindowedRegisterAddress(llvm::BasicBlock *block,
+                                       llvm::Value *state_ptr,
+                                       const Register *reg) const final;
+#endif
+
   llvm::Triple Triple(void) const final;
   llvm::DataLayout DataLayout(void) const final;
 
@@ -347,6 +356,52 @@ void SPARC64Arch::PopulateRegisterTable(void) const {
   REG(PREV_WINDOW_LINK, window, window_ptr_type);
 }
 
+#if defined(REMILL_SPARC_WINDOW_RING)
+
+// Returns the address of `reg` in the current register window if it is one of
+// the `%i`, `%l`, or `%o` registers. These live in `State::window_regs`, in the
+// same order as in `GPR`, starting at slot `CWP * 16`.
+llvm::Value *SPARC64Arch::WindowedRegisterAddress(llvm::BasicBlock *block,
+                                                  llvm::Value *state_ptr,
+                                                  const Register *reg) const {
+  const uint64_t first_reg = OFFSET_OF(SPARC64State, gpr.i0);
+  const uint64_t last_reg = OFFSET_OF(SPARC64State, gpr.o7);
+  const uint64_t stride = OFFSET_OF(SPARC64State, gpr.i1) - first_reg;
+  if (reg->offset < first_reg || reg->offset >= (last_reg + sizeof(Reg))) {
+    return nullptr;
+  }
+
+  const auto index = (reg->offset - first_reg) / stride;
+  const auto offset_in_reg = (reg->offset - first_reg) % stride;
+  CHECK_LT(offset_in_reg, sizeof(Reg))
+      << "Register " << reg->name << " is in the padding of the GPRs";
+
+  llvm::IRBuilder<> ir(block);
+  const auto u8 = llvm::Type::getInt8Ty(*context);
+  const auto addr_type = AddressType();
+  const auto state_bytes =
+      ir.CreateBitCast(state_ptr, llvm::PointerType::get(u8, 0));
+
+  const auto cwp_ptr = ir.CreateConstInBoundsGEP1_64(
+      u8, state_bytes, OFFSET_OF(SPARC64State, psr.cwp));
+  const auto cwp = ir.CreateZExt(ir.CreateLoad(u8, cwp_ptr), addr_type);
+
+  const auto slot = ir.CreateURem(
+      ir.CreateAdd(ir.CreateMul(cwp, llvm::ConstantInt::get(addr_type, 16)),
+                   llvm::ConstantInt::get(addr_type, index)),
+      llvm::ConstantInt::get(addr_type, kNumWindowedRegisters));
+
+  const auto offset = ir.CreateAdd(
+      ir.CreateMul(slot, llvm::ConstantInt::get(addr_type, sizeof(Reg))),
+      llvm::ConstantInt::get(
+          addr_type,
+          OFFSET_OF(SPARC64State, window_regs) + offset_in_reg));
+
+  const auto reg_ptr = ir.CreateInBoundsGEP(u8, state_bytes, offset);
+  return ir.CreateBitCast(reg_ptr, llvm::PointerType::get(reg->type, 0));
+}
+#endif  // defined(REMILL_SPARC_WINDOW_RING)
+
 // Populate a just-initialized lifted function function with architecture-
 // specific variables.
 void SPARC64Arch::FinishLiftedFunctionInitialization(
@@ -26,39 +26,79 @@
 
 #define REG_PC state.pc.aword
 #define REG_NPC state.next_pc.aword
-#define REG_SP state.gpr.o6.aword
-#define REG_FP state.gpr.i6.aword
 
 #define REG_G0 state.gpr.g0.aword
 #define REG_G1 state.gpr.g1.aword
 #define REG_G7 state.gpr.g7.aword  // Thread local pointer
 
-#define REG_L0 state.gpr.l0.aword
-#define REG_L1 state.gpr.l1.aword
-#define REG_L2 state.gpr.l2.aword
-#define REG_L3 state.gpr.l3.aword
-#define REG_L4 state.gpr.l4.aword
-#define REG_L5 state.gpr.l5.aword
-#define REG_L6 state.gpr.l6.aword
-#define REG_L7 state.gpr.l7.aword
-
-#define REG_I0 state.gpr.i0.aword
-#define REG_I1 state.gpr.i1.aword
-#define REG_I2 state.gpr.i2.aword
-#define REG_I3 state.gpr.i3.aword
-#define REG_I4 state.gpr.i4.aword
-#define REG_I5 state.gpr.i5.aword
-#define REG_I6 state.gpr.i6.aword
-#define REG_I7 state.gpr.i7.aword
-
-#define REG_O0 state.gpr.o0.aword
-#define REG_O1 state.gpr.o1.aword
-#define REG_O2 state.gpr.o2.aword
-#define REG_O3 state.gpr.o3.aword
-#define REG_O4 state.gpr.o4.aword
-#define REG_O5 state.gpr.o5.aword
-#define REG_O6 state.gpr.o6.aword
-#define REG_O7 state.gpr.o7.aword
+#if defined(REMILL_SPARC_WINDOW_RING)
+
+// The `%i`, `%l`, and `%o` registers of the current window. See
+// `State::window_regs`.
+#  define WINDOW_REG(n) \
+    state.window_regs[(PSR_CWP * 16u + (n)) % kNumWindowedRegisters].aword
+
+#  define REG_SP WINDOW_REG(22)
+#  define REG_FP WINDOW_REG(6)
+
+#  define REG_L0 WINDOW_REG(8)
+#  define REG_L1 WINDOW_REG(9)
+#  define REG_L2 WINDOW_REG(10)
+#  define REG_L3 WINDOW_REG(11)
+#  define REG_L4 WINDOW_REG(12)
+#  define REG_L5 WINDOW_REG(13)
+#  define REG_L6 WINDOW_REG(14)
+#  define REG_L7 WINDOW_REG(15)
+
+#  define REG_I0 WINDOW_REG(0)
+#  define REG_I1 WINDOW_REG(1)
+#  define REG_I2 WINDOW_REG(2)
+#  define REG_I3 WINDOW_REG(3)
+#  define REG_I4 WINDOW_REG(4)
+#  define REG_I5 WINDOW_REG(5)
+#  define REG_I6 WINDOW_REG(6)
+#  define REG_I7 WINDOW_REG(7)
+
+#  define REG_O0 WINDOW_REG(16)
+#  define REG_O1 WINDOW_REG(17)
+#  define REG_O2 WINDOW_REG(18)
+#  define REG_O3 WINDOW_REG(19)
+#  define REG_O4 WINDOW_REG(20)
+#  define REG_O5 WINDOW_REG(21)
+#  define REG_O6 WINDOW_REG(22)
+#  define REG_O7 WINDOW_REG(23)
+#else
+
+#  define REG_SP state.gpr.o6.aword
+#  define REG_FP state.gpr.i6.aword
+
+#  define REG_L0 state.gpr.l0.aword
+#  define REG_L1 state.gpr.l1.aword
+#  define REG_L2 state.gpr.l2.aword
+#  define REG_L3 state.gpr.l3.aword
+#  define REG_L4 state.gpr.l4.aword
+#  define REG_L5 state.gpr.l5.aword
+#  define REG_L6 state.gpr.l6.aword
+#  define REG_L7 state.gpr.l7.aword
+
+#  define REG_I0 state.gpr.i0.aword
+#  define REG_I1 state.gpr.i1.aword
+#  define REG_I2 state.gpr.i2.aword
+#  define REG_I3 state.gpr.i3.aword
+#  define REG_I4 state.gpr.i4.aword
+#  define REG_I5 state.gpr.i5.aword
+#  define REG_I6 state.gpr.i6.aword
+#  define REG_I7 state.gpr.i7.aword
+
+#  define REG_O0 state.gpr.o0.aword
+#  define REG_O1 state.gpr.o1.aword
+#  define REG_O2 state.gpr.o2.aword
+#  define REG_O3 state.gpr.o3.aword
+#  define REG_O4 state.gpr.o4.aword
+#  define REG_O5 state.gpr.o5.aword
+#  define REG_O6 state.gpr.o6.aword
+#  define REG_O7 state.gpr.o7.aword
+#endif  // defined(REMILL_SPARC_WINDOW_RING)
 
 #define REG_F0 state.fpreg.v[0].floats.elems[0]
 #define REG_F1 state.fpreg.v[0].floats.elems[1]
@@ -147,6 +187,59 @@ DEF_SEM(HandleInvalidInstruction) {
   return memory;
 }
 
+#if defined(REMILL_SPARC_WINDOW_RING)
+
+// The register windows live in `state.window_regs`, indexed by `CWP`, rather
+// than in the `WINDOW` variable of each lifted function, so the `window` and
+// `prev_window` operands go unused. `SAVE` and `RESTORE` only move `CWP`
+// around the ring. They call into the runtime when `CANSAVE` or `CANRESTORE`
+// says that a window must first be spilled to, or filled from, the stack.
+DEF_HELPER(SAVE_WINDOW, RegisterWindow *, RegisterWindow *&)->void {
+  if (!Read(PSR_CANSAVE)) {
+    memory = __remill_sync_hyper_call(state, memory,
+                                      SyncHyperCall::kSPARCWindowOverflow);
+  }
+
+  const auto cwp = Read(PSR_CWP) + 1u;
+  Write(PSR_CWP, static_cast<uint8_t>(cwp % kNumRegisterWindows));
+  Write(PSR_CANSAVE, static_cast<uint8_t>(Read(PSR_CANSAVE) - 1u));
+  Write(PSR_CANRESTORE, static_cast<uint8_t>(Read(PSR_CANRESTORE) + 1u));
+}
+
+DEF_HELPER(RESTORE_WINDOW, RegisterWindow *&)->void {
+  if (!Read(PSR_CANRESTORE)) {
+    memory = __remill_sync_hyper_call(state, memory,
+                                      SyncHyperCall::kSPARCWindowUnderflow);
+  }
+
+  const auto cwp = Read(PSR_CWP) + kNumRegisterWindows - 1u;
+  Write(PSR_CWP, static_cast<uint8_t>(cwp % kNumRegisterWindows));
+  Write(PSR_CANSAVE, static_cast<uint8_t>(Read(PSR_CANSAVE) + 1u));
+  Write(PSR_CANRESTORE, static_cast<uint8_t>(Read(PSR_CANRESTORE) - 1u));
+}
+
+// The lifter computes the address of the destination register of a `SAVE` or
+// `RESTORE` with the `CWP` from before the window moves, but the result goes
+// into the new window. Moves `dst` by `num_windows` windows around the ring.
+// Global registers stay where they are.
+template <typename T>
+ALWAYS_INLINE static RnW<T> MoveToWindow(State &state, RnW<T> dst,
+                                         int num_windows) {
+  const auto ring = reinterpret_cast<uintptr_t>(&(state.window_regs[0]));
+  const auto ring_size = static_cast<uintptr_t>(sizeof(state.window_regs));
+  const auto addr = reinterpret_cast<uintptr_t>(dst.val_ref);
+  if ((addr - ring) >= ring_size) {
+    return dst;
+  }
+
+  const auto shift = static_cast<uintptr_t>(
+      (kNumRegisterWindows + num_windows) % kNumRegisterWindows) *
+      16u * sizeof(Reg);
+  return {reinterpret_cast<T *>(ring + ((addr - ring + shift) % ring_size))};
+}
+
+#else
+
 DEF_HELPER(SAVE_WINDOW, RegisterWindow *window, RegisterWindow *&prev_window)
     ->void {
 
@@ -228,6 +321,13 @@ DEF_HELPER(RESTORE_WINDOW, RegisterWindow *&prev_window)->void {
   Write(REG_I7, window->i7);
 }
 
+template <typename T>
+ALWAYS_INLINE static RnW<T> MoveToWindow(State &, RnW<T> dst, int) {
+  return dst;
+}
+
+#endif  // defined(REMILL_SPARC_WINDOW_RING)
+
 }  // namespace
 
 // Takes the place of an unsupported instruction.
@@ -77,7 +77,7 @@ DEF_SEM(SAVE, S1 src1, S2 src2, D dst, RegisterWindow *window,
   addr_t sp_offset = Read(src2);
   addr_t new_sp = UAdd(sp_base, sp_offset);
   SAVE_WINDOW(memory, state, window, prev_window);
-  WriteZExt(dst, new_sp);
+  WriteZExt(MoveToWindow(state, dst, 1), new_sp);
   return memory;
 }
 
@@ -87,7 +87,7 @@ DEF_SEM(RESTORE, S1 src1, S2 src2, D dst, RegisterWindow *&prev_window) {
   auto rs2 = Read(src2);
   auto sum = UAdd(rs1, rs2);
   RESTORE_WINDOW(memory, state, prev_window);
-  WriteZExt(dst, sum);
+  WriteZExt(MoveToWindow(state, dst, -1), sum);
   return memory;
 }
 
@@ -24,6 +24,7 @@
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Module.h>
 
+#include <array>
 #include <iomanip>
 #include <map>
 #include <memory>
@@ -323,6 +324,67 @@ std::map<xed_iform_enum_t, xed_iform_enum_t> kUnlockedIform = {
     {XED_IFORM_XCHG_MEMb_GPR8, XED_IFORM_XCHG_MEMb_GPR8},
 };
 
+// The most common iforms in compiled code, roughly in decreasing order of
+// frequency.
+static const xed_iform_enum_t kHotIforms[] = {
+    XED_IFORM_MOV_GPRv_MEMv,    XED_IFORM_MOV_MEMv_GPRv,
+    XED_IFORM_MOV_GPRv_GPRv_89, XED_IFORM_LEA_GPRv_AGEN,
+    XED_IFORM_MOV_GPRv_GPRv_8B, XED_IFORM_CMP_GPRv_IMMb,
+    XED_IFORM_JZ_RELBRb,        XED_IFORM_JNZ_RELBRb,
+    XED_IFORM_ADD_GPRv_IMMb,    XED_IFORM_TEST_GPRv_GPRv,
+    XED_IFORM_CMP_GPRv_GPRv_39, XED_IFORM_SUB_GPRv_IMMb,
+    XED_IFORM_MOV_GPRv_IMMz,    XED_IFORM_MOV_MEMv_IMMz,
+    XED_IFORM_ADD_GPRv_GPRv_01, XED_IFORM_CMP_MEMv_IMMb,
+    XED_IFORM_CMP_GPRv_MEMv,    XED_IFORM_JZ_RELBRz,
+    XED_IFORM_JNZ_RELBRz,
+};
+
+static constexpr auto kNumHotIforms = sizeof(kHotIforms) / sizeof(kHotIforms[0]);
+
+// Semantics function names of the hot iforms, formatted up front for every
+// effective operand width. Index `0` is the unsuffixed name, and index `i`
+// is the name suffixed with `_<4 << i>`, i.e. `_8` through `_64`.
+using HotIformNames = std::array<std::string, 5>;
+
+static const HotIformNames *GetHotIformNames(void) {
+  static const auto names = [](void) {
+    std::array<HotIformNames, kNumHotIforms> ret;
+    for (auto i = 0u; i < kNumHotIforms; ++i) {
+      ret[i][0] = xed_iform_enum_t2str(kHotIforms[i]);
+      for (auto j = 1u; j < ret[i].size(); ++j) {
+        ret[i][j] = ret[i][0] + "_" + std::to_string(4u << j);
+      }
+    }
+    return ret;
+  }();
+  return names.data();
+}
+
+// Fast path of `InstructionFunctionName` for the hot iforms. This skips the
+// `std::stringstream` that we would otherwise use to format the name.
+static const std::string *HotInstructionFunctionName(
+    const xed_decoded_inst_t *xedd, xed_iform_enum_t iform) {
+  for (auto i = 0u; i < kNumHotIforms; ++i) {
+    if (kHotIforms[i] != iform) {
+      continue;
+    }
+
+    const auto &names = GetHotIformNames()[i];
+    if (!xed_decoded_inst_get_attribute(xedd, XED_ATTRIBUTE_SCALABLE)) {
+      return &(names[0]);
+    }
+
+    switch (xed_decoded_inst_get_operand_width(xedd)) {
+      case 8: return &(names[1]);
+      case 16: return &(names[2]);
+      case 32: return &(names[3]);
+      case 64: return &(names[4]);
+      default: return nullptr;
+    }
+  }
+  return nullptr;
+}
+
 // Name of this instruction function.
 static std::string InstructionFunctionName(const xed_decoded_inst_t *xedd) {
 
@@ -334,6 +396,9 @@ static std::string InstructionFunctionName(const xed_decoded_inst_t *xedd) {
     CHECK(kUnlockedIform.count(iform))
         << xed_iform_enum_t2str(iform) << " has no unlocked iform mapping.";
     iform = kUnlockedIform[iform];
+
+  } else if (auto name = HotInstructionFunctionName(xedd, iform)) {
+    return *name;
   }
 
   std::stringstream ss;
@@ -804,6 +869,12 @@ class X86Arch final : public Arch {
   bool DecodeInstruction(uint64_t address, std::string_view inst_bytes,
                          Instruction &inst) const final;
 
+  // Decode only the length, category, and direct branch targets of an
+  // instruction.
+  bool DecodeControlFlow(uint64_t address, std::string_view inst_bytes,
+                         ControlFlowInfo &info) const final;
+  bool DecodesControlFlowWithoutSemantics(void) const final;
+
   // Maximum number of bytes in an instruction.
   uint64_t MinInstructionAlign(void) const final;
   uint64_t MinInstructionSize(void) const final;
@@ -1061,6 +1132,25 @@ static bool IsAVX512(xed_isa_set_enum_t isa_set, xed_category_enum_t category) {
   }
 }
 
+// Classify the decoded instruction to the minimum sub-architecture needed to
+// lift it.
+static ArchName SubArchName(const xed_decoded_inst_t *xedd,
+                            unsigned address_size) {
+  const auto isa_set = xed_decoded_inst_get_isa_set(xedd);
+  const auto category = xed_decoded_inst_get_category(xedd);
+  if (IsAVX512(isa_set, category)) {
+    return 32 == address_size ? kArchX86_AVX512 : kArchAMD64_AVX512;
+  } else if (IsAVX(isa_set, category)) {
+    return 32 == address_size ? kArchX86_AVX : kArchAMD64_AVX;
+  } else if (xed_classify_avx512(xedd) || xed_classify_avx512_maskop(xedd)) {
+    return 32 == address_size ? kArchX86_AVX512 : kArchAMD64_AVX512;
+  } else if (xed_classify_avx(xedd)) {
+    return 32 == address_size ? kArchX86_AVX : kArchAMD64_AVX;
+  } else {
+    return 32 == address_size ? kArchX86 : kArchAMD64;
+  }
+}
+
 // Decode the destination register of a `pop <reg>`, where `byte` is the only
 // byte of a 1-byte opcode. On 64-bit, the same decoded by maps to a 64-bit
 // register. We apply a fixup below in `FillFusedCallPopRegOperands` to account
@@ -1098,6 +1188,38 @@ static const char *FusablePopReg64(char byte) {
   }
 }
 
+// Look for a `call` to the next instruction, followed by a `pop <reg>`. If
+// found, returns the name of the popped register, and sets `extra_len` to the
+// length of the `pop`.
+static const char *FusedCallPopReg(const xed_decoded_inst_t *xedd,
+                                   std::string_view inst_bytes,
+                                   unsigned address_size,
+                                   unsigned &extra_len) {
+  const auto len = xed_decoded_inst_get_length(xedd);
+  const auto iform = xed_decoded_inst_get_iform_enum(xedd);
+  if (len >= inst_bytes.size() ||
+      (iform != XED_IFORM_CALL_NEAR_RELBRd &&
+       iform != XED_IFORM_CALL_NEAR_RELBRz) ||
+      xed_decoded_inst_get_branch_displacement(xedd)) {
+    return nullptr;
+  }
+
+  if (auto reg = FusablePopReg32(inst_bytes[len])) {
+    extra_len = 1u;
+    return reg;
+
+  // Look for `pop r8` et al.
+  } else if (64 == address_size && (2 + len) <= inst_bytes.size() &&
+             inst_bytes[len] == 0x41) {
+    if (auto reg = FusablePopReg64(inst_bytes[len + 1])) {
+      extra_len = 2u;
+      return reg;
+    }
+  }
+
+  return nullptr;
+}
+
 // Fill in the operands for a fused `call+pop` pair. This ends up acting like
 // a `mov` variant, and the semantic is located in `DATAXFER`. Fusing of this
 // pair is beneficial to avoid downstream users from treating the initial call
@@ -1177,17 +1299,7 @@ bool X86Arch::DecodeInstruction(uint64_t address, std::string_view inst_bytes,
   const auto category = xed_decoded_inst_get_category(xedd);
 
   // Re-classify this instruction to its sub-architecture.
-  if (IsAVX512(isa_set, category)) {
-    inst.sub_arch_name = 32 == address_size ? kArchX86_AVX512 : kArchAMD64_AVX512;
-  } else if (IsAVX(isa_set, category)) {
-    inst.sub_arch_name = 32 == address_size ? kArchX86_AVX : kArchAMD64_AVX;
-  } else if (xed_classify_avx512(xedd) || xed_classify_avx512_maskop(xedd)) {
-    inst.sub_arch_name = 32 == address_size ? kArchX86_AVX512 : kArchAMD64_AVX512;
-  } else if (xed_classify_avx(xedd)) {
-    inst.sub_arch_name = 32 == address_size ? kArchX86_AVX : kArchAMD64_AVX;
-  } else {
-    inst.sub_arch_name = 32 == address_size ? kArchX86 : kArchAMD64;
-  }
+  inst.sub_arch_name = SubArchName(xedd, address_size);
 
   // Make sure we know about
   if (static_cast<unsigned>(inst.arch_name) <
@@ -1204,30 +1316,14 @@ bool X86Arch::DecodeInstruction(uint64_t address, std::string_view inst_bytes,
   }
 
   // Look for instruction fusing opportunities. For now, just `call; pop`.
-  const char *is_fused_call_pop = nullptr;
-  if (len < inst_bytes.size() &&
-      (iform == XED_IFORM_CALL_NEAR_RELBRd ||
-       iform == XED_IFORM_CALL_NEAR_RELBRz) &&
-      !xed_decoded_inst_get_branch_displacement(xedd)) {
-    is_fused_call_pop = FusablePopReg32(inst_bytes[len]);
-
-    // Change the instruction length (to influence `next_pc` calculation) and
-    // the instruction category, so that users no longer interpret this
-    // instruction as semantically being a call.
-    if (is_fused_call_pop) {
-      extra_len = 1u;
-      inst.category = Instruction::kCategoryNormal;
-
-    // Look for `pop r8` et al.
-    } else if (64 == address_size &&
-               (2 + len) <= inst_bytes.size() &&
-               inst_bytes[len] == 0x41) {
-      is_fused_call_pop = FusablePopReg64(inst_bytes[len + 1]);
-      if (is_fused_call_pop) {
-        extra_len = 2u;
-        inst.category = Instruction::kCategoryNormal;
-      }
-    }
+  //
+  // Change the instruction length (to influence `next_pc` calculation) and
+  // the instruction category, so that users no longer interpret this
+  // instruction as semantically being a call.
+  const char *is_fused_call_pop =
+      FusedCallPopReg(xedd, inst_bytes, address_size, extra_len);
+  if (is_fused_call_pop) {
+    inst.category = Instruction::kCategoryNormal;
   }
 
   inst.category = CreateCategory(xedd);
@@ -1351,6 +1447,56 @@ bool X86Arch::DecodeInstruction(uint64_t address, std::string_view inst_bytes,
   return true;
 }
 
+// Decode only the length, category, and direct branch targets of an
+// instruction. This follows `DecodeInstruction`, but skips decoding operands.
+bool X86Arch::DecodeControlFlow(uint64_t address, std::string_view inst_bytes,
+                                ControlFlowInfo &info) const {
+  info = {};
+
+  xed_decoded_inst_t xedd_;
+  xed_decoded_inst_t *xedd = &xedd_;
+  const auto mode = 32 == address_size ? &kXEDState32 : &kXEDState64;
+  if (!DecodeXED(xedd, mode, inst_bytes, address)) {
+    return false;
+  }
+
+  if (static_cast<unsigned>(arch_name) <
+      static_cast<unsigned>(SubArchName(xedd, address_size))) {
+    return false;
+  }
+
+  auto extra_len = 0u;
+  const auto is_fused_call_pop =
+      FusedCallPopReg(xedd, inst_bytes, address_size, extra_len);
+  const auto next_pc = address + xed_decoded_inst_get_length(xedd) + extra_len;
+
+  info.size = next_pc - address;
+  info.category = CreateCategory(xedd);
+
+  // Relative branch targets.
+  if (!is_fused_call_pop &&
+      xed_decoded_inst_get_branch_displacement_width(xedd)) {
+    const auto disp =
+        static_cast<int64_t>(xed_decoded_inst_get_branch_displacement(xedd));
+    info.branch_taken_pc =
+        static_cast<uint64_t>(static_cast<int64_t>(next_pc) + disp);
+    info.branch_not_taken_pc = next_pc;
+  }
+
+  // Return addresses.
+  if (Instruction::kCategoryDirectFunctionCall == info.category ||
+      Instruction::kCategoryIndirectFunctionCall == info.category) {
+    info.branch_not_taken_pc = next_pc;
+  }
+
+  return true;
+}
+
+// Decoding control flow only needs XED.
+bool X86Arch::DecodesControlFlowWithoutSemantics(void) const {
+  return true;
+}
+
 static const std::string_view kSPNames[] = {"RSP", "ESP"};
 static const std::string_view kPCNames[] = {"RIP", "EIP"};
 
@@ -43,6 +43,17 @@ DEF_SEM(ADD, D dst, S1 src1, S2 src2) {
   return memory;
 }
 
+// Atomic version of `ADD`, used for `LOCK ADD` when lifting with direct
+// atomics. The old value of `dst` is returned by the atomic intrinsic.
+template <typename D, typename S1, typename S2>
+DEF_SEM(ATOMIC_ADD, D dst, S1 src1, S2 src2) {
+  auto rhs = Read(src2);
+  auto lhs = UFetchAdd(dst, rhs);
+  auto sum = UAdd(lhs, rhs);
+  WriteFlagsAddSub<tag_add>(state, lhs, rhs, sum);
+  return memory;
+}
+
 template <typename D, typename S1, typename S2>
 DEF_SEM(ADDPS, D dst, S1 src1, S2 src2) {
   FWriteV32(dst, FAddV32(FReadV32(src1), FReadV32(src2)));
@@ -96,6 +107,13 @@ DEF_ISEL_RnW_Rn_Rn(ADD_GPRv_GPRv_03, ADD);
 DEF_ISEL(ADD_AL_IMMb) = ADD<R8W, R8, I8>;
 DEF_ISEL_RnW_Rn_In(ADD_OrAX_IMMz, ADD);
 
+DEF_ISEL(ATOMIC_ADD_MEMb_IMMb_80r0) = ATOMIC_ADD<M8W, M8, I8>;
+DEF_ISEL_MnW_Mn_In(ATOMIC_ADD_MEMv_IMMz, ATOMIC_ADD);
+DEF_ISEL(ATOMIC_ADD_MEMb_IMMb_82r0) = ATOMIC_ADD<M8W, M8, I8>;
+DEF_ISEL_MnW_Mn_In(ATOMIC_ADD_MEMv_IMMb, ATOMIC_ADD);
+DEF_ISEL(ATOMIC_ADD_MEMb_GPR8) = ATOMIC_ADD<M8W, M8, R8>;
+DEF_ISEL_MnW_Mn_Rn(ATOMIC_ADD_MEMv_GPRv, ATOMIC_ADD);
+
 DEF_ISEL(ADDPS_XMMps_MEMps) = ADDPS<V128W, V128, MV128>;
 DEF_ISEL(ADDPS_XMMps_XMMps) = ADDPS<V128W, V128, V128>;
 IF_AVX(DEF_ISEL(VADDPS_XMMdq_XMMdq_MEMdq) = ADDPS<VV128W, VV128, MV128>;)
@@ -132,6 +150,16 @@ DEF_SEM(SUB, D dst, S1 src1, S2 src2) {
   return memory;
 }
 
+// Atomic version of `SUB`, used for `LOCK SUB`.
+template <typename D, typename S1, typename S2>
+DEF_SEM(ATOMIC_SUB, D dst, S1 src1, S2 src2) {
+  auto rhs = Read(src2);
+  auto lhs = UFetchSub(dst, rhs);
+  auto sum = USub(lhs, rhs);
+  WriteFlagsAddSub<tag_sub>(state, lhs, rhs, sum);
+  return memory;
+}
+
 template <typename D, typename S1, typename S2>
 DEF_SEM(SUBPS, D dst, S1 src1, S2 src2) {
   FWriteV32(dst, FSubV32(FReadV32(src1), FReadV32(src2)));
@@ -185,6 +213,13 @@ DEF_ISEL_RnW_Rn_Mn(SUB_GPRv_MEMv, SUB);
 DEF_ISEL(SUB_AL_IMMb) = SUB<R8W, R8, I8>;
 DEF_ISEL_RnW_Rn_In(SUB_OrAX_IMMz, SUB);
 
+DEF_ISEL(ATOMIC_SUB_MEMb_IMMb_80r5) = ATOMIC_SUB<M8W, M8, I8>;
+DEF_ISEL_MnW_Mn_In(ATOMIC_SUB_MEMv_IMMz, ATOMIC_SUB);
+DEF_ISEL(ATOMIC_SUB_MEMb_IMMb_82r5) = ATOMIC_SUB<M8W, M8, I8>;
+DEF_ISEL_MnW_Mn_In(ATOMIC_SUB_MEMv_IMMb, ATOMIC_SUB);
+DEF_ISEL(ATOMIC_SUB_MEMb_GPR8) = ATOMIC_SUB<M8W, M8, R8>;
+DEF_ISEL_MnW_Mn_Rn(ATOMIC_SUB_MEMv_GPRv, ATOMIC_SUB);
+
 DEF_ISEL(SUBPS_XMMps_MEMps) = SUBPS<V128W, V128, MV128>;
 DEF_ISEL(SUBPS_XMMps_XMMps) = SUBPS<V128W, V128, V128>;
 IF_AVX(DEF_ISEL(VSUBPS_XMMdq_XMMdq_MEMdq) = SUBPS<VV128W, VV128, MV128>;)
@@ -610,6 +645,25 @@ DEF_SEM(DEC, D dst, S1 src) {
   return memory;
 }
 
+// Atomic versions of `INC` and `DEC`, used for `LOCK INC` and `LOCK DEC`.
+template <typename D, typename S1>
+DEF_SEM(ATOMIC_INC, D dst, S1 src) {
+  auto_t(S1) rhs = 1;
+  auto lhs = UFetchAdd(dst, rhs);
+  auto sum = UAdd(lhs, rhs);
+  WriteFlagsIncDec<tag_add>(state, lhs, rhs, sum);
+  return memory;
+}
+
+template <typename D, typename S1>
+DEF_SEM(ATOMIC_DEC, D dst, S1 src) {
+  auto_t(S1) rhs = 1;
+  auto lhs = UFetchSub(dst, rhs);
+  auto sum = USub(lhs, rhs);
+  WriteFlagsIncDec<tag_sub>(state, lhs, rhs, sum);
+  return memory;
+}
+
 template <typename D, typename S1>
 DEF_SEM(NEG, D dst, S1 src) {
   auto_t(S1) lhs = 0;
@@ -634,6 +688,11 @@ DEF_ISEL_MnW_Mn(DEC_MEMv, DEC);
 DEF_ISEL_RnW_Rn(DEC_GPRv_FFr1, DEC);
 DEF_ISEL_RnW_Rn(DEC_GPRv_48, DEC);
 
+DEF_ISEL(ATOMIC_INC_MEMb) = ATOMIC_INC<M8W, M8>;
+DEF_ISEL_MnW_Mn(ATOMIC_INC_MEMv, ATOMIC_INC);
+DEF_ISEL(ATOMIC_DEC_MEMb) = ATOMIC_DEC<M8W, M8>;
+DEF_ISEL_MnW_Mn(ATOMIC_DEC_MEMv, ATOMIC_DEC);
+
 DEF_ISEL(NEG_MEMb) = NEG<M8W, M8>;
 DEF_ISEL(NEG_GPR8) = NEG<R8W, R8>;
 DEF_ISEL_MnW_Mn(NEG_MEMv, NEG);
@@ -60,6 +60,37 @@ DEF_SEM(XOR, D dst, S1 src1, S2 src2) {
   return memory;
 }
 
+// Atomic versions of `AND`, `OR`, and `XOR`, used for the `LOCK`-prefixed
+// instructions when lifting with direct atomics.
+template <typename D, typename S1, typename S2>
+DEF_SEM(ATOMIC_AND, D dst, S1 src1, S2 src2) {
+  auto rhs = Read(src2);
+  auto lhs = UFetchAnd(dst, rhs);
+  auto res = UAnd(lhs, rhs);
+  SetFlagsLogical(state, lhs, rhs, res);
+  return memory;
+}
+
+template <typename D, typename S1, typename S2>
+DEF_SEM(ATOMIC_OR, D dst, S1 src1, S2 src2) {
+  auto rhs = Read(src2);
+  auto lhs = UFetchOr(dst, rhs);
+  auto res = UOr(lhs, rhs);
+  SetFlagsLogical(state, lhs, rhs, res);
+  UndefFlag(af);
+  return memory;
+}
+
+template <typename D, typename S1, typename S2>
+DEF_SEM(ATOMIC_XOR, D dst, S1 src1, S2 src2) {
+  auto rhs = Read(src2);
+  auto lhs = UFetchXor(dst, rhs);
+  auto res = UXor(lhs, rhs);
+  SetFlagsLogical(state, lhs, rhs, res);
+  UndefFlag(af);
+  return memory;
+}
+
 template <typename D, typename S1>
 DEF_SEM(NOT, D dst, S1 src1) {
   WriteZExt(dst, UNot(Read(src1)));
@@ -97,6 +128,13 @@ DEF_ISEL_RnW_Rn_Mn(AND_GPRv_MEMv, AND);
 DEF_ISEL(AND_AL_IMMb) = AND<R8W, R8, I8>;
 DEF_ISEL_RnW_Rn_In(AND_OrAX_IMMz, AND);
 
+DEF_ISEL(ATOMIC_AND_MEMb_IMMb_80r4) = ATOMIC_AND<M8W, M8, I8>;
+DEF_ISEL_MnW_Mn_In(ATOMIC_AND_MEMv_IMMz, ATOMIC_AND);
+DEF_ISEL(ATOMIC_AND_MEMb_IMMb_82r4) = ATOMIC_AND<M8W, M8, I8>;
+DEF_ISEL_MnW_Mn_In(ATOMIC_AND_MEMv_IMMb, ATOMIC_AND);
+DEF_ISEL(ATOMIC_AND_MEMb_GPR8) = ATOMIC_AND<M8W, M8, R8>;
+DEF_ISEL_MnW_Mn_Rn(ATOMIC_AND_MEMv_GPRv, ATOMIC_AND);
+
 DEF_ISEL(OR_MEMb_IMMb_80r1) = OR<M8W, M8, I8>;
 DEF_ISEL(OR_GPR8_IMMb_80r1) = OR<R8W, R8, I8>;
 DEF_ISEL_MnW_Mn_In(OR_MEMv_IMMz, OR);
@@ -116,6 +154,13 @@ DEF_ISEL_RnW_Rn_Rn(OR_GPRv_GPRv_0B, OR);
 DEF_ISEL(OR_AL_IMMb) = OR<R8W, R8, I8>;
 DEF_ISEL_RnW_Rn_In(OR_OrAX_IMMz, OR);
 
+DEF_ISEL(ATOMIC_OR_MEMb_IMMb_80r1) = ATOMIC_OR<M8W, M8, I8>;
+DEF_ISEL_MnW_Mn_In(ATOMIC_OR_MEMv_IMMz, ATOMIC_OR);
+DEF_ISEL(ATOMIC_OR_MEMb_IMMb_82r1) = ATOMIC_OR<M8W, M8, I8>;
+DEF_ISEL_MnW_Mn_In(ATOMIC_OR_MEMv_IMMb, ATOMIC_OR);
+DEF_ISEL(ATOMIC_OR_MEMb_GPR8) = ATOMIC_OR<M8W, M8, R8>;
+DEF_ISEL_MnW_Mn_Rn(ATOMIC_OR_MEMv_GPRv, ATOMIC_OR);
+
 DEF_ISEL(XOR_MEMb_IMMb_80r6) = XOR<M8W, M8, I8>;
 DEF_ISEL(XOR_GPR8_IMMb_80r6) = XOR<R8W, R8, I8>;
 DEF_ISEL_MnW_Mn_In(XOR_MEMv_IMMz, XOR);
@@ -135,6 +180,13 @@ DEF_ISEL_RnW_Rn_Mn(XOR_GPRv_MEMv, XOR);
 DEF_ISEL(XOR_AL_IMMb) = XOR<R8W, R8, I8>;
 DEF_ISEL_RnW_Rn_In(XOR_OrAX_IMMz, XOR);
 
+DEF_ISEL(ATOMIC_XOR_MEMb_IMMb_80r6) = ATOMIC_XOR<M8W, M8, I8>;
+DEF_ISEL_MnW_Mn_In(ATOMIC_XOR_MEMv_IMMz, ATOMIC_XOR);
+DEF_ISEL(ATOMIC_XOR_MEMb_IMMb_82r6) = ATOMIC_XOR<M8W, M8, I8>;
+DEF_ISEL_MnW_Mn_In(ATOMIC_XOR_MEMv_IMMb, ATOMIC_XOR);
+DEF_ISEL(ATOMIC_XOR_MEMb_GPR8) = ATOMIC_XOR<M8W, M8, R8>;
+DEF_ISEL_MnW_Mn_Rn(ATOMIC_XOR_MEMv_GPRv, ATOMIC_XOR);
+
 DEF_ISEL(NOT_MEMb) = NOT<M8W, M8>;
 DEF_ISEL(NOT_GPR8) = NOT<R8W, R8>;
 DEF_ISEL_MnW_Mn(NOT_MEMv, NOT);
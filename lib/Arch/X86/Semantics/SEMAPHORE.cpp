@@ -89,6 +89,19 @@ DEF_ISEL(CMPXCHG8B_MEMq) = DoCMPXCHG8B_MEMq;
 DEF_ISEL(CMPXCHG16B_MEMdq) = DoCMPXCHG16B_MEMdq;
 #endif  // 64 == ADDRESS_SIZE_BITS
 
+// `CMPXCHG` is always implemented with `__remill_compare_exchange_memory_*`,
+// so the direct atomic versions are the same.
+DEF_ISEL(ATOMIC_CMPXCHG_MEMb_GPR8) = CMPXCHG_AL<M8W, M8, R8>;
+DEF_ISEL(ATOMIC_CMPXCHG_MEMv_GPRv_8) = CMPXCHG_AL<M8W, M8, R8>;
+DEF_ISEL(ATOMIC_CMPXCHG_MEMv_GPRv_16) = CMPXCHG_AX<M16W, M16, R16>;
+DEF_ISEL(ATOMIC_CMPXCHG_MEMv_GPRv_32) = CMPXCHG_EAX<M32W, M32, R32>;
+IF_64BIT(DEF_ISEL(ATOMIC_CMPXCHG_MEMv_GPRv_64) = CMPXCHG_RAX<M64W, M64, R64>;)
+DEF_ISEL(ATOMIC_CMPXCHG8B_MEMq) = DoCMPXCHG8B_MEMq;
+
+#if 64 == ADDRESS_SIZE_BITS
+DEF_ISEL(ATOMIC_CMPXCHG16B_MEMdq) = DoCMPXCHG16B_MEMdq;
+#endif  // 64 == ADDRESS_SIZE_BITS
+
 namespace {
 
 // Atomic fetch-add.
@@ -110,9 +123,24 @@ DEF_SEM(XADD, D1 dst1, S1 src1, D2 dst2, S2 src2) {
   return memory;
 }
 
+// Atomic version of `XADD`, used for `XADD` with a memory destination when
+// lifting with direct atomics.
+template <typename D1, typename S1, typename D2, typename S2>
+DEF_SEM(ATOMIC_XADD, D1 dst1, S1 src1, D2 dst2, S2 src2) {
+  auto rhs = Read(src2);
+  auto lhs = UFetchAdd(dst1, rhs);
+  auto sum = UAdd(lhs, rhs);
+  WriteFlagsAddSub<tag_add>(state, lhs, rhs, sum);
+  WriteZExt(dst2, lhs);
+  return memory;
+}
+
 }  // namespace
 
 DEF_ISEL(XADD_MEMb_GPR8) = XADD<M8W, M8, R8W, R8>;
 DEF_ISEL(XADD_GPR8_GPR8) = XADD<R8W, R8, R8W, R8>;
 DEF_ISEL_MnW_Mn_RnW_Rn(XADD_MEMv_GPRv, XADD);
 DEF_ISEL_RnW_Rn_RnW_Rn(XADD_GPRv_GPRv, XADD);
+
+DEF_ISEL(ATOMIC_XADD_MEMb_GPR8) = ATOMIC_XADD<M8W, M8, R8W, R8>;
+DEF_ISEL_MnW_Mn_RnW_Rn(ATOMIC_XADD_MEMv_GPRv, ATOMIC_XADD);
@@ -164,7 +164,50 @@ IF_64BIT(MAKE_CMPS(CMPSQ, uint64_t))
 
 #undef MAKE_MOVS
 
-#define MAKE_REP(base) \
+namespace {
+
+// Computes the bytes of memory accessed by a string operation on `count`
+// elements of `elem_size` bytes, where `addr` is the address of the first
+// element. If `backward` then the elements are at descending addresses.
+// Returns `false` if the bytes wrap around the address space, in which case
+// the operation has to be performed one element at a time.
+ALWAYS_INLINE static bool StringOpBytes(addr_t addr, addr_t count,
+                                        addr_t elem_size, bool backward,
+                                        addr_t &low_addr, addr_t &num_bytes) {
+  const addr_t max_addr = ~static_cast<addr_t>(0);
+  if (!count || count > (max_addr / elem_size)) {
+    return false;
+  }
+
+  num_bytes = count * elem_size;
+  if (!backward) {
+    low_addr = addr;
+  } else if ((num_bytes - elem_size) <= addr) {
+    low_addr = addr - (num_bytes - elem_size);
+  } else {
+    return false;
+  }
+
+  return (num_bytes - 1) <= (max_addr - low_addr);
+}
+
+// Returns `true` if copying `num_bytes` from `src_addr` to `dst_addr` one
+// element at a time, in ascending (or descending if `backward`) address
+// order, has the same effect as a `memmove`. That is the case unless some
+// element is written to source bytes that are read by a later element, which
+// is sometimes done on purpose, e.g. to replicate a byte pattern.
+ALWAYS_INLINE static bool IsCopyLikeMemmove(addr_t dst_addr, addr_t src_addr,
+                                            addr_t num_bytes, bool backward) {
+  if (backward) {
+    return dst_addr >= src_addr || (src_addr - dst_addr) >= num_bytes;
+  } else {
+    return dst_addr <= src_addr || (dst_addr - src_addr) >= num_bytes;
+  }
+}
+
+}  // namespace
+
+#define MAKE_REP_LOOP(base) \
   namespace { \
   DEF_SEM(Do##REP_##base) { \
     auto count_reg = Read(REG_XCX); \
@@ -175,7 +218,10 @@ IF_64BIT(MAKE_CMPS(CMPSQ, uint64_t))
     } \
     return memory; \
   } \
-  } \
+  }
+
+#define MAKE_REP(base) \
+  MAKE_REP_LOOP(base) \
   DEF_ISEL(REP_##base) = Do##REP_##base;
 
 MAKE_REP(LODSB)
@@ -183,18 +229,85 @@ MAKE_REP(LODSW)
 MAKE_REP(LODSD)
 IF_64BIT(MAKE_REP(LODSQ))
 
-MAKE_REP(MOVSB)
-MAKE_REP(MOVSW)
-MAKE_REP(MOVSD)
-IF_64BIT(MAKE_REP(MOVSQ))
-
-MAKE_REP(STOSB)
-MAKE_REP(STOSW)
-MAKE_REP(STOSD)
-IF_64BIT(MAKE_REP(STOSQ))
 #undef MAKE_REP
 
-#define MAKE_REPE(base) \
+// `REP MOVS` is a single `__remill_memory_copy`, unless the copy overlaps in
+// a way that `memmove` wouldn't reproduce.
+#define MAKE_REP_MOVS(base, type) \
+  MAKE_REP_LOOP(base) \
+  namespace { \
+  DEF_SEM(DoBulkREP_##base) { \
+    const addr_t count = Read(REG_XCX); \
+    const addr_t elem_size = static_cast<addr_t>(sizeof(type)); \
+    const addr_t src_reg = Read(REG_XSI); \
+    const addr_t dst_reg = Read(REG_XDI); \
+    addr_t src_addr = 0; \
+    addr_t dst_addr = 0; \
+    addr_t num_bytes = 0; \
+    if (StringOpBytes(UAdd(src_reg, REG_DS_BASE), count, elem_size, FLAG_DF, \
+                      src_addr, num_bytes) && \
+        StringOpBytes(UAdd(dst_reg, REG_ES_BASE), count, elem_size, FLAG_DF, \
+                      dst_addr, num_bytes) && \
+        IsCopyLikeMemmove(dst_addr, src_addr, num_bytes, FLAG_DF)) { \
+      memory = __remill_memory_copy(memory, dst_addr, src_addr, num_bytes); \
+      if (BNot(FLAG_DF)) { \
+        Write(REG_XSI, UAdd(src_reg, num_bytes)); \
+        Write(REG_XDI, UAdd(dst_reg, num_bytes)); \
+      } else { \
+        Write(REG_XSI, USub(src_reg, num_bytes)); \
+        Write(REG_XDI, USub(dst_reg, num_bytes)); \
+      } \
+      Write(REG_XCX, static_cast<addr_t>(0)); \
+      return memory; \
+    } \
+    return Do##REP_##base(memory, state); \
+  } \
+  } \
+  DEF_ISEL(REP_##base) = DoBulkREP_##base;
+
+MAKE_REP_MOVS(MOVSB, uint8_t)
+MAKE_REP_MOVS(MOVSW, uint16_t)
+MAKE_REP_MOVS(MOVSD, uint32_t)
+IF_64BIT(MAKE_REP_MOVS(MOVSQ, uint64_t))
+
+#undef MAKE_REP_MOVS
+
+// `REP STOS` is a single `__remill_memory_fill_*`.
+#define MAKE_REP_STOS(base, size, read_sel) \
+  MAKE_REP_LOOP(base) \
+  namespace { \
+  DEF_SEM(DoBulkREP_##base) { \
+    const addr_t count = Read(REG_XCX); \
+    const addr_t elem_size = static_cast<addr_t>(sizeof(uint##size##_t)); \
+    const addr_t dst_reg = Read(REG_XDI); \
+    addr_t dst_addr = 0; \
+    addr_t num_bytes = 0; \
+    if (StringOpBytes(UAdd(dst_reg, REG_ES_BASE), count, elem_size, FLAG_DF, \
+                      dst_addr, num_bytes)) { \
+      memory = __remill_memory_fill_##size( \
+          memory, dst_addr, Read(state.gpr.rax.read_sel), count); \
+      if (BNot(FLAG_DF)) { \
+        Write(REG_XDI, UAdd(dst_reg, num_bytes)); \
+      } else { \
+        Write(REG_XDI, USub(dst_reg, num_bytes)); \
+      } \
+      Write(REG_XCX, static_cast<addr_t>(0)); \
+      return memory; \
+    } \
+    return Do##REP_##base(memory, state); \
+  } \
+  } \
+  DEF_ISEL(REP_##base) = DoBulkREP_##base;
+
+MAKE_REP_STOS(STOSB, 8, byte.low)
+MAKE_REP_STOS(STOSW, 16, word)
+MAKE_REP_STOS(STOSD, 32, dword)
+IF_64BIT(MAKE_REP_STOS(STOSQ, 64, qword))
+
+#undef MAKE_REP_STOS
+#undef MAKE_REP_LOOP
+
+#define MAKE_REPE_LOOP(base) \
   namespace { \
   DEF_SEM(Do##REPE_##base) { \
     auto count_reg = Read(REG_XCX); \
@@ -208,13 +321,55 @@ IF_64BIT(MAKE_REP(STOSQ))
     } while (BAnd(UCmpNeq(count_reg, 0), FLAG_ZF)); \
     return memory; \
   } \
+  }
+
+// A forward `REPE CMPS` uses `__remill_memory_compare` to find the first
+// pair of elements that differ, then compares that pair (or the last pair,
+// if none differ) with `CMPS`, so that the flags and registers end up the
+// same as if every pair had been compared one at a time.
+#define MAKE_REPE_CMPS(base, type) \
+  MAKE_REPE_LOOP(base) \
+  namespace { \
+  DEF_SEM(DoBulkREPE_##base) { \
+    const addr_t count = Read(REG_XCX); \
+    const addr_t elem_size = static_cast<addr_t>(sizeof(type)); \
+    const addr_t src1_reg = Read(REG_XSI); \
+    const addr_t src2_reg = Read(REG_XDI); \
+    addr_t src1_addr = 0; \
+    addr_t src2_addr = 0; \
+    addr_t num_bytes = 0; \
+    if (BNot(FLAG_DF) && \
+        StringOpBytes(UAdd(src1_reg, REG_DS_BASE), count, elem_size, false, \
+                      src1_addr, num_bytes) && \
+        StringOpBytes(UAdd(src2_reg, REG_ES_BASE), count, elem_size, false, \
+                      src2_addr, num_bytes)) { \
+      const addr_t num_same_bytes = \
+          __remill_memory_compare(memory, src1_addr, src2_addr, num_bytes); \
+      addr_t num_elems = count; \
+      if (UCmpLt(num_same_bytes, num_bytes)) { \
+        num_elems = UAdd(UDiv(num_same_bytes, elem_size), 1); \
+      } \
+      const addr_t skipped_bytes = UMul(USub(num_elems, 1), elem_size); \
+      Write(REG_XSI, UAdd(src1_reg, skipped_bytes)); \
+      Write(REG_XDI, UAdd(src2_reg, skipped_bytes)); \
+      Write(REG_XCX, USub(count, num_elems)); \
+      return Do##base(memory, state); \
+    } \
+    return Do##REPE_##base(memory, state); \
   } \
-  DEF_ISEL(REPE_##base) = Do##REPE_##base;
+  } \
+  DEF_ISEL(REPE_##base) = DoBulkREPE_##base;
 
-MAKE_REPE(CMPSB)
-MAKE_REPE(CMPSW)
-MAKE_REPE(CMPSD)
-IF_64BIT(MAKE_REPE(CMPSQ))
+MAKE_REPE_CMPS(CMPSB, uint8_t)
+MAKE_REPE_CMPS(CMPSW, uint16_t)
+MAKE_REPE_CMPS(CMPSD, uint32_t)
+IF_64BIT(MAKE_REPE_CMPS(CMPSQ, uint64_t))
+
+#undef MAKE_REPE_CMPS
+
+#define MAKE_REPE(base) \
+  MAKE_REPE_LOOP(base) \
+  DEF_ISEL(REPE_##base) = Do##REPE_##base;
 
 MAKE_REPE(SCASB)
 MAKE_REPE(SCASW)
@@ -222,6 +377,7 @@ MAKE_REPE(SCASD)
 IF_64BIT(MAKE_REPE(SCASQ))
 
 #undef MAKE_REPE
+#undef MAKE_REPE_LOOP
 
 #define MAKE_REPNE(base) \
   namespace { \
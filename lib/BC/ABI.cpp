@@ -28,7 +28,13 @@ const std::string_view kBranchTakenVariableName = "BRANCH_TAKEN";
 const std::string_view kInvalidInstructionISelName = "INVALID_INSTRUCTION";
 const std::string_view kUnsupportedInstructionISelName =
     "UNSUPPORTED_INSTRUCTION";
+const std::string_view kAtomicISelPrefix = "ATOMIC_";
 
 const std::string_view kIgnoreNextPCVariableName = "IGNORE_NEXT_PC";
 
+const std::string_view kBlockCountsVariableName = "__remill_block_counts";
+const std::string_view kBlockPCsVariableName = "__remill_block_pcs";
+const std::string_view kNumBlockCountsVariableName =
+    "__remill_num_block_counts";
+
 }  // namespace remill
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <llvm/Analysis/AliasAnalysis.h>
+#include <llvm/Analysis/MemoryLocation.h>
+#include <llvm/IR/DataLayout.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/InstrTypes.h>
+#include <llvm/IR/Instructions.h>
+
+#include "remill/Arch/Arch.h"
+#include "remill/BC/ABI.h"
+#include "remill/BC/Util.h"
+#include "remill/BC/Version.h"
+
+namespace remill {
+
+#if LLVM_VERSION_NUMBER >= LLVM_VERSION(16, 0)
+using RemillAAResultBase = llvm::AAResultBase;
+#else
+class RemillAAResult;
+using RemillAAResultBase = llvm::AAResultBase<RemillAAResult>;
+#endif
+
+// Alias analysis that knows about remill's invariants:
+//
+//  - Accesses to distinct registers in the `State` structure never alias,
+//    however they are indexed.
+//
+//  - The `__remill_*` intrinsics whose only pointer arguments are `Memory *`
+//    pointers only operate on the modeled program's memory, and so never
+//    read or write the `State` structure.
+class RemillAAResult : public RemillAAResultBase {
+ public:
+  explicit RemillAAResult(const Arch *arch_)
+      : arch(arch_),
+        dl(arch->DataLayout()) {}
+
+  using RemillAAResultBase::getModRefInfo;
+
+#if LLVM_VERSION_NUMBER >= LLVM_VERSION(16, 0)
+  llvm::AliasResult alias(const llvm::MemoryLocation &loc_a,
+                          const llvm::MemoryLocation &loc_b,
+                          llvm::AAQueryInfo &, const llvm::Instruction *) {
+#else
+  llvm::AliasResult alias(const llvm::MemoryLocation &loc_a,
+                          const llvm::MemoryLocation &loc_b,
+                          llvm::AAQueryInfo &) {
+#endif
+    const auto [base_a, offset_a] = StripAndAccumulateConstantOffsets(
+        dl, const_cast<llvm::Value *>(loc_a.Ptr));
+    const auto [base_b, offset_b] = StripAndAccumulateConstantOffsets(
+        dl, const_cast<llvm::Value *>(loc_b.Ptr));
+
+    if (base_a != base_b || !IsStatePointer(base_a)) {
+      return llvm::AliasResult::MayAlias;
+    }
+
+    const auto reg_a = EnclosingRegister(offset_a, loc_a.Size);
+    const auto reg_b = EnclosingRegister(offset_b, loc_b.Size);
+    if (reg_a && reg_b && reg_a != reg_b) {
+      return llvm::AliasResult::NoAlias;
+    }
+
+    return llvm::AliasResult::MayAlias;
+  }
+
+  llvm::ModRefInfo getModRefInfo(const llvm::CallBase *call,
+                                 const llvm::MemoryLocation &loc,
+                                 llvm::AAQueryInfo &) {
+    const auto callee = call->getCalledFunction();
+    if (!callee || !callee->getName().startswith("__remill_")) {
+      return llvm::ModRefInfo::ModRef;
+    }
+
+    const auto mem_ptr_type = arch->MemoryPointerType();
+    for (auto &arg : call->args()) {
+      if (arg->getType()->isPointerTy() && arg->getType() != mem_ptr_type) {
+        return llvm::ModRefInfo::ModRef;
+      }
+    }
+
+    const auto [base, offset] = StripAndAccumulateConstantOffsets(
+        dl, const_cast<llvm::Value *>(loc.Ptr));
+    (void) offset;
+    if (IsStatePointer(base)) {
+      return llvm::ModRefInfo::NoModRef;
+    }
+
+    return llvm::ModRefInfo::ModRef;
+  }
+
+ private:
+  // Returns `true` if `val` is the `State` pointer argument of a lifted
+  // function, or a stack-allocated `State` structure.
+  bool IsStatePointer(const llvm::Value *val) const {
+    if (auto arg = llvm::dyn_cast<llvm::Argument>(val)) {
+      return arg->getArgNo() == kStatePointerArgNum &&
+             arg->getParent()->getFunctionType() ==
+                 arch->LiftedFunctionType();
+
+    } else if (auto alloca = llvm::dyn_cast<llvm::AllocaInst>(val)) {
+      return alloca->getAllocatedType() == arch->StateStructType();
+
+    } else {
+      return false;
+    }
+  }
+
+  // Returns the outermost register that fully contains the `size` bytes at
+  // `offset` in the `State` structure, or `nullptr`.
+  const Register *EnclosingRegister(int64_t offset,
+                                    llvm::LocationSize size) const {
+    if (offset < 0 || !size.hasValue()) {
+      return nullptr;
+    }
+    auto reg = arch->RegisterAtStateOffset(static_cast<uint64_t>(offset));
+    if (!reg) {
+      return nullptr;
+    }
+    reg = reg->EnclosingRegister();
+    if (static_cast<uint64_t>(offset) + size.getValue() >
+        reg->offset + reg->size) {
+      return nullptr;
+    }
+    return reg;
+  }
+
+  const Arch *const arch;
+  const llvm::DataLayout dl;
+};
+
+}  // namespace remill
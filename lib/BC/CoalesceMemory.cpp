@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glog/logging.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "remill/Arch/Arch.h"
+#include "remill/BC/Optimizer.h"
+
+namespace remill {
+namespace {
+
+// Largest access that two accesses can be coalesced into, in bytes.
+static constexpr uint64_t kMaxCoalescedSize = 8;
+
+// A memory read or write intrinsic call, whose address is `offset` bytes away
+// from `base`. `base` is `nullptr` for accesses to constant addresses.
+struct MemoryAccess {
+  llvm::CallInst *call{nullptr};
+  llvm::Value *base{nullptr};
+  int64_t offset{0};
+  uint64_t size{0};
+};
+
+class MemoryCoalescer {
+ public:
+  MemoryCoalescer(const Arch *arch, llvm::Function *func_);
+
+  // Coalesces one round of pairs of adjacent reads, and of adjacent writes.
+  // Returns the number of intrinsic calls removed.
+  unsigned CoalesceReads(llvm::BasicBlock &block);
+  unsigned CoalesceWrites(llvm::BasicBlock &block);
+
+ private:
+  // Returns the size of the access made by `call`, or zero if `call` isn't
+  // a scalar memory read (`is_write == false`) or write intrinsic.
+  uint64_t AccessSize(llvm::CallInst *call, bool is_write) const;
+
+  // Split the address of `call` into a base and a constant offset.
+  MemoryAccess Decompose(llvm::CallInst *call, uint64_t size) const;
+
+  // Returns `true` if `a` and `b` are adjacent, equally sized, and can be
+  // replaced by a single access to the lower one's address.
+  bool AreAdjacent(const MemoryAccess &a, const MemoryAccess &b) const;
+
+  // Returns the shift, in bits, of `part` within the `size`-byte value that
+  // starts at `lo`.
+  uint64_t ShiftOf(const MemoryAccess &part, const MemoryAccess &lo,
+                   uint64_t size) const;
+
+  // Returns the address of `access`, with its offset adjusted to `offset`.
+  llvm::Value *AddressOf(llvm::IRBuilder<> &ir, const MemoryAccess &access,
+                         int64_t offset) const;
+
+  llvm::Function *const func;
+  const bool little_endian;
+  llvm::IntegerType *const addr_type;
+
+  // Access sizes, in bytes, of the memory intrinsics, and the integer memory
+  // intrinsics for each access size.
+  std::unordered_map<llvm::Function *, uint64_t> read_sizes;
+  std::unordered_map<llvm::Function *, uint64_t> write_sizes;
+  std::unordered_map<uint64_t, llvm::Function *> int_reads;
+  std::unordered_map<uint64_t, llvm::Function *> int_writes;
+};
+
+MemoryCoalescer::MemoryCoalescer(const Arch *arch, llvm::Function *func_)
+    : func(func_),
+      little_endian(arch->MemoryAccessIsLittleEndian()),
+      addr_type(llvm::Type::getIntNTy(func->getContext(),
+                                      arch->address_size)) {
+  const auto module = func->getParent();
+  auto add_func = [=](const char *name, uint64_t size, bool is_write,
+                      bool is_int) {
+    if (auto intrinsic = module->getFunction(name)) {
+      (is_write ? write_sizes : read_sizes)[intrinsic] = size;
+      if (is_int) {
+        (is_write ? int_writes : int_reads)[size] = intrinsic;
+      }
+    }
+  };
+
+  add_func("__remill_read_memory_8", 1, false, true);
+  add_func("__remill_read_memory_16", 2, false, true);
+  add_func("__remill_read_memory_32", 4, false, true);
+  add_func("__remill_read_memory_64", 8, false, true);
+  add_func("__remill_read_memory_f32", 4, false, false);
+  add_func("__remill_read_memory_f64", 8, false, false);
+
+  add_func("__remill_write_memory_8", 1, true, true);
+  add_func("__remill_write_memory_16", 2, true, true);
+  add_func("__remill_write_memory_32", 4, true, true);
+  add_func("__remill_write_memory_64", 8, true, true);
+  add_func("__remill_write_memory_f32", 4, true, false);
+  add_func("__remill_write_memory_f64", 8, true, false);
+}
+
+uint64_t MemoryCoalescer::AccessSize(llvm::CallInst *call,
+                                     bool is_write) const {
+  const auto &sizes = is_write ? write_sizes : read_sizes;
+  auto it = sizes.find(call->getCalledFunction());
+  return it != sizes.end() ? it->second : 0u;
+}
+
+MemoryAccess MemoryCoalescer::Decompose(llvm::CallInst *call,
+                                        uint64_t size) const {
+  MemoryAccess access;
+  access.call = call;
+  access.size = size;
+  access.base = call->getArgOperand(1);
+
+  while (access.base) {
+    if (auto const_addr = llvm::dyn_cast<llvm::ConstantInt>(access.base)) {
+      access.offset += const_addr->getSExtValue();
+      access.base = nullptr;
+
+    } else if (auto add = llvm::dyn_cast<llvm::BinaryOperator>(access.base);
+               add && add->getOpcode() == llvm::Instruction::Add &&
+               llvm::isa<llvm::ConstantInt>(add->getOperand(1))) {
+      access.offset +=
+          llvm::cast<llvm::ConstantInt>(add->getOperand(1))->getSExtValue();
+      access.base = add->getOperand(0);
+
+    } else {
+      break;
+    }
+  }
+
+  return access;
+}
+
+bool MemoryCoalescer::AreAdjacent(const MemoryAccess &a,
+                                  const MemoryAccess &b) const {
+  if (a.base != b.base || a.size != b.size ||
+      a.size * 2u > kMaxCoalescedSize) {
+    return false;
+  }
+  return a.offset + static_cast<int64_t>(a.size) == b.offset ||
+         b.offset + static_cast<int64_t>(b.size) == a.offset;
+}
+
+uint64_t MemoryCoalescer::ShiftOf(const MemoryAccess &part,
+                                  const MemoryAccess &lo,
+                                  uint64_t size) const {
+  const auto byte_offset = static_cast<uint64_t>(part.offset - lo.offset);
+  if (little_endian) {
+    return byte_offset * 8u;
+  } else {
+    return (size - byte_offset - part.size) * 8u;
+  }
+}
+
+llvm::Value *MemoryCoalescer::AddressOf(llvm::IRBuilder<> &ir,
+                                        const MemoryAccess &access,
+                                        int64_t offset) const {
+  const auto addr = access.call->getArgOperand(1);
+  if (offset == access.offset) {
+    return addr;
+  }
+  return ir.CreateAdd(
+      addr, llvm::ConstantInt::get(addr_type, offset - access.offset, true));
+}
+
+// Fuse pairs of equally sized reads of adjacent bytes that read the same
+// `Memory *`. Because they read the same `Memory *`, there can't be any writes
+// or barriers between them. The reads must also be in the same block, without
+// any calls that might not return between them, so that the wider read
+// doesn't read bytes that wouldn't have been read before.
+unsigned MemoryCoalescer::CoalesceReads(llvm::BasicBlock &block) {
+  std::vector<MemoryAccess> reads;
+  std::vector<std::pair<MemoryAccess, MemoryAccess>> pairs;
+
+  for (auto &inst : block) {
+    auto call = llvm::dyn_cast<llvm::CallInst>(&inst);
+    if (!call) {
+      continue;
+    }
+
+    const auto size = AccessSize(call, false);
+    if (!size) {
+      if (!call->doesNotAccessMemory()) {
+        reads.clear();
+      }
+      continue;
+    }
+
+    auto read = Decompose(call, size);
+    auto paired = false;
+    for (auto it = reads.begin(); it != reads.end(); ++it) {
+      if (it->call->getArgOperand(0) == call->getArgOperand(0) &&
+          AreAdjacent(*it, read)) {
+        pairs.emplace_back(*it, read);
+        reads.erase(it);
+        paired = true;
+        break;
+      }
+    }
+
+    if (!paired) {
+      reads.push_back(read);
+    }
+  }
+
+  for (auto &[first, second] : pairs) {
+    const auto &lo = first.offset < second.offset ? first : second;
+    const auto size = first.size * 2u;
+    const auto wide_read = int_reads.find(size);
+    if (wide_read == int_reads.end()) {
+      continue;
+    }
+
+    llvm::IRBuilder<> ir(first.call);
+    llvm::Value *args[] = {first.call->getArgOperand(0),
+                           AddressOf(ir, first, lo.offset)};
+    const auto wide_val = ir.CreateCall(wide_read->second, args);
+
+    for (const auto &read : {first, second}) {
+      const auto type = read.call->getType();
+      llvm::Value *val = ir.CreateLShr(wide_val, ShiftOf(read, lo, size));
+      val = ir.CreateTrunc(
+          val, llvm::Type::getIntNTy(func->getContext(), read.size * 8u));
+      if (val->getType() != type) {
+        val = ir.CreateBitCast(val, type);
+      }
+      read.call->replaceAllUsesWith(val);
+    }
+
+    second.call->eraseFromParent();
+    first.call->eraseFromParent();
+  }
+
+  return static_cast<unsigned>(pairs.size());
+}
+
+// Fuse pairs of equally sized writes to adjacent bytes where the second
+// write's `Memory *` is the result of the first write, and nothing else uses
+// the result of the first write. The wider write takes the place of the
+// second write.
+unsigned MemoryCoalescer::CoalesceWrites(llvm::BasicBlock &block) {
+  std::vector<std::pair<MemoryAccess, MemoryAccess>> pairs;
+
+  for (auto &inst : block) {
+    auto second_call = llvm::dyn_cast<llvm::CallInst>(&inst);
+    if (!second_call) {
+      continue;
+    }
+
+    const auto size = AccessSize(second_call, true);
+    if (!size) {
+      continue;
+    }
+
+    auto first_call =
+        llvm::dyn_cast<llvm::CallInst>(second_call->getArgOperand(0));
+    if (!first_call || first_call->getParent() != &block ||
+        !first_call->hasOneUse() || AccessSize(first_call, true) != size) {
+      continue;
+    }
+
+    const auto first = Decompose(first_call, size);
+    const auto second = Decompose(second_call, size);
+    if (!AreAdjacent(first, second) || !int_writes.count(size * 2u)) {
+      continue;
+    }
+
+    // Don't let one call be part of two pairs.
+    if (!pairs.empty() && pairs.back().second.call == first_call) {
+      continue;
+    }
+
+    pairs.emplace_back(first, second);
+  }
+
+  for (auto &[first, second] : pairs) {
+    const auto &lo = first.offset < second.offset ? first : second;
+    const auto size = first.size * 2u;
+    const auto wide_type =
+        llvm::Type::getIntNTy(func->getContext(), size * 8u);
+
+    llvm::IRBuilder<> ir(second.call);
+    llvm::Value *wide_val = llvm::ConstantInt::get(wide_type, 0);
+    for (const auto &write : {first, second}) {
+      llvm::Value *val = write.call->getArgOperand(2);
+      const auto int_type =
+          llvm::Type::getIntNTy(func->getContext(), write.size * 8u);
+      if (val->getType() != int_type) {
+        val = ir.CreateBitCast(val, int_type);
+      }
+      val = ir.CreateShl(ir.CreateZExt(val, wide_type),
+                         ShiftOf(write, lo, size));
+      wide_val = ir.CreateOr(wide_val, val);
+    }
+
+    llvm::Value *args[] = {first.call->getArgOperand(0),
+                           AddressOf(ir, second, lo.offset), wide_val};
+    const auto wide_write = ir.CreateCall(int_writes[size], args);
+
+    second.call->replaceAllUsesWith(wide_write);
+    second.call->eraseFromParent();
+    first.call->eraseFromParent();
+  }
+
+  return static_cast<unsigned>(pairs.size());
+}
+
+}  // namespace
+
+// Fuse adjacent, equally sized memory reads, and adjacent, equally sized
+// memory writes, in `func` into wider reads and writes, respecting the
+// endianness of `arch`. Returns the number of removed memory intrinsic calls.
+unsigned CoalesceMemoryAccesses(const Arch *arch, llvm::Function *func) {
+  MemoryCoalescer coalescer(arch, func);
+  unsigned num_removed = 0;
+  for (auto changed = true; changed;) {
+    changed = false;
+    for (auto &block : *func) {
+      const auto num_reads = coalescer.CoalesceReads(block);
+      const auto num_writes = coalescer.CoalesceWrites(block);
+      num_removed += num_reads + num_writes;
+      changed = changed || num_reads || num_writes;
+    }
+  }
+
+  DLOG_IF(INFO, num_removed)
+      << "Removed " << num_removed << " memory intrinsic calls from "
+      << func->getName().str() << " by coalescing them";
+
+  return num_removed;
+}
+
+}  // namespace remill
@@ -41,10 +41,105 @@ llvm::Function *GetInstructionFunction(llvm::Module *module,
   return llvm::dyn_cast_or_null<llvm::Function>(sem);
 }
 
+// Returns the function to call in `module` for the semantics function `sem`,
+// declaring it if `sem` lives in another module.
+llvm::Function *DeclareSemanticsFunction(llvm::Module *module,
+                                         llvm::Function *sem) {
+  if (!sem || sem->getParent() == module) {
+    return sem;
+  }
+
+  if (auto decl = module->getFunction(sem->getName())) {
+
+    // An internal definition was linked in by `LinkSemantics`, and may have
+    // been optimized since, e.g. had its arguments or return value removed
+    // or made undefined, so it can't be called again. Let it keep its body
+    // under no name, and declare the semantics function afresh, so that a
+    // pristine copy is linked in next time.
+    if (!decl->hasLocalLinkage()) {
+      CHECK_EQ(decl->getFunctionType(), sem->getFunctionType())
+          << "Semantics function " << sem->getName().str()
+          << " has a different type in module " << ModuleName(module);
+      return decl;
+    }
+    decl->setName("");
+  }
+
+  auto decl = llvm::Function::Create(sem->getFunctionType(),
+                                     llvm::GlobalValue::ExternalLinkage,
+                                     sem->getName(), module);
+  decl->setAttributes(sem->getAttributes());
+  decl->setCallingConv(sem->getCallingConv());
+  return decl;
+}
+
+// Suffix of the name of the template of a semantics function.
+constexpr const char *kTemplateSuffix = ".template";
+
+// Maximum number of rounds of inlining the callees of a semantics function
+// into its template. Each round inlines the calls exposed by the last one.
+constexpr unsigned kMaxTemplateInlineRounds = 8u;
+
+// Make a copy of the semantics function `sem` with all of its defined callees
+// inlined, and then simplify it. Returns `nullptr` unless the simplified copy
+// is a single block that ends in a return, as inlining anything else would
+// split the block being lifted into.
+llvm::Function *CreateSemanticsTemplate(llvm::Function *sem) {
+  if (sem->isDeclaration()) {
+    return nullptr;
+  }
+
+  llvm::ValueToValueMapTy value_map;
+  auto templ = llvm::CloneFunction(sem, value_map);
+  templ->setName(sem->getName() + kTemplateSuffix);
+  templ->setLinkage(llvm::GlobalValue::InternalLinkage);
+  templ->removeFnAttr(llvm::Attribute::NoInline);
+  templ->removeFnAttr(llvm::Attribute::OptimizeNone);
+
+  for (auto i = 0u; i < kMaxTemplateInlineRounds; ++i) {
+    std::vector<llvm::CallBase *> calls;
+    for (auto &inst : llvm::instructions(templ)) {
+      if (auto call = llvm::dyn_cast<llvm::CallBase>(&inst)) {
+        auto callee = call->getCalledFunction();
+        if (callee && !callee->isDeclaration() && callee != templ) {
+          calls.push_back(call);
+        }
+      }
+    }
+
+    if (calls.empty()) {
+      break;
+    }
+
+    for (auto call : calls) {
+      llvm::InlineFunctionInfo info;
+      llvm::InlineFunction(*call, info);
+    }
+  }
+
+  llvm::legacy::FunctionPassManager func_manager(templ->getParent());
+  func_manager.add(llvm::createSROAPass());
+  func_manager.add(llvm::createEarlyCSEPass());
+  func_manager.add(llvm::createInstructionCombiningPass());
+  func_manager.add(llvm::createCFGSimplificationPass());
+  func_manager.doInitialization();
+  func_manager.run(*templ);
+  func_manager.doFinalization();
+
+  if (templ->size() != 1u ||
+      !llvm::isa<llvm::ReturnInst>(templ->getEntryBlock().getTerminator())) {
+    templ->eraseFromParent();
+    return nullptr;
+  }
+
+  return templ;
+}
+
 }  // namespace
 
 InstructionLifter::Impl::Impl(const Arch *arch_,
-                              const IntrinsicTable *intrinsics_)
+                              const IntrinsicTable *intrinsics_,
+                              llvm::Module *semantics_module_)
     : arch(arch_),
       intrinsics(intrinsics_),
       word_type(
@@ -54,10 +149,11 @@ InstructionLifter::Impl::Impl(const Arch *arch_,
           remill::NthArgument(intrinsics->async_hyper_call,
                               remill::kMemoryPointerArgNum)->getType()),
       module(intrinsics->async_hyper_call->getParent()),
-      invalid_instruction(
-          GetInstructionFunction(module, kInvalidInstructionISelName)),
-      unsupported_instruction(
-          GetInstructionFunction(module, kUnsupportedInstructionISelName)) {
+      semantics_module(semantics_module_ ? semantics_module_ : module),
+      invalid_instruction(GetInstructionFunction(
+          semantics_module, kInvalidInstructionISelName)),
+      unsupported_instruction(GetInstructionFunction(
+          semantics_module, kUnsupportedInstructionISelName)) {
 
   CHECK(invalid_instruction != nullptr)
       << kInvalidInstructionISelName << " doesn't exist";
@@ -66,11 +162,56 @@ InstructionLifter::Impl::Impl(const Arch *arch_,
       << kUnsupportedInstructionISelName << " doesn't exist";
 }
 
+// Returns the pre-simplified template of the semantics function `isel_func`.
+// The function type of `isel_func` fixes the types of its operands, so there
+// is one template per semantics function.
+//
+// Templates live next to their semantics function, and are internal, so
+// optimizing that module (e.g. between batches of traces) deletes or changes
+// them. They are therefore found by name each time, and are re-created if
+// they've gone, or no longer match `isel_func`.
+llvm::Function *
+InstructionLifter::Impl::GetSemanticsTemplate(llvm::Function *isel_func) {
+
+  // A declaration of the semantics function in a thin module has no body to
+  // stamp in, and the real semantics live in another module.
+  if (isel_func->isDeclaration()) {
+    return nullptr;
+  }
+
+  const auto name = isel_func->getName().str();
+  if (semantics_without_templates.count(name)) {
+    return nullptr;
+  }
+
+  const auto templ_module = isel_func->getParent();
+  if (auto templ = templ_module->getFunction(name + kTemplateSuffix)) {
+    if (!templ->isDeclaration() &&
+        templ->getFunctionType() == isel_func->getFunctionType()) {
+      return templ;
+    }
+
+    // Clear the name so that the new template gets it.
+    templ->setName("");
+  }
+
+  auto templ = CreateSemanticsTemplate(isel_func);
+  if (!templ) {
+    semantics_without_templates.insert(name);
+  }
+  return templ;
+}
+
 InstructionLifter::~InstructionLifter(void) {}
 
 InstructionLifter::InstructionLifter(const Arch *arch_,
                                      const IntrinsicTable *intrinsics_)
-    : impl(new Impl(arch_, intrinsics_)) {}
+    : impl(new Impl(arch_, intrinsics_, nullptr)) {}
+
+InstructionLifter::InstructionLifter(const Arch *arch_,
+                                     const IntrinsicTable *intrinsics_,
+                                     llvm::Module *semantics_)
+    : impl(new Impl(arch_, intrinsics_, semantics_)) {}
 
 // Lift a single instruction into a basic block. `is_delayed` signifies that
 // this instruction will execute within the delay slot of another instruction.
@@ -87,11 +228,15 @@ LiftStatus InstructionLifter::LiftIntoBlock(Instruction &arch_inst,
                                             llvm::BasicBlock *block,
                                             llvm::Value *state_ptr,
                                             bool is_delayed) {
+  llvm::TimeTraceScope scope(
+      is_delayed ? "LiftDelayedInstruction" : "LiftInstruction",
+      [&](void) { return arch_inst.function; });
 
   llvm::Function *const func = block->getParent();
   llvm::Module *const module = func->getParent();
   llvm::Function *isel_func = nullptr;
   auto status = kLiftedInstruction;
+  auto is_atomic = arch_inst.is_atomic_read_modify_write;
 
   // Cache invalidation.
   if (func != impl->last_func) {
@@ -103,7 +248,17 @@ LiftStatus InstructionLifter::LiftIntoBlock(Instruction &arch_inst,
   }
 
   if (arch_inst.IsValid()) {
-    isel_func = GetInstructionFunction(module, arch_inst.function);
+    if (is_atomic && impl->direct_atomics) {
+      std::string atomic_function(kAtomicISelPrefix);
+      atomic_function += arch_inst.function;
+      isel_func =
+          GetInstructionFunction(impl->semantics_module, atomic_function);
+      is_atomic = !isel_func;
+    }
+    if (!isel_func) {
+      isel_func =
+          GetInstructionFunction(impl->semantics_module, arch_inst.function);
+    }
   } else {
     isel_func = impl->invalid_instruction;
     arch_inst.operands.clear();
@@ -116,6 +271,11 @@ LiftStatus InstructionLifter::LiftIntoBlock(Instruction &arch_inst,
     status = kLiftedUnsupportedInstruction;
   }
 
+  // When lifting into a thin module, call a declaration of the semantics
+  // function, which is looked up afresh each time because the linked
+  // semantics may have been optimized away since.
+  isel_func = DeclareSemanticsFunction(module, isel_func);
+
   llvm::IRBuilder<> ir(block);
   const auto mem_ptr_ref =
       LoadRegAddress(block, state_ptr, kMemoryVariableName);
@@ -152,7 +312,7 @@ LiftStatus InstructionLifter::LiftIntoBlock(Instruction &arch_inst,
   }
 
   // Begin an atomic block.
-  if (arch_inst.is_atomic_read_modify_write) {
+  if (is_atomic) {
     llvm::Value *temp_args[] = {
         ir.CreateLoad(impl->memory_ptr_type, mem_ptr_ref)};
     ir.CreateStore(ir.CreateCall(impl->intrinsics->atomic_begin, temp_args),
@@ -193,10 +353,21 @@ LiftStatus InstructionLifter::LiftIntoBlock(Instruction &arch_inst,
   args[0] = ir.CreateLoad(impl->memory_ptr_type, mem_ptr_ref);
 
   // Call the function that implements the instruction semantics.
-  ir.CreateStore(ir.CreateCall(isel_func, args), mem_ptr_ref);
+  auto isel_call = ir.CreateCall(isel_func, args);
+  ir.CreateStore(isel_call, mem_ptr_ref);
+
+  // Stamp in the body of the semantics function. The template has a single
+  // block, so this doesn't split `block`.
+  if (impl->inline_semantics) {
+    if (auto templ = impl->GetSemanticsTemplate(isel_func)) {
+      isel_call->setCalledFunction(templ);
+      llvm::InlineFunctionInfo info;
+      llvm::InlineFunction(*isel_call, info);
+    }
+  }
 
   // End an atomic block.
-  if (arch_inst.is_atomic_read_modify_write) {
+  if (is_atomic) {
     llvm::Value *temp_args[] = {
         ir.CreateLoad(impl->memory_ptr_type, mem_ptr_ref)};
     ir.CreateStore(ir.CreateCall(impl->intrinsics->atomic_end, temp_args),
@@ -260,6 +431,15 @@ InstructionLifter::LoadRegAddress(llvm::BasicBlock *block,
   // indexing instructions so that they always follow the definition of the
   // state pointer, and thus are most likely to dominate all future uses.
   if (auto reg = impl->arch->RegisterByName(reg_name_)) {
+
+    // The address of a register in a register window depends on the current
+    // window, so it's recomputed at every use.
+    if (auto reg_ptr =
+            impl->arch->WindowedRegisterAddress(block, state_ptr, reg)) {
+      impl->reg_ptr_cache.erase(reg_ptr_it);
+      return reg_ptr;
+    }
+
     llvm::Value *reg_ptr = nullptr;
 
     // The state pointer is an argument.
@@ -322,6 +502,16 @@ void InstructionLifter::ClearCache(void) const {
   impl->last_func = nullptr;
 }
 
+// Lift atomic instructions using their `ATOMIC_` semantics, if any.
+void InstructionLifter::SetDirectAtomics(bool enable) {
+  impl->direct_atomics = enable;
+}
+
+// Stamp in the pre-simplified bodies of semantics functions.
+void InstructionLifter::SetInlineSemantics(bool enable) {
+  impl->inline_semantics = enable;
+}
+
 // Load the value of a register.
 llvm::Value *InstructionLifter::LoadRegValue(llvm::BasicBlock *block,
                                              llvm::Value *state_ptr,
@@ -21,6 +21,7 @@
 #include <llvm/IR/DataLayout.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/InstIterator.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/IntrinsicInst.h>
 #include <llvm/IR/LegacyPassManager.h>
@@ -28,7 +29,10 @@
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Operator.h>
 #include <llvm/IR/Type.h>
+#include <llvm/Pass.h>
+#include <llvm/Support/TimeProfiler.h>
 #include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/InstCombine/InstCombine.h>
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 #include <llvm/Transforms/Utils/ValueMapper.h>
@@ -40,6 +44,7 @@
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -56,7 +61,13 @@ namespace remill {
 
 class InstructionLifter::Impl {
  public:
-  Impl(const Arch *arch_, const IntrinsicTable *intrinsics_);
+  Impl(const Arch *arch_, const IntrinsicTable *intrinsics_,
+       llvm::Module *semantics_module_);
+
+  // Returns the pre-simplified template of the semantics function `isel_func`,
+  // creating it if needed, or `nullptr` if the semantics function should be
+  // called instead.
+  llvm::Function *GetSemanticsTemplate(llvm::Function *isel_func);
 
   // Architecture being used for lifting.
   const Arch *const arch;
@@ -78,8 +89,25 @@ class InstructionLifter::Impl {
   llvm::Function *last_func{nullptr};
 
   llvm::Module *const module;
+
+  // Module in which the semantics functions are looked up. This is `module`
+  // unless lifting into a thin module.
+  llvm::Module *const semantics_module;
+
   llvm::Function *const invalid_instruction;
   llvm::Function *const unsupported_instruction;
+
+  // Should atomic instructions be lifted using their `ATOMIC_` semantics?
+  bool direct_atomics{false};
+
+  // Should the bodies of the semantics functions be stamped into the lifted
+  // blocks, instead of being called?
+  bool inline_semantics{false};
+
+  // Names of the semantics functions that have no usable template. The
+  // templates themselves are looked up by name in the module of their
+  // semantics function, because optimizing that module can delete them.
+  std::unordered_set<std::string> semantics_without_templates;
 };
 
 }  // namespace remill
@@ -103,6 +103,15 @@ IntrinsicTable::IntrinsicTable(llvm::Module *module)
       write_memory_f128(
           FindPureIntrinsic(module, "__remill_write_memory_f128")),
 
+      // Bulk memory access.
+      memory_copy(FindPureIntrinsic(module, "__remill_memory_copy")),
+      memory_fill_8(FindPureIntrinsic(module, "__remill_memory_fill_8")),
+      memory_fill_16(FindPureIntrinsic(module, "__remill_memory_fill_16")),
+      memory_fill_32(FindPureIntrinsic(module, "__remill_memory_fill_32")),
+      memory_fill_64(FindPureIntrinsic(module, "__remill_memory_fill_64")),
+      memory_compare(SetMemoryReadNone(
+          FindPureIntrinsic(module, "__remill_memory_compare"))),
+
       // Memory barriers.
       barrier_load_load(
           FindPureIntrinsic(module, "__remill_barrier_load_load")),
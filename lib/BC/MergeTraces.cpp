@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glog/logging.h>
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/Transforms/Utils/FunctionComparator.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "remill/BC/Optimizer.h"
+
+namespace remill {
+namespace {
+
+// Returns `true` if `func` can be merged with a structurally identical trace.
+static bool IsMergeableTrace(llvm::Function *func) {
+  return func && !func->isDeclaration() && !func->isInterposable() &&
+         !func->hasAvailableExternallyLinkage() && !func->isVarArg();
+}
+
+// Replace the body of `func` with a tail call to `canonical`, which has the
+// same function type. `func` keeps its name and linkage, so that anything
+// looking up the trace, e.g. by its address, still finds it.
+static void MakeThunk(llvm::Function *func, llvm::Function *canonical) {
+  const auto linkage = func->getLinkage();
+  func->deleteBody();
+  func->setLinkage(linkage);
+
+  std::vector<llvm::Value *> args;
+  for (auto &arg : func->args()) {
+    args.push_back(&arg);
+  }
+
+  llvm::IRBuilder<> ir(
+      llvm::BasicBlock::Create(func->getContext(), "", func));
+  auto call = ir.CreateCall(canonical, args);
+  call->setCallingConv(canonical->getCallingConv());
+  call->setTailCallKind(llvm::CallInst::TCK_Tail);
+  if (func->getReturnType()->isVoidTy()) {
+    ir.CreateRetVoid();
+  } else {
+    ir.CreateRet(call);
+  }
+}
+
+}  // namespace
+
+// Merge the structurally identical traces among `traces`.
+unsigned MergeIdenticalTraces(const std::vector<llvm::Function *> &traces) {
+  llvm::GlobalNumberState global_numbers;
+  std::unordered_map<llvm::FunctionComparator::FunctionHash,
+                     std::vector<llvm::Function *>>
+      canonicals;
+
+  unsigned num_merged = 0;
+  for (auto func : traces) {
+    if (!IsMergeableTrace(func)) {
+      continue;
+    }
+
+    // The hash only looks at the types and opcodes of instructions, so traces
+    // that hash the same still need to be compared in full.
+    auto &same_hash = canonicals[llvm::FunctionComparator::functionHash(*func)];
+    llvm::Function *canonical = nullptr;
+    for (auto other : same_hash) {
+      if (other == func) {
+        canonical = func;
+        break;
+      }
+      llvm::FunctionComparator comparator(func, other, &global_numbers);
+      if (!comparator.compare()) {
+        canonical = other;
+        break;
+      }
+    }
+
+    if (!canonical) {
+      same_hash.push_back(func);
+      continue;
+    } else if (canonical == func) {
+      continue;
+    }
+
+    func->replaceAllUsesWith(canonical);
+    MakeThunk(func, canonical);
+    ++num_merged;
+  }
+
+  DLOG_IF(INFO, num_merged)
+      << "Merged " << num_merged << " structurally identical traces";
+
+  return num_merged;
+}
+
+}  // namespace remill
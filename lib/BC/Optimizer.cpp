@@ -18,17 +18,26 @@
 
 #include <glog/logging.h>
 #include <llvm/ADT/Triple.h>
+#include <llvm/Analysis/AliasAnalysis.h>
+#include <llvm/Analysis/MemoryLocation.h>
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/DataLayout.h>
 #include <llvm/IR/DebugInfo.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Metadata.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Type.h>
+#include <llvm/IR/ValueHandle.h>
+#include <llvm/Pass.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/TimeProfiler.h>
+#include <llvm/Support/Timer.h>
+#include <llvm/Support/raw_ostream.h>
 #include <llvm/Transforms/IPO.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
 #include <llvm/Transforms/Scalar.h>
@@ -36,16 +45,268 @@
 #include <llvm/Transforms/Utils/Local.h>
 #include <llvm/Transforms/Utils/ValueMapper.h>
 
+#include <chrono>
+
 #include "remill/Arch/Arch.h"
+#include "remill/BC/ABI.h"
 #include "remill/BC/Compat/ScalarTransforms.h"
 #include "remill/BC/Compat/TargetLibraryInfo.h"
 #include "remill/BC/Util.h"
+#include "remill/BC/Version.h"
+
+#include "AliasAnalysis.h"
 
 namespace remill {
+namespace {
+
+// Returns `true` if `func` has a profiled entry count below `threshold`.
+static bool IsColdTrace(llvm::Function *func, uint64_t threshold) {
+  if (!threshold) {
+    return false;
+  }
+  auto entry_count = func->getEntryCount();
+  return entry_count && entry_count->getCount() < threshold;
+}
+
+// Returns a pass that adds `RemillAAResult` to the alias analyses used by
+// the passes that follow it.
+static llvm::ImmutablePass *CreateRemillAAWrapperPass(const Arch *arch) {
+  auto result = std::make_shared<RemillAAResult>(arch);
+  return llvm::createExternalAAWrapperPass(
+      [result](llvm::Pass &, llvm::Function &, llvm::AAResults &aa_results) {
+        aa_results.addAAResult(*result);
+      });
+}
+
+// The memory read intrinsics that return the value that they read, and so
+// can be replaced by a constant.
+static const char *const kFoldableMemoryReads[] = {
+    "__remill_read_memory_8",   "__remill_read_memory_16",
+    "__remill_read_memory_32",  "__remill_read_memory_64",
+    "__remill_read_memory_f32", "__remill_read_memory_f64",
+};
+
+// Upper bound on the number of times that a trace is re-optimized because
+// folding constant memory reads exposed new constant addresses, e.g. when
+// reading through a pointer in a vtable.
+static constexpr unsigned kMaxConstantMemoryRounds = 4;
+
+// Run `pass`, and add the wall time that it took, in seconds, to
+// `seconds[name]`, unless `seconds` is `nullptr`. Returns what `pass` returns.
+template <typename T>
+static auto TimePass(std::map<std::string, double> *seconds, const char *name,
+                     T pass) {
+  const auto start = std::chrono::steady_clock::now();
+  auto ret = pass();
+  if (seconds) {
+    const auto end = std::chrono::steady_clock::now();
+    (*seconds)[name] += std::chrono::duration<double>(end - start).count();
+  }
+  return ret;
+}
+
+// Run `pipeline` with LLVM's pass timers (as in `-time-passes`) enabled, and
+// add the wall time that each LLVM pass took, in seconds, to
+// `seconds[pass_name]`, unless `seconds` is `nullptr`. Passes that run more
+// than once are summed. Returns what `pipeline` returns.
+template <typename T>
+static auto TimeLLVMPasses(std::map<std::string, double> *seconds,
+                           T pipeline) {
+  if (!seconds) {
+    return pipeline();
+  }
+
+  const auto was_enabled = llvm::TimePassesIsEnabled;
+  llvm::TimePassesIsEnabled = true;
+  auto ret = pipeline();
+  llvm::TimePassesIsEnabled = was_enabled;
+
+  // The timers are only readable as JSON, with one `"time.pass.<name>.wall":
+  // <seconds>` entry per line. They're cleared afterwards so that the next
+  // run starts from zero, and so that LLVM doesn't print a report on exit.
+  std::string json;
+  llvm::raw_string_ostream os(json);
+  llvm::TimerGroup::printAllJSONValues(os, "");
+  os.flush();
+  llvm::TimerGroup::clearAll();
+
+  llvm::StringRef lines(json);
+  while (!lines.empty()) {
+    llvm::StringRef line;
+    std::tie(line, lines) = lines.split('\n');
+    line = line.trim().rtrim(',');
+
+    auto [key, value] = line.split(": ");
+    double pass_seconds = 0;
+    if (key.consume_front("\"time.pass.") && key.consume_back(".wall\"") &&
+        !key.empty() && !value.getAsDouble(pass_seconds)) {
+      (*seconds)[key.str()] += pass_seconds;
+    }
+  }
+
+  return ret;
+}
+
+// Upper bound on the number of rounds of inlining `alwaysinline` callees, i.e.
+// semantics functions, into a trace that the pipelines will leave alone.
+static constexpr unsigned kMaxSemanticsInlineRounds = 8;
+
+// Inline the calls to `alwaysinline` functions, i.e. to semantics functions,
+// in `func`. This is normally left to the module pipeline's inliner.
+static void InlineSemanticsCalls(llvm::Function *func) {
+  for (auto round = 0u; round < kMaxSemanticsInlineRounds; ++round) {
+    std::vector<llvm::CallBase *> calls;
+    for (auto &inst : llvm::instructions(func)) {
+      if (auto call = llvm::dyn_cast<llvm::CallBase>(&inst)) {
+        auto callee = call->getCalledFunction();
+        if (callee && callee != func && !callee->isDeclaration() &&
+            callee->hasFnAttribute(llvm::Attribute::AlwaysInline)) {
+          calls.push_back(call);
+        }
+      }
+    }
+
+    if (calls.empty()) {
+      break;
+    }
+
+    for (auto call : calls) {
+      llvm::InlineFunctionInfo info;
+      llvm::InlineFunction(*call, info);
+    }
+  }
+}
+
+// Keep the module pipeline from optimizing `func` any further, after inlining
+// the semantics functions that it would have otherwise inlined.
+static void ExcludeFromModulePipeline(llvm::Function *func) {
+  InlineSemanticsCalls(func);
+  func->removeFnAttr(llvm::Attribute::AlwaysInline);
+  func->removeFnAttr(llvm::Attribute::OptimizeForSize);
+  func->removeFnAttr(llvm::Attribute::MinSize);
+  func->addFnAttr(llvm::Attribute::NoInline);
+  func->addFnAttr(llvm::Attribute::OptimizeNone);
+}
+
+// Returns the number of calls to memory read and write intrinsics in `func`.
+static uint64_t CountMemoryIntrinsics(llvm::Function *func) {
+  uint64_t num_calls = 0;
+  for (auto &inst : llvm::instructions(func)) {
+    if (auto call = llvm::dyn_cast<llvm::CallInst>(&inst)) {
+      if (auto callee = call->getCalledFunction()) {
+        const auto name = callee->getName();
+        if (name.startswith("__remill_read_memory_") ||
+            name.startswith("__remill_write_memory_")) {
+          ++num_calls;
+        }
+      }
+    }
+  }
+  return num_calls;
+}
+
+}  // namespace
+
+// Replace the memory read intrinsic calls in `func` whose addresses are
+// constants, and whose bytes `read_constant_memory` returns, with the values
+// that they read. Returns the number of folded reads.
+unsigned
+FoldConstantMemoryReads(llvm::Function *func,
+                        const ConstantMemoryReader &read_constant_memory) {
+  const auto module = func->getParent();
+  const auto little_endian = module->getDataLayout().isLittleEndian();
+
+  std::unordered_set<llvm::Function *> read_funcs;
+  for (auto read_func_name : kFoldableMemoryReads) {
+    if (auto read_func = module->getFunction(read_func_name)) {
+      read_funcs.insert(read_func);
+    }
+  }
+
+  std::vector<llvm::CallInst *> reads;
+  for (auto &inst : llvm::instructions(func)) {
+    if (auto call = llvm::dyn_cast<llvm::CallInst>(&inst)) {
+      if (read_funcs.count(call->getCalledFunction()) &&
+          llvm::isa<llvm::ConstantInt>(call->getArgOperand(1))) {
+        reads.push_back(call);
+      }
+    }
+  }
+
+  unsigned num_folded = 0;
+  uint8_t bytes[8] = {};
+  for (auto call : reads) {
+    const auto addr =
+        llvm::cast<llvm::ConstantInt>(call->getArgOperand(1))->getZExtValue();
+    const auto type = call->getType();
+    const auto size_bits = type->getScalarSizeInBits();
+    const auto size = size_bits / 8u;
+    if (!read_constant_memory(addr, size, bytes)) {
+      continue;
+    }
+
+    uint64_t val = 0;
+    for (auto i = 0u; i < size; ++i) {
+      val = (val << 8u) | bytes[little_endian ? (size - i - 1u) : i];
+    }
+
+    llvm::Constant *const_val = llvm::ConstantInt::get(
+        llvm::Type::getIntNTy(func->getContext(), size_bits), val);
+    if (!type->isIntegerTy()) {
+      const_val = llvm::ConstantExpr::getBitCast(const_val, type);
+    }
+
+    call->replaceAllUsesWith(const_val);
+    call->eraseFromParent();
+    ++num_folded;
+  }
+
+  return num_folded;
+}
+
+// Write out `stats` as a JSON object.
+void WriteOptimizationStats(const OptimizationStats &stats,
+                            llvm::raw_ostream &os) {
+  auto passes_to_json = [](const std::map<std::string, double> &seconds) {
+    llvm::json::Object passes;
+    for (const auto &[name, pass_seconds] : seconds) {
+      passes[name] = pass_seconds;
+    }
+    return passes;
+  };
+
+  llvm::json::Array traces;
+  for (const auto &[name, trace] : stats.traces) {
+    traces.push_back(llvm::json::Object{
+        {"name", name},
+        {"decoded_insts", static_cast<int64_t>(trace.num_decoded_insts)},
+        {"ir_insts_before", static_cast<int64_t>(trace.num_ir_insts_before)},
+        {"ir_insts_after", static_cast<int64_t>(trace.num_ir_insts_after)},
+        {"memory_intrinsics_before",
+         static_cast<int64_t>(trace.num_memory_intrinsics_before)},
+        {"memory_intrinsics_after",
+         static_cast<int64_t>(trace.num_memory_intrinsics_after)},
+        {"pass_seconds", passes_to_json(trace.pass_seconds)},
+        {"llvm_pass_seconds", passes_to_json(trace.llvm_pass_seconds)},
+    });
+    if (!trace.demotion.empty()) {
+      traces.back().getAsObject()->try_emplace("demotion", trace.demotion);
+    }
+  }
+
+  llvm::json::OStream json(os, 2);
+  json.value(llvm::json::Object{
+      {"pass_seconds", passes_to_json(stats.pass_seconds)},
+      {"llvm_pass_seconds", passes_to_json(stats.llvm_pass_seconds)},
+      {"traces", std::move(traces)},
+  });
+  os << '\n';
+}
 
 void OptimizeModule(const remill::Arch *arch, llvm::Module *module,
                     std::function<llvm::Function *(void)> generator,
                     OptimizationGuide guide) {
+  llvm::TimeTraceScope scope("OptimizeModule");
 
   llvm::legacy::FunctionPassManager func_manager(module);
   llvm::legacy::PassManager module_manager;
@@ -71,20 +332,224 @@ void OptimizeModule(const remill::Arch *arch, llvm::Module *module,
   // TODO(pag): Not sure when this became available.
   IF_LLVM_GTE_800(builder.MergeFunctions = false;)
 
+  func_manager.add(CreateRemillAAWrapperPass(arch));
+  module_manager.add(CreateRemillAAWrapperPass(arch));
+
   builder.populateFunctionPassManager(func_manager);
   builder.populateModulePassManager(module_manager);
+
+  // Cold traces get a cheap function pipeline, and are marked as cold and
+  // optimized for size so that the module pipeline doesn't inline into, or
+  // unroll loops within, them. Big traces get the same cheap pipeline, and
+  // are then kept out of the module pipeline altogether.
+  llvm::legacy::FunctionPassManager cold_func_manager(module);
+  if (guide.cold_entry_count || guide.cheap_trace_ir_insts) {
+    auto cold_TLI = new llvm::TargetLibraryInfoImpl(
+        llvm::Triple(module->getTargetTriple()));
+    cold_TLI->disableAllFunctions();  // `-fno-builtin`.
+
+    llvm::PassManagerBuilder cold_builder;
+    cold_builder.OptLevel = 1;
+    cold_builder.SizeLevel = 1;
+    cold_builder.LibraryInfo = cold_TLI;
+    cold_builder.DisableUnrollLoops = true;
+    cold_builder.SLPVectorize = false;
+    cold_builder.LoopVectorize = false;
+    cold_func_manager.add(CreateRemillAAWrapperPass(arch));
+    cold_builder.populateFunctionPassManager(cold_func_manager);
+  }
+
+  // The module pipeline can delete traces, e.g. unused internal ones, so
+  // traces are tracked through weak handles until they're merged, and their
+  // statistics are finished.
+  std::vector<std::pair<llvm::WeakVH, TraceStats *>> traces;
+  auto module_seconds = guide.stats ? &(guide.stats->pass_seconds) : nullptr;
+  auto module_llvm_seconds =
+      guide.stats ? &(guide.stats->llvm_pass_seconds) : nullptr;
+
+  // The statistics, the trace budgets, and the passes that rewrite memory
+  // accesses all work on traces with their semantics functions inlined.
+  const auto inline_semantics_first =
+      guide.stats || guide.unoptimized_trace_ir_insts ||
+      guide.cheap_trace_ir_insts || guide.promote_stack_frames ||
+      guide.coalesce_memory_accesses || guide.read_constant_memory;
+
   func_manager.doInitialization();
+  cold_func_manager.doInitialization();
   llvm::Function *func = nullptr;
   while (nullptr != (func = generator())) {
-    func_manager.run(*func);
+    llvm::TimeTraceScope trace_scope(
+        "OptimizeTrace", [=](void) { return func->getName().str(); });
+
+    TraceStats *stats = nullptr;
+    std::map<std::string, double> *seconds = nullptr;
+    std::map<std::string, double> *llvm_seconds = nullptr;
+    if (guide.stats) {
+      stats = &(guide.stats->traces[func->getName().str()]);
+      seconds = &(stats->pass_seconds);
+      llvm_seconds = &(stats->llvm_pass_seconds);
+    }
+
+    // The lifted code is mostly calls to semantics functions, so it's only
+    // worth measuring, or rewriting with the passes below, once they've been
+    // inlined. Otherwise, this is left to the module pipeline's inliner and
+    // its cost model.
+    if (inline_semantics_first) {
+      TimePass(seconds, "inline_semantics", [=](void) {
+        InlineSemanticsCalls(func);
+        return true;
+      });
+    }
+
+    const auto num_ir_insts = func->getInstructionCount();
+    if (stats) {
+      stats->num_ir_insts_before = num_ir_insts;
+      stats->num_memory_intrinsics_before = CountMemoryIntrinsics(func);
+    }
+
+    if (guide.merge_traces || guide.stats) {
+      traces.emplace_back(func, stats);
+    }
+
+    // Report that `func` is optimized less than it would normally be.
+    auto demote = [=](const char *demotion) {
+      LOG(WARNING) << "Trace " << func->getName().str() << " with "
+                   << num_ir_insts << " instructions was demoted: "
+                   << demotion;
+      if (stats) {
+        stats->demotion = demotion;
+      }
+    };
+
+    // Huge traces only get their semantics functions inlined.
+    if (guide.unoptimized_trace_ir_insts &&
+        num_ir_insts > guide.unoptimized_trace_ir_insts) {
+      demote("unoptimized");
+      ExcludeFromModulePipeline(func);
+      continue;
+    }
+
+    auto manager = &func_manager;
+    auto is_cheap = false;
+    if (IsColdTrace(func, guide.cold_entry_count)) {
+      func->addFnAttr(llvm::Attribute::Cold);
+      func->addFnAttr(llvm::Attribute::OptimizeForSize);
+      manager = &cold_func_manager;
+
+    } else if (guide.cheap_trace_ir_insts &&
+               num_ir_insts > guide.cheap_trace_ir_insts) {
+      demote("cheap_pipeline");
+      func->addFnAttr(llvm::Attribute::OptimizeForSize);
+      manager = &cold_func_manager;
+      is_cheap = true;
+    }
+
+    // How long the last run of the function pipeline over `func` took.
+    std::chrono::steady_clock::duration last_pipeline_time{};
+    auto run_function_pipeline = [&](void) {
+      const auto pipeline_start = std::chrono::steady_clock::now();
+      const auto changed = TimeLLVMPasses(llvm_seconds, [&](void) {
+        return TimePass(seconds, "function_pipeline",
+                        [=](void) { return manager->run(*func); });
+      });
+      last_pipeline_time = std::chrono::steady_clock::now() - pipeline_start;
+      return changed;
+    };
+
+    // A pass can't be interrupted, so a trace that goes over its time budget
+    // is only stopped from being optimized again. `reserve` is time that is
+    // still needed on top of what has been spent so far.
+    const auto start = std::chrono::steady_clock::now();
+    auto within_budget = [&](std::chrono::steady_clock::duration reserve =
+                                 std::chrono::steady_clock::duration::zero()) {
+      return !guide.trace_time_budget_ms ||
+             (std::chrono::steady_clock::now() - start) + reserve <
+                 std::chrono::milliseconds(guide.trace_time_budget_ms);
+    };
+
+    run_function_pipeline();
+
+    // Stack accesses are only at constant offsets from the entry stack pointer
+    // once the trace has been optimized.
+    if (guide.promote_stack_frames && within_budget() &&
+        TimePass(seconds, "promote_stack_frames",
+                 [=](void) { return PromoteStackFrame(arch, func); })) {
+      run_function_pipeline();
+    }
+
+    // Likewise, adjacent accesses only have the same base address once the
+    // trace has been optimized.
+    if (guide.coalesce_memory_accesses && within_budget() &&
+        TimePass(seconds, "coalesce_memory_accesses",
+                 [=](void) { return CoalesceMemoryAccesses(arch, func); })) {
+      run_function_pipeline();
+    }
+
+    // Reads of constant memory only have constant addresses once the trace
+    // has been optimized. Folding them can then expose more constants, e.g.
+    // jump table entries, so optimize the trace again.
+    if (guide.read_constant_memory) {
+      for (auto round = 0u; round < kMaxConstantMemoryRounds; ++round) {
+        if (!within_budget() ||
+            !TimePass(seconds, "fold_constant_memory", [&](void) {
+              return FoldConstantMemoryReads(func, guide.read_constant_memory);
+            })) {
+          break;
+        }
+        run_function_pipeline();
+      }
+    }
+
+    // The module pipeline can't be interrupted either, and it runs at least
+    // the function passes over `func` again, so a trace that can't afford
+    // another run of its function pipeline is kept out of it. Cheap traces
+    // are big, and so are always kept out of the expensive module pipeline.
+    if (!within_budget(last_pipeline_time)) {
+      demote("time_budget");
+      ExcludeFromModulePipeline(func);
+
+    } else if (is_cheap) {
+      ExcludeFromModulePipeline(func);
+    }
   }
+  cold_func_manager.doFinalization();
   func_manager.doFinalization();
-  module_manager.run(*module);
+  TimeLLVMPasses(module_llvm_seconds, [&](void) {
+    return TimePass(module_seconds, "module_pipeline", [&](void) {
+      llvm::TimeTraceScope module_scope("OptimizeModulePipeline");
+      return module_manager.run(*module);
+    });
+  });
+
+  std::vector<llvm::Function *> live_traces;
+  for (auto &[trace, stats] : traces) {
+    if (auto trace_func = llvm::dyn_cast_or_null<llvm::Function>(trace)) {
+      live_traces.push_back(trace_func);
+    }
+  }
+
+  // Traces are only structurally identical once they're fully optimized.
+  if (guide.merge_traces) {
+    TimePass(module_seconds, "merge_traces", [&](void) {
+      llvm::TimeTraceScope merge_scope("MergeIdenticalTraces");
+      return MergeIdenticalTraces(live_traces);
+    });
+  }
+
+  if (guide.stats) {
+    for (auto &[trace, stats] : traces) {
+      if (auto trace_func = llvm::dyn_cast_or_null<llvm::Function>(trace)) {
+        stats->num_ir_insts_after = trace_func->getInstructionCount();
+        stats->num_memory_intrinsics_after = CountMemoryIntrinsics(trace_func);
+      }
+    }
+  }
 }
 
 // Optimize a normal module. This might not contain special Remill-specific
 // intrinsics functions like `__remill_jump`, etc.
 void OptimizeBareModule(llvm::Module *module, OptimizationGuide guide) {
+  llvm::TimeTraceScope scope("OptimizeBareModule");
   llvm::legacy::FunctionPassManager func_manager(module);
   llvm::legacy::PassManager module_manager;
 
@@ -111,12 +576,25 @@ void OptimizeBareModule(llvm::Module *module, OptimizationGuide guide) {
 
   builder.populateFunctionPassManager(func_manager);
   builder.populateModulePassManager(module_manager);
+
+  // The functions of a bare module aren't traces, so the time of each pipeline,
+  // and of each LLVM pass, is only recorded for the whole module.
+  auto seconds = guide.stats ? &(guide.stats->pass_seconds) : nullptr;
+  auto llvm_seconds = guide.stats ? &(guide.stats->llvm_pass_seconds) : nullptr;
   func_manager.doInitialization();
-  for (auto &func : *module) {
-    func_manager.run(func);
-  }
+  TimeLLVMPasses(llvm_seconds, [&](void) {
+    return TimePass(seconds, "bare_function_pipeline", [&](void) {
+      for (auto &func : *module) {
+        func_manager.run(func);
+      }
+      return true;
+    });
+  });
   func_manager.doFinalization();
-  module_manager.run(*module);
+  TimeLLVMPasses(llvm_seconds, [&](void) {
+    return TimePass(seconds, "bare_module_pipeline",
+                    [&](void) { return module_manager.run(*module); });
+  });
 }
 
 }  // namespace remill
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "remill/BC/Profile.h"
+
+#include <glog/logging.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <ostream>
+#include <sstream>
+
+namespace remill {
+
+// Parse a decimal or `0x`-prefixed hexadecimal number.
+static bool ParseNumber(llvm::StringRef str, uint64_t &val) {
+  return !str.getAsInteger(0, val);
+}
+
+void ExecutionProfile::AddBlockCount(uint64_t addr, uint64_t count) {
+  block_counts[addr] += count;
+}
+
+void ExecutionProfile::AddEdgeCount(uint64_t from_addr, uint64_t to_addr,
+                                    uint64_t count) {
+  edge_counts[{from_addr, to_addr}] += count;
+}
+
+uint64_t ExecutionProfile::BlockCount(uint64_t addr) const {
+  auto it = block_counts.find(addr);
+  return it != block_counts.end() ? it->second : 0;
+}
+
+uint64_t ExecutionProfile::EdgeCount(uint64_t from_addr,
+                                     uint64_t to_addr) const {
+  auto it = edge_counts.find({from_addr, to_addr});
+  return it != edge_counts.end() ? it->second : 0;
+}
+
+// Parse a textual profile, adding its counts to this profile.
+bool ExecutionProfile::Parse(std::string_view text, std::string &error) {
+  llvm::SmallVector<llvm::StringRef, 4> fields;
+  llvm::StringRef rest(text.data(), text.size());
+  for (unsigned line_num = 1; !rest.empty(); ++line_num) {
+    llvm::StringRef line;
+    std::tie(line, rest) = rest.split('\n');
+    line = line.trim();
+    if (line.empty() || line.startswith("#")) {
+      continue;
+    }
+
+    fields.clear();
+    line.split(fields, ' ', -1, false);
+
+    uint64_t from_addr = 0;
+    uint64_t to_addr = 0;
+    uint64_t count = 0;
+    if (fields.size() == 3 && fields[0] == "block" &&
+        ParseNumber(fields[1], from_addr) && ParseNumber(fields[2], count)) {
+      AddBlockCount(from_addr, count);
+
+    } else if (fields.size() == 4 && fields[0] == "edge" &&
+               ParseNumber(fields[1], from_addr) &&
+               ParseNumber(fields[2], to_addr) &&
+               ParseNumber(fields[3], count)) {
+      AddEdgeCount(from_addr, to_addr, count);
+
+    } else {
+      std::stringstream ss;
+      ss << "Malformed profile entry on line " << line_num << ": "
+         << line.str();
+      error = ss.str();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Load a textual execution profile from a file.
+std::unique_ptr<ExecutionProfile>
+LoadExecutionProfileFromFile(std::filesystem::path file_name) {
+  auto buff = llvm::MemoryBuffer::getFile(file_name.string());
+  if (!buff) {
+    LOG(ERROR) << "Unable to read profile file " << file_name << ": "
+               << buff.getError().message();
+    return {};
+  }
+
+  std::string error;
+  auto text = (*buff)->getBuffer();
+  auto profile = std::make_unique<ExecutionProfile>();
+  if (!profile->Parse(std::string_view(text.data(), text.size()), error)) {
+    LOG(ERROR) << "Unable to parse profile file " << file_name << ": "
+               << error;
+    return {};
+  }
+
+  return profile;
+}
+
+// Write the gathered block execution counts as a textual execution profile.
+void WriteBlockCounts(std::ostream &os, const uint64_t *block_pcs,
+                      const uint64_t *block_counts, uint64_t num_blocks) {
+  const auto flags = os.flags();
+  for (uint64_t i = 0; i < num_blocks; ++i) {
+    if (block_counts[i]) {
+      os << "block 0x" << std::hex << block_pcs[i] << ' ' << std::dec
+         << block_counts[i] << '\n';
+    }
+  }
+  os.flags(flags);
+}
+
+}  // namespace remill
@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glog/logging.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/DataLayout.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Operator.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "remill/Arch/Arch.h"
+#include "remill/BC/ABI.h"
+#include "remill/BC/Optimizer.h"
+#include "remill/BC/Util.h"
+
+namespace remill {
+namespace {
+
+// The memory read and write intrinsics whose accesses can be promoted.
+static const char *const kPromotableMemoryReads[] = {
+    "__remill_read_memory_8",   "__remill_read_memory_16",
+    "__remill_read_memory_32",  "__remill_read_memory_64",
+    "__remill_read_memory_f32", "__remill_read_memory_f64",
+};
+
+static const char *const kPromotableMemoryWrites[] = {
+    "__remill_write_memory_8",   "__remill_write_memory_16",
+    "__remill_write_memory_32",  "__remill_write_memory_64",
+    "__remill_write_memory_f32", "__remill_write_memory_f64",
+};
+
+// An access to the stack, `offset` bytes away from the value of the stack
+// pointer on entry to the lifted function.
+struct StackAccess {
+  llvm::CallInst *call;
+  int64_t offset;
+  uint64_t size;
+  bool is_write;
+};
+
+class StackFramePromoter {
+ public:
+  StackFramePromoter(const Arch *arch, llvm::Function *func_);
+
+  // Returns `false` if the stack pointer, or the stack, might escape.
+  bool Analyze(void);
+
+  // Turns the accesses below the entry stack pointer into accesses to an
+  // `alloca`. Returns the number of promoted accesses.
+  unsigned Promote(void);
+
+ private:
+  // Returns `true` if every read below the entry stack pointer is dominated
+  // by a write of the same bytes.
+  bool FrameIsWrittenBeforeRead(void) const;
+
+  bool AnalyzeStateAccesses(void);
+  bool AnalyzeStackPointerUses(void);
+  bool AnalyzeCalls(void);
+
+  // Returns `true` if the byte range `[offset, offset + size)` of the `State`
+  // overlaps the stack pointer register.
+  bool OverlapsStackPointer(int64_t offset, uint64_t size) const;
+
+  llvm::Function *const func;
+  const llvm::DataLayout &dl;
+  const Register *sp_reg{nullptr};
+  const Register *sp_enclosing_reg{nullptr};
+
+  std::unordered_set<llvm::Function *> read_funcs;
+  std::unordered_set<llvm::Function *> write_funcs;
+  llvm::Function *func_return{nullptr};
+
+  // The load of the stack pointer on entry to `func`.
+  llvm::LoadInst *entry_sp{nullptr};
+
+  // Stores of new values to the stack pointer register.
+  std::vector<llvm::StoreInst *> sp_stores;
+
+  std::vector<StackAccess> accesses;
+};
+
+StackFramePromoter::StackFramePromoter(const Arch *arch, llvm::Function *func_)
+    : func(func_),
+      dl(func->getParent()->getDataLayout()) {
+  sp_reg = arch->RegisterByName(arch->StackPointerRegisterName());
+  if (sp_reg) {
+    sp_enclosing_reg = sp_reg->EnclosingRegister();
+  }
+
+  const auto module = func->getParent();
+  for (auto name : kPromotableMemoryReads) {
+    if (auto read_func = module->getFunction(name)) {
+      read_funcs.insert(read_func);
+    }
+  }
+  for (auto name : kPromotableMemoryWrites) {
+    if (auto write_func = module->getFunction(name)) {
+      write_funcs.insert(write_func);
+    }
+  }
+  func_return = module->getFunction("__remill_function_return");
+}
+
+bool StackFramePromoter::OverlapsStackPointer(int64_t offset,
+                                              uint64_t size) const {
+  const auto begin = static_cast<int64_t>(sp_enclosing_reg->offset);
+  const auto end = begin + static_cast<int64_t>(sp_enclosing_reg->size);
+  return offset < end && begin < offset + static_cast<int64_t>(size);
+}
+
+// Find the load of the entry stack pointer, and make sure that nothing else
+// reads the stack pointer register, and that the `State` pointer itself
+// doesn't escape, other than to the calls checked by `AnalyzeCalls`.
+bool StackFramePromoter::AnalyzeStateAccesses(void) {
+  const auto state_ptr = NthArgument(func, kStatePointerArgNum);
+  std::vector<std::pair<llvm::Value *, int64_t>> work_list;
+  work_list.emplace_back(state_ptr, 0);
+
+  while (!work_list.empty()) {
+    const auto [ptr, offset] = work_list.back();
+    work_list.pop_back();
+
+    for (auto user : ptr->users()) {
+      if (auto gep = llvm::dyn_cast<llvm::GEPOperator>(user)) {
+        llvm::APInt gep_offset(dl.getPointerSizeInBits(0), 0, true);
+        if (gep->getPointerOperand() != ptr ||
+            !gep->accumulateConstantOffset(dl, gep_offset)) {
+          return false;
+        }
+        work_list.emplace_back(gep, offset + gep_offset.getSExtValue());
+
+      } else if (auto bc = llvm::dyn_cast<llvm::BitCastOperator>(user)) {
+        work_list.emplace_back(bc, offset);
+
+      } else if (auto load = llvm::dyn_cast<llvm::LoadInst>(user)) {
+        const auto size = dl.getTypeStoreSize(load->getType());
+        if (!OverlapsStackPointer(offset, size)) {
+          continue;
+        }
+
+        // There can only be one read of the stack pointer, and it has to be
+        // the whole thing.
+        if (entry_sp || load->isVolatile() ||
+            offset != static_cast<int64_t>(sp_reg->offset) ||
+            size != sp_reg->size || !load->getType()->isIntegerTy()) {
+          return false;
+        }
+        entry_sp = load;
+
+      } else if (auto store = llvm::dyn_cast<llvm::StoreInst>(user)) {
+        if (store->getValueOperand() == ptr) {
+          return false;  // The `State` pointer escapes.
+        }
+        const auto size =
+            dl.getTypeStoreSize(store->getValueOperand()->getType());
+        if (!OverlapsStackPointer(offset, size)) {
+          continue;
+        }
+        if (store->isVolatile() ||
+            offset != static_cast<int64_t>(sp_reg->offset) ||
+            size != sp_reg->size) {
+          return false;
+        }
+        sp_stores.push_back(store);
+
+      // Calls are checked by `AnalyzeCalls`.
+      } else if (!llvm::isa<llvm::CallInst>(user)) {
+        return false;
+      }
+    }
+  }
+
+  if (!entry_sp || entry_sp->getParent() != &func->getEntryBlock()) {
+    return false;
+  }
+
+  // The entry stack pointer must be read before it is ever written.
+  for (auto store : sp_stores) {
+    if (store->getParent() == entry_sp->getParent() &&
+        store->comesBefore(entry_sp)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Find all of the stack accesses, which must be at constant offsets from
+// the entry stack pointer. The only other things that can be done with the
+// stack pointer are to compute new constant offsets from it, and to write
+// them back into the stack pointer register.
+bool StackFramePromoter::AnalyzeStackPointerUses(void) {
+  std::unordered_map<llvm::Value *, int64_t> sp_offsets;
+  std::vector<llvm::Value *> work_list;
+  sp_offsets.emplace(entry_sp, 0);
+  work_list.push_back(entry_sp);
+
+  std::unordered_set<llvm::StoreInst *> allowed_stores(sp_stores.begin(),
+                                                       sp_stores.end());
+
+  while (!work_list.empty()) {
+    const auto val = work_list.back();
+    work_list.pop_back();
+    const auto offset = sp_offsets[val];
+
+    for (auto user : val->users()) {
+      if (auto binop = llvm::dyn_cast<llvm::BinaryOperator>(user)) {
+        const auto other_op = binop->getOperand(0) == val
+                                  ? binop->getOperand(1)
+                                  : binop->getOperand(0);
+        const auto const_op = llvm::dyn_cast<llvm::ConstantInt>(other_op);
+        if (!const_op) {
+          return false;
+        }
+
+        int64_t new_offset = 0;
+        if (binop->getOpcode() == llvm::Instruction::Add) {
+          new_offset = offset + const_op->getSExtValue();
+        } else if (binop->getOpcode() == llvm::Instruction::Sub &&
+                   binop->getOperand(0) == val) {
+          new_offset = offset - const_op->getSExtValue();
+        } else {
+          return false;
+        }
+
+        auto [it, added] = sp_offsets.emplace(binop, new_offset);
+        if (added) {
+          work_list.push_back(binop);
+        } else if (it->second != new_offset) {
+          return false;
+        }
+
+      } else if (auto call = llvm::dyn_cast<llvm::CallInst>(user)) {
+        const auto callee = call->getCalledFunction();
+        const auto is_read = read_funcs.count(callee);
+        const auto is_write = write_funcs.count(callee);
+        if ((!is_read && !is_write) || call->getArgOperand(1) != val ||
+            (is_write && call->getArgOperand(2) == val)) {
+          return false;
+        }
+
+        auto &access = accesses.emplace_back();
+        access.call = call;
+        access.offset = offset;
+        access.is_write = is_write;
+        access.size = dl.getTypeStoreSize(
+            is_write ? call->getArgOperand(2)->getType() : call->getType());
+
+      } else if (auto store = llvm::dyn_cast<llvm::StoreInst>(user)) {
+        if (!allowed_stores.count(store) || store->getValueOperand() != val) {
+          return false;
+        }
+
+      } else {
+        return false;
+      }
+    }
+  }
+
+  // Every new value of the stack pointer register has to be a known offset
+  // from the entry stack pointer.
+  for (auto store : sp_stores) {
+    if (!sp_offsets.count(store->getValueOperand())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Calls can observe the stack, e.g. by reading stack-passed arguments, and
+// so the only calls allowed are to the memory access intrinsics, to
+// `__remill_function_return`, which ends the lifetime of the frame, and to
+// functions that don't access memory, e.g. flag computation intrinsics.
+bool StackFramePromoter::AnalyzeCalls(void) {
+  for (auto &inst : llvm::instructions(func)) {
+    if (auto call = llvm::dyn_cast<llvm::CallInst>(&inst)) {
+      const auto callee = call->getCalledFunction();
+      if (!callee) {
+        return false;
+      } else if (callee == func_return || read_funcs.count(callee) ||
+                 write_funcs.count(callee) || call->doesNotAccessMemory()) {
+        continue;
+      } else {
+        return false;
+      }
+    } else if (llvm::isa<llvm::CallBase>(inst)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool StackFramePromoter::Analyze(void) {
+  if (!sp_reg || !sp_enclosing_reg || func->isDeclaration() ||
+      func->arg_size() <= kStatePointerArgNum) {
+    return false;
+  }
+  return AnalyzeCalls() && AnalyzeStateAccesses() &&
+         AnalyzeStackPointerUses();
+}
+
+// The frame starts out as an uninitialized `alloca`, which is only right if
+// nothing below the entry stack pointer is live on entry. That isn't so for
+// a trace reached through `__remill_jump`, e.g. a jump table target, or a
+// block in the middle of a leaf function that uses the red zone, which can
+// read slots written before the trace was entered.
+bool StackFramePromoter::FrameIsWrittenBeforeRead(void) const {
+  llvm::DominatorTree dt(*func);
+  for (const auto &read : accesses) {
+    if (read.is_write || 0 <= read.offset) {
+      continue;
+    }
+    const auto is_written = std::any_of(
+        accesses.begin(), accesses.end(), [&](const StackAccess &write) {
+          return write.is_write && write.offset == read.offset &&
+                 write.size == read.size && dt.dominates(write.call, read.call);
+        });
+    if (!is_written) {
+      return false;
+    }
+  }
+  return true;
+}
+
+unsigned StackFramePromoter::Promote(void) {
+
+  // Only the accesses entirely below the entry stack pointer are to the
+  // function's own frame. The rest are to the return address, arguments,
+  // and the caller's frame. An access straddling both means we've
+  // misunderstood something.
+  int64_t min_offset = 0;
+  for (const auto &access : accesses) {
+    const auto end = access.offset + static_cast<int64_t>(access.size);
+    if (access.offset < 0 && 0 < end) {
+      return 0;
+    }
+    min_offset = std::min(min_offset, access.offset);
+  }
+
+  if (!min_offset || !FrameIsWrittenBeforeRead()) {
+    return 0;
+  }
+
+  auto &context = func->getContext();
+  const auto frame_size = static_cast<uint64_t>(-min_offset);
+  const auto u8 = llvm::Type::getInt8Ty(context);
+  const auto frame_type = llvm::ArrayType::get(u8, frame_size);
+
+  auto &entry_block = func->getEntryBlock();
+  llvm::IRBuilder<> ir(&entry_block, entry_block.getFirstInsertionPt());
+  const auto frame = ir.CreateAlloca(frame_type, nullptr, "STACK_FRAME");
+  frame->setAlignment(llvm::Align(16));
+
+  unsigned num_promoted = 0;
+  for (const auto &access : accesses) {
+    if (0 <= access.offset) {
+      continue;
+    }
+
+    ir.SetInsertPoint(access.call);
+    const auto byte_ptr =
+        ir.CreateConstInBoundsGEP2_32(frame_type, frame, 0,
+                                      static_cast<unsigned>(
+                                          access.offset - min_offset));
+
+    const auto mem_ptr = access.call->getArgOperand(0);
+    if (access.is_write) {
+      const auto val = access.call->getArgOperand(2);
+      const auto ptr =
+          ir.CreateBitCast(byte_ptr, llvm::PointerType::get(val->getType(), 0));
+      ir.CreateStore(val, ptr)->setAlignment(llvm::Align(1));
+      access.call->replaceAllUsesWith(mem_ptr);
+    } else {
+      const auto type = access.call->getType();
+      const auto ptr =
+          ir.CreateBitCast(byte_ptr, llvm::PointerType::get(type, 0));
+      const auto load = ir.CreateLoad(type, ptr);
+      load->setAlignment(llvm::Align(1));
+      access.call->replaceAllUsesWith(load);
+    }
+
+    access.call->eraseFromParent();
+    ++num_promoted;
+  }
+
+  DLOG(INFO) << "Promoted " << num_promoted << " stack accesses to a "
+             << frame_size << "-byte frame in " << func->getName().str();
+
+  return num_promoted;
+}
+
+}  // namespace
+
+// Replace the memory accesses in the lifted function `func` that are to its
+// own stack frame with accesses to an `alloca`. Returns the number of
+// promoted accesses.
+unsigned PromoteStackFrame(const Arch *arch, llvm::Function *func) {
+  StackFramePromoter promoter(arch, func);
+  if (!promoter.Analyze()) {
+    return 0;
+  }
+  return promoter.Promote();
+}
+
+}  // namespace remill
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glog/logging.h>
+#include <llvm/ADT/StringSet.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalAlias.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Support/TimeProfiler.h>
+#include <llvm/Transforms/IPO/Internalize.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Utils/ValueMapper.h>
+
+#include <unordered_set>
+#include <vector>
+
+#include "remill/Arch/Arch.h"
+#include "remill/BC/Util.h"
+#include "remill/BC/Version.h"
+
+namespace remill {
+namespace {
+
+// Prefix of the names of the intrinsics, which are never linked in.
+static constexpr const char *kIntrinsicPrefix = "__remill_";
+
+// Call `need` on every global value that `val` references, looking through
+// constant expressions and aggregates.
+template <typename T>
+static void ForEachReferencedGlobal(const llvm::Constant *val, T need) {
+  std::vector<const llvm::Constant *> work_list = {val};
+  std::unordered_set<const llvm::Constant *> seen;
+  while (!work_list.empty()) {
+    auto c = work_list.back();
+    work_list.pop_back();
+    if (!seen.insert(c).second) {
+      continue;
+    }
+
+    if (auto gv = llvm::dyn_cast<llvm::GlobalValue>(c)) {
+      need(gv);
+      continue;
+    }
+
+    for (auto &op : c->operands()) {
+      if (auto op_c = llvm::dyn_cast<llvm::Constant>(op.get())) {
+        work_list.push_back(op_c);
+      }
+    }
+  }
+}
+
+// Create a global value in `module` with the same name, type, linkage, and
+// attributes as `gv`, but without a body, initializer, or aliasee.
+static llvm::GlobalValue *CreateEmptyCopy(const llvm::GlobalValue *gv,
+                                          llvm::Module *module) {
+  if (auto func = llvm::dyn_cast<llvm::Function>(gv)) {
+    auto new_func = llvm::Function::Create(
+        func->getFunctionType(), func->getLinkage(), func->getAddressSpace(),
+        func->getName(), module);
+    new_func->copyAttributesFrom(func);
+    return new_func;
+
+  } else if (auto var = llvm::dyn_cast<llvm::GlobalVariable>(gv)) {
+    auto new_var = new llvm::GlobalVariable(
+        *module, var->getValueType(), var->isConstant(), var->getLinkage(),
+        nullptr, var->getName(), nullptr, var->getThreadLocalMode(),
+        var->getType()->getAddressSpace());
+    new_var->copyAttributesFrom(var);
+    return new_var;
+
+  } else if (auto alias = llvm::dyn_cast<llvm::GlobalAlias>(gv)) {
+    auto new_alias = llvm::GlobalAlias::create(
+        alias->getValueType(), alias->getType()->getPointerAddressSpace(),
+        alias->getLinkage(), alias->getName(), module);
+    new_alias->copyAttributesFrom(alias);
+    return new_alias;
+  }
+
+  LOG(FATAL) << "Cannot link semantics global " << gv->getName().str();
+  return nullptr;
+}
+
+}  // namespace
+
+// Create an empty module for lifting into, which declares the intrinsics of
+// `semantics`.
+std::unique_ptr<llvm::Module> CreateThinModule(const Arch *arch,
+                                               llvm::Module *semantics,
+                                               std::string_view name) {
+  auto module = std::make_unique<llvm::Module>(
+      llvm::StringRef(name.data(), name.size()), semantics->getContext());
+  arch->PrepareModuleDataLayout(module.get());
+
+  for (auto &func : *semantics) {
+    if (!func.getName().startswith(kIntrinsicPrefix)) {
+      continue;
+    }
+
+    auto decl =
+        llvm::Function::Create(func.getFunctionType(),
+                               llvm::GlobalValue::ExternalLinkage,
+                               func.getAddressSpace(), func.getName(),
+                               module.get());
+    decl->setAttributes(func.getAttributes());
+    decl->setCallingConv(func.getCallingConv());
+  }
+
+  return module;
+}
+
+// Link into `module` the definitions from `semantics` of the functions that
+// `module` declares.
+unsigned LinkSemantics(llvm::Module *module, llvm::Module *semantics) {
+  llvm::TimeTraceScope scope("LinkSemantics");
+
+  // The semantics functions that `module` declares. These are linked by name,
+  // and so have to be externally visible in the copy of `semantics`.
+  std::vector<const llvm::GlobalValue *> declared;
+
+  // Everything in `semantics` that the declared semantics functions need,
+  // directly or indirectly. The intrinsics are left as declarations, which
+  // link against those of `module`. `referenced` also has the declarations,
+  // in the order in which they were found.
+  std::unordered_set<const llvm::GlobalValue *> needed;
+  std::unordered_set<const llvm::GlobalValue *> seen;
+  std::vector<const llvm::GlobalValue *> referenced;
+  std::vector<const llvm::GlobalValue *> work_list;
+  auto need = [&](const llvm::GlobalValue *gv) {
+    if (!seen.insert(gv).second) {
+      return;
+    }
+    referenced.push_back(gv);
+    if (!gv->isDeclaration() && !gv->getName().startswith(kIntrinsicPrefix)) {
+      needed.insert(gv);
+      work_list.push_back(gv);
+    }
+  };
+
+  for (auto &func : *module) {
+    if (!func.isDeclaration() || func.getName().startswith(kIntrinsicPrefix)) {
+      continue;
+    }
+    if (auto sem = semantics->getFunction(func.getName());
+        sem && !sem->isDeclaration()) {
+      declared.push_back(sem);
+      need(sem);
+    }
+  }
+
+  if (declared.empty()) {
+    return 0u;
+  }
+
+  while (!work_list.empty()) {
+    auto gv = work_list.back();
+    work_list.pop_back();
+
+    if (auto func = llvm::dyn_cast<llvm::Function>(gv)) {
+      if (func->hasPersonalityFn()) {
+        ForEachReferencedGlobal(func->getPersonalityFn(), need);
+      }
+      for (auto &inst : llvm::instructions(func)) {
+        for (auto &op : inst.operands()) {
+          if (auto c = llvm::dyn_cast<llvm::Constant>(op.get())) {
+            ForEachReferencedGlobal(c, need);
+          }
+        }
+      }
+
+    } else if (auto var = llvm::dyn_cast<llvm::GlobalVariable>(gv)) {
+      if (var->hasInitializer()) {
+        ForEachReferencedGlobal(var->getInitializer(), need);
+      }
+
+    } else if (auto alias = llvm::dyn_cast<llvm::GlobalAlias>(gv)) {
+      ForEachReferencedGlobal(alias->getAliasee(), need);
+    }
+  }
+
+  // Copy only what is needed into a new module, along with declarations of
+  // what that references, so that `semantics` itself is never modified, and
+  // so that nothing else in `semantics` is even declared.
+  auto needed_semantics = std::make_unique<llvm::Module>(
+      semantics->getModuleIdentifier(), semantics->getContext());
+  needed_semantics->setDataLayout(semantics->getDataLayout());
+  needed_semantics->setTargetTriple(semantics->getTargetTriple());
+
+  llvm::ValueToValueMapTy value_map;
+  for (auto gv : referenced) {
+    value_map[gv] = CreateEmptyCopy(gv, needed_semantics.get());
+  }
+
+  for (auto gv : referenced) {
+    if (!needed.count(gv)) {
+      continue;
+    }
+
+    if (auto func = llvm::dyn_cast<llvm::Function>(gv)) {
+      auto new_func = llvm::cast<llvm::Function>(value_map[func]);
+      auto new_arg = new_func->arg_begin();
+      for (auto &arg : func->args()) {
+        new_arg->setName(arg.getName());
+        value_map[&arg] = &*new_arg++;
+      }
+      llvm::SmallVector<llvm::ReturnInst *, 8> returns;
+      llvm::CloneFunctionInto(
+          new_func, func, value_map,
+          IF_LLVM_GTE_1300_(llvm::CloneFunctionChangeType::DifferentModule)
+              IF_LLVM_LT_1300_(true) returns);
+
+    } else if (auto var = llvm::dyn_cast<llvm::GlobalVariable>(gv)) {
+      auto new_var = llvm::cast<llvm::GlobalVariable>(value_map[var]);
+      new_var->setInitializer(
+          llvm::MapValue(var->getInitializer(), value_map));
+
+    } else if (auto alias = llvm::dyn_cast<llvm::GlobalAlias>(gv)) {
+      auto new_alias = llvm::cast<llvm::GlobalAlias>(value_map[alias]);
+      new_alias->setAliasee(llvm::MapValue(alias->getAliasee(), value_map));
+    }
+  }
+
+  for (auto sem : declared) {
+    auto copied_sem = llvm::cast<llvm::GlobalValue>(value_map[sem]);
+    if (copied_sem->hasLocalLinkage()) {
+      copied_sem->setLinkage(llvm::GlobalValue::ExternalLinkage);
+      copied_sem->setVisibility(llvm::GlobalValue::DefaultVisibility);
+    }
+  }
+
+  // Everything that gets linked in is internalized, so that it can be deleted
+  // once it's been inlined into the lifted code.
+  const auto failed = llvm::Linker::linkModules(
+      *module, std::move(needed_semantics), llvm::Linker::LinkOnlyNeeded,
+      [](llvm::Module &linked_module, const llvm::StringSet<> &linked_names) {
+        llvm::internalizeModule(
+            linked_module, [&](const llvm::GlobalValue &gv) {
+              return !gv.hasName() || !linked_names.count(gv.getName());
+            });
+      });
+
+  CHECK(!failed) << "Unable to link semantics into module "
+                 << ModuleName(module);
+
+  DLOG(INFO) << "Linked " << declared.size() << " semantics functions into "
+             << ModuleName(module);
+
+  return static_cast<unsigned>(declared.size());
+}
+
+}  // namespace remill
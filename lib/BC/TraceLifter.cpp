@@ -18,14 +18,22 @@
 
 #include <glog/logging.h>
 #include <llvm/IR/Instructions.h>
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/Support/TimeProfiler.h>
+#include <algorithm>
 #include <map>
+#include <queue>
 #include <set>
 #include <sstream>
+#include <unordered_map>
+#include <utility>
 
 #include "InstructionLifter.h"
 
 #include <remill/Arch/Instruction.h>
+#include <remill/Arch/InstructionIndex.h>
 #include <remill/BC/IntrinsicTable.h>
+#include <remill/BC/Profile.h>
 #include <remill/BC/Util.h>
 
 namespace remill {
@@ -44,6 +52,29 @@ llvm::Function *TraceManager::GetLiftedTraceDefinition(uint64_t) {
   return nullptr;
 }
 
+// Called when the trace starting at address `addr` has been invalidated.
+void TraceManager::ClearLiftedTraceDefinition(uint64_t, llvm::Function *) {}
+
+// Inlining of direct call targets is disabled by default.
+unsigned TraceManager::MaxInlinedCallInstructions(uint64_t) {
+  return 0;
+}
+
+// There is no execution profile by default.
+const ExecutionProfile *TraceManager::GetExecutionProfile(void) {
+  return nullptr;
+}
+
+// There is no instruction index by default.
+const InstructionIndex *TraceManager::GetInstructionIndex(void) {
+  return nullptr;
+}
+
+// No memory is known to be read-only by default.
+bool TraceManager::TryReadConstantMemory(uint64_t, uint64_t, uint8_t *) {
+  return false;
+}
+
 // Apply a callback that gives the decoder access to multiple virtual
 // targets of this instruction (indirect call or jump).
 void TraceManager::ForEachDevirtualizedTarget(
@@ -64,6 +95,37 @@ namespace {
 
 using DecoderWorkList = std::set<uint64_t>;  // For ordering.
 
+// Profiled execution count and address of a trace. The hottest trace comes
+// first, and ties go to the lowest address.
+using HotTrace = std::pair<uint64_t, uint64_t>;
+
+struct HotTraceOrder {
+  bool operator()(const HotTrace &a, const HotTrace &b) const {
+    return a.first < b.first || (a.first == b.first && a.second > b.second);
+  }
+};
+
+using HotTraceQueue =
+    std::priority_queue<HotTrace, std::vector<HotTrace>, HotTraceOrder>;
+
+// Half-open ranges, `[begin, end)`, of the bytes from which the instructions
+// of a trace were decoded.
+using ByteRanges = std::vector<std::pair<uint64_t, uint64_t>>;
+
+// Sort and merge overlapping or adjacent ranges.
+void CoalesceRanges(ByteRanges &ranges) {
+  std::sort(ranges.begin(), ranges.end());
+  auto out_it = ranges.begin();
+  for (auto it = ranges.begin(); it != ranges.end(); ++it) {
+    if (out_it != ranges.begin() && it->first <= (out_it - 1)->second) {
+      (out_it - 1)->second = std::max((out_it - 1)->second, it->second);
+    } else {
+      *out_it++ = *it;
+    }
+  }
+  ranges.erase(out_it, ranges.end());
+}
+
 }  // namespace
 
 class TraceLifter::Impl {
@@ -75,9 +137,32 @@ class TraceLifter::Impl {
   bool Lift(uint64_t addr,
             std::function<void(uint64_t, llvm::Function *)> callback);
 
+  // Invalidate every lifted trace decoded from bytes in `[addr, addr + size)`.
+  std::vector<uint64_t> Invalidate(uint64_t addr, uint64_t size);
+
   // Reads the bytes of an instruction at `addr` into `state.inst_bytes`.
   bool ReadInstructionBytes(uint64_t addr);
 
+  // Returns the index entry of the instruction at `addr`, if any.
+  const InstructionIndex::Entry *FindIndexEntry(uint64_t addr) const;
+
+  // Returns `true` if any of the bytes in `[addr, addr + size)` have been
+  // invalidated, and so may no longer match the index's copy of them.
+  bool IsInvalidated(uint64_t addr, uint64_t size) const;
+
+  // Decode the control flow of the instruction at `addr` into `info`. Indexed
+  // instructions aren't decoded again.
+  bool DecodeControlFlowAt(uint64_t addr, ControlFlowInfo &info);
+
+  // Fully decode the instruction at `addr` into `out`.
+  bool DecodeInstructionAt(uint64_t addr, Instruction &out);
+
+  // Try to lift the target of the direct function call `inst` into the
+  // current trace, in place of a call to the target's trace. Returns `false`
+  // if the target is too big, or not simple enough, to be inlined.
+  bool TryInlineDirectCall(uint64_t trace_addr, llvm::Value *state_ptr,
+                           ByteRanges &ranges);
+
   // Return an already lifted trace starting with the code at address
   // `addr`.
   //
@@ -102,12 +187,14 @@ class TraceLifter::Impl {
 
   llvm::BasicBlock *GetOrCreateBranchTakenBlock(void) {
     inst_work_list.insert(inst.branch_taken_pc);
+    block_leaders.insert(inst.branch_taken_pc);
     return GetOrCreateBlock(inst.branch_taken_pc);
   }
 
   llvm::BasicBlock *GetOrCreateBranchNotTakenBlock(void) {
     CHECK(inst.branch_not_taken_pc != 0);
     inst_work_list.insert(inst.branch_not_taken_pc);
+    block_leaders.insert(inst.branch_not_taken_pc);
     return GetOrCreateBlock(inst.branch_not_taken_pc);
   }
 
@@ -116,8 +203,35 @@ class TraceLifter::Impl {
     return GetOrCreateBlock(inst.next_pc);
   }
 
+  // Attach profiled branch weights to the conditional branch `br`, lifted
+  // from the instruction at `inst_pc`.
+  void AddBranchWeights(llvm::BranchInst *br, uint64_t inst_pc,
+                        uint64_t taken_pc, uint64_t not_taken_pc);
+
+  // Increment the execution counter of each guest block that starts in the
+  // trace at `trace_addr`.
+  void AddBlockCounters(uint64_t trace_addr);
+
+  // Add the trace at `trace_addr` to the traces to lift.
+  void PushTraceAddress(uint64_t trace_addr) {
+    if (trace_work_list.insert(trace_addr).second && profile) {
+      hot_traces.emplace(profile->BlockCount(trace_addr), trace_addr);
+    }
+  }
+
+  // Returns the next trace to lift. With a profile, this is the hottest
+  // trace, otherwise it is the trace with the lowest address.
   uint64_t PopTraceAddress(void) {
     auto trace_it = trace_work_list.begin();
+    if (profile) {
+
+      // Skip over queued traces that are no longer in the work list.
+      do {
+        CHECK(!hot_traces.empty());
+        trace_it = trace_work_list.find(hot_traces.top().second);
+        hot_traces.pop();
+      } while (trace_it == trace_work_list.end());
+    }
     const auto trace_addr = *trace_it;
     trace_work_list.erase(trace_it);
     return trace_addr;
@@ -138,6 +252,8 @@ class TraceLifter::Impl {
   llvm::Module *const module;
   const uint64_t addr_mask;
   TraceManager &manager;
+  const ExecutionProfile *profile;
+  const InstructionIndex *index;
 
   llvm::Function *func;
   llvm::BasicBlock *block;
@@ -148,7 +264,38 @@ class TraceLifter::Impl {
   Instruction delayed_inst;
   DecoderWorkList trace_work_list;
   DecoderWorkList inst_work_list;
+
+  // The traces in `trace_work_list`, hottest first, when there is a profile.
+  HotTraceQueue hot_traces;
   std::map<uint64_t, llvm::BasicBlock *> blocks;
+
+  // Addresses of the branch targets in the current trace, and of the
+  // instructions that have been decoded into it. The decoded ones among the
+  // branch targets, along with the trace head, start guest blocks.
+  std::set<uint64_t> block_leaders;
+  std::set<uint64_t> decoded_pcs;
+
+  // Should the executions of each lifted guest block be counted?
+  bool count_blocks{false};
+
+  // Address of each counted guest block, indexed by its counter ID, and the
+  // counter ID of each counted guest block.
+  std::vector<uint64_t> counted_block_pcs;
+  std::unordered_map<uint64_t, uint64_t> block_counter_ids;
+
+  // Bytes from which each trace lifted by this trace lifter was decoded.
+  std::map<uint64_t, ByteRanges> trace_ranges;
+
+  // Number of instructions decoded into each trace lifted by this trace
+  // lifter.
+  std::map<uint64_t, uint64_t> trace_num_insts;
+
+  // Traces that have been invalidated, but not yet re-lifted.
+  std::set<uint64_t> invalidated_traces;
+
+  // Every byte range that has been invalidated. The index's copies of these
+  // bytes, and its entries for the instructions decoded from them, are stale.
+  ByteRanges invalidated_ranges;
 };
 
 TraceLifter::Impl::Impl(InstructionLifter *inst_lifter_, TraceManager *manager_)
@@ -161,6 +308,8 @@ TraceLifter::Impl::Impl(InstructionLifter *inst_lifter_, TraceManager *manager_)
       addr_mask(arch->address_size >= 64 ? ~0ULL
                                          : (~0ULL >> arch->address_size)),
       manager(*manager_),
+      profile(nullptr),
+      index(nullptr),
       func(nullptr),
       block(nullptr),
       switch_inst(nullptr),
@@ -216,10 +365,300 @@ TraceLifter::TraceLifter(InstructionLifter *inst_lifter_,
 
 void TraceLifter::NullCallback(uint64_t, llvm::Function *) {}
 
+// Invalidate every trace decoded from bytes in `[addr, addr + size)`.
+std::vector<uint64_t> TraceLifter::Invalidate(uint64_t addr, uint64_t size) {
+  return impl->Invalidate(addr, size);
+}
+
+// Returns the number of instructions decoded into the trace at `addr`.
+uint64_t TraceLifter::NumDecodedInstructions(uint64_t addr) const {
+  auto it = impl->trace_num_insts.find(addr);
+  return it != impl->trace_num_insts.end() ? it->second : 0u;
+}
+
+// Count the executions of each lifted guest block.
+void TraceLifter::SetCountBlockExecutions(bool enable) {
+  impl->count_blocks = enable;
+}
+
+// Returns the address of each counted guest block, indexed by counter ID.
+const std::vector<uint64_t> &TraceLifter::CountedBlockAddresses(void) const {
+  return impl->counted_block_pcs;
+}
+
+// Invalidate every trace decoded from bytes in `[addr, addr + size)`.
+std::vector<uint64_t> TraceLifter::Impl::Invalidate(uint64_t addr,
+                                                    uint64_t size) {
+  std::vector<uint64_t> invalidated;
+  if (!size) {
+    return invalidated;
+  }
+
+  auto end = addr + size;
+  if (end < addr) {
+    end = ~0ULL;  // Overflow.
+  }
+
+  invalidated_ranges.emplace_back(addr, end);
+  CoalesceRanges(invalidated_ranges);
+
+  for (auto it = trace_ranges.begin(); it != trace_ranges.end();) {
+    const auto overlaps = std::any_of(
+        it->second.begin(), it->second.end(),
+        [=](const auto &range) {
+          return range.first < end && addr < range.second;
+        });
+
+    if (!overlaps) {
+      ++it;
+      continue;
+    }
+
+    const auto trace_addr = it->first;
+    it = trace_ranges.erase(it);
+    trace_num_insts.erase(trace_addr);
+    invalidated.push_back(trace_addr);
+    invalidated_traces.insert(trace_addr);
+
+    // Delete the body, but keep the function around as a declaration, so
+    // that direct callers of this trace don't need to be touched. The trace
+    // will be re-lifted into this same function.
+    auto trace_func = manager.GetLiftedTraceDefinition(trace_addr);
+    if (trace_func && trace_func->getParent() == module &&
+        !trace_func->isDeclaration()) {
+      trace_func->deleteBody();
+    }
+
+    manager.ClearLiftedTraceDefinition(trace_addr, trace_func);
+  }
+
+  // Cached register pointers may refer into deleted bodies.
+  if (!invalidated.empty()) {
+    inst_lifter.ClearCache();
+  }
+
+  return invalidated;
+}
+
+// Try to lift the target of the direct function call `inst` into the
+// current trace.
+bool TraceLifter::Impl::TryInlineDirectCall(uint64_t trace_addr,
+                                            llvm::Value *state_ptr,
+                                            ByteRanges &ranges) {
+  const auto target_pc = inst.branch_taken_pc;
+  const auto return_pc = inst.branch_not_taken_pc;
+
+  // Calls to the next instruction are used to get the program counter, and
+  // calls back to the head of this trace are recursive.
+  if (target_pc == return_pc || target_pc == trace_addr) {
+    return false;
+  }
+
+  const auto max_insts = manager.MaxInlinedCallInstructions(target_pc);
+  if (!max_insts) {
+    return false;
+  }
+
+  // Discover the whole callee up-front, so that we can give up before having
+  // added anything to the trace. Anything that would leave the callee other
+  // than by a return, including nested and recursive calls, prevents
+  // inlining. Most call targets are rejected here, so only their control
+  // flow is decoded.
+  std::set<uint64_t> callee_pcs;
+  DecoderWorkList callee_work_list;
+  callee_work_list.insert(target_pc);
+
+  while (!callee_work_list.empty()) {
+    const auto pc = *callee_work_list.begin();
+    callee_work_list.erase(callee_work_list.begin());
+    if (!callee_pcs.insert(pc).second) {
+      continue;
+    }
+
+    ControlFlowInfo info;
+    if (callee_pcs.size() > max_insts || !DecodeControlFlowAt(pc, info) ||
+        info.has_delay_slot) {
+      return false;
+    }
+
+    switch (info.category) {
+      case Instruction::kCategoryNormal:
+      case Instruction::kCategoryNoOp:
+        callee_work_list.insert(pc + info.size);
+        break;
+      case Instruction::kCategoryDirectJump:
+        callee_work_list.insert(info.branch_taken_pc);
+        break;
+      case Instruction::kCategoryConditionalBranch:
+        callee_work_list.insert(info.branch_taken_pc);
+        callee_work_list.insert(info.branch_not_taken_pc);
+        break;
+      case Instruction::kCategoryFunctionReturn: break;
+      default: return false;
+    }
+  }
+
+  // Fully decode the callee.
+  std::map<uint64_t, Instruction> callee_insts;
+  for (auto pc : callee_pcs) {
+    if (!DecodeInstructionAt(pc, callee_insts[pc])) {
+      return false;
+    }
+  }
+
+  DLOG(INFO) << "Inlining " << callee_insts.size()
+             << " instructions of call target " << std::hex << target_pc
+             << " into trace " << trace_addr << std::dec;
+
+  // The callee gets its own blocks, even if some of its instructions are
+  // also part of this trace, because they are reached with a different
+  // return address on the stack.
+  std::map<uint64_t, llvm::BasicBlock *> callee_blocks;
+  auto get_callee_block = [&](uint64_t pc) {
+    auto &callee_block = callee_blocks[pc];
+    if (!callee_block) {
+      callee_block = llvm::BasicBlock::Create(context, "", func);
+    }
+    return callee_block;
+  };
+
+  const auto return_block = GetOrCreateBranchNotTakenBlock();
+  llvm::BranchInst::Create(get_callee_block(target_pc), block);
+
+  for (auto &[pc, callee_inst] : callee_insts) {
+    ranges.emplace_back(pc, pc + callee_inst.NumBytes());
+
+    const auto callee_block = get_callee_block(pc);
+    const auto lift_status =
+        inst_lifter.LiftIntoBlock(callee_inst, callee_block, state_ptr);
+    if (kLiftedInstruction != lift_status) {
+      AddTerminatingTailCall(callee_block, intrinsics->error, *intrinsics);
+      continue;
+    }
+
+    switch (callee_inst.category) {
+      case Instruction::kCategoryDirectJump:
+        llvm::BranchInst::Create(
+            get_callee_block(callee_inst.branch_taken_pc), callee_block);
+        break;
+
+      case Instruction::kCategoryConditionalBranch:
+        AddBranchWeights(
+            llvm::BranchInst::Create(
+                get_callee_block(callee_inst.branch_taken_pc),
+                get_callee_block(callee_inst.branch_not_taken_pc),
+                LoadBranchTaken(callee_block), callee_block),
+            pc, callee_inst.branch_taken_pc, callee_inst.branch_not_taken_pc);
+        break;
+
+      // The callee only returns to the instruction after the call if it
+      // left the return address alone. Otherwise, return the normal way.
+      case Instruction::kCategoryFunctionReturn: {
+        auto next_pc = LoadNextProgramCounter(callee_block, *intrinsics);
+        auto ret_pc = llvm::ConstantInt::get(intrinsics->pc_type, return_pc);
+
+        llvm::IRBuilder<> ir(callee_block);
+        auto eq = ir.CreateICmpEQ(next_pc, ret_pc);
+        auto unexpected_ret_pc = llvm::BasicBlock::Create(context, "", func);
+        ir.CreateCondBr(eq, return_block, unexpected_ret_pc);
+        AddTerminatingTailCall(unexpected_ret_pc, intrinsics->function_return,
+                               *intrinsics);
+        break;
+      }
+
+      default:
+        llvm::BranchInst::Create(get_callee_block(callee_inst.next_pc),
+                                 callee_block);
+        break;
+    }
+  }
+
+  return true;
+}
+
+// Attach profiled branch weights to the conditional branch `br`.
+void TraceLifter::Impl::AddBranchWeights(llvm::BranchInst *br, uint64_t inst_pc,
+                                         uint64_t taken_pc,
+                                         uint64_t not_taken_pc) {
+  if (!profile) {
+    return;
+  }
+
+  // Prefer edge counts, but fall back on the counts of the targets.
+  auto taken = profile->EdgeCount(inst_pc, taken_pc);
+  auto not_taken = profile->EdgeCount(inst_pc, not_taken_pc);
+  if (!taken && !not_taken) {
+    taken = profile->BlockCount(taken_pc);
+    not_taken = profile->BlockCount(not_taken_pc);
+    if (!taken && !not_taken) {
+      return;
+    }
+  }
+
+  // Branch weights are 32 bits, so scale down big counts.
+  while (taken > UINT32_MAX || not_taken > UINT32_MAX) {
+    taken >>= 1;
+    not_taken >>= 1;
+  }
+
+  llvm::MDBuilder md(context);
+  br->setMetadata(llvm::LLVMContext::MD_prof,
+                  md.createBranchWeights(static_cast<uint32_t>(taken),
+                                         static_cast<uint32_t>(not_taken)));
+}
+
+// Increment the execution counter of each guest block that starts in the
+// trace at `trace_addr`. The counters aren't atomic, so concurrently executed
+// blocks may lose counts, but they are cheap enough to leave in optimized
+// code. The counter array is only declared here; its size isn't known until
+// all traces are lifted.
+void TraceLifter::Impl::AddBlockCounters(uint64_t trace_addr) {
+  const auto count_type = llvm::Type::getInt64Ty(context);
+  const llvm::StringRef counts_name(kBlockCountsVariableName.data(),
+                                    kBlockCountsVariableName.size());
+  auto counts = module->getNamedGlobal(counts_name);
+  if (!counts) {
+    counts = new llvm::GlobalVariable(
+        *module, llvm::ArrayType::get(count_type, 0), false,
+        llvm::GlobalValue::ExternalLinkage, nullptr, counts_name);
+  }
+
+  block_leaders.insert(trace_addr);
+  for (auto block_pc : block_leaders) {
+    if (!decoded_pcs.count(block_pc)) {
+      continue;
+    }
+
+    auto [id_it, added] =
+        block_counter_ids.emplace(block_pc, counted_block_pcs.size());
+    if (added) {
+      counted_block_pcs.push_back(block_pc);
+    }
+
+    auto block_head = blocks[block_pc];
+    llvm::IRBuilder<> ir(block_head, block_head->getFirstInsertionPt());
+    auto count_ptr = ir.CreateConstGEP2_64(counts->getValueType(), counts, 0,
+                                           id_it->second);
+    auto count = ir.CreateLoad(count_type, count_ptr);
+    ir.CreateStore(ir.CreateAdd(count, llvm::ConstantInt::get(count_type, 1)),
+                   count_ptr);
+  }
+}
+
 // Reads the bytes of an instruction at `addr` into `inst_bytes`.
 bool TraceLifter::Impl::ReadInstructionBytes(uint64_t addr) {
   inst_bytes.clear();
-  for (size_t i = 0; i < max_inst_bytes; ++i) {
+
+  // Bytes covered by the index don't need to go through the manager. This
+  // is also used for addresses that the linear sweep didn't find an
+  // instruction at, e.g. the targets of jumps into the middle of
+  // instructions. Invalidated bytes are read again from the manager.
+  if (index && index->Contains(addr) && !IsInvalidated(addr, max_inst_bytes)) {
+    const auto bytes = index->BytesAt(addr, max_inst_bytes);
+    inst_bytes.assign(bytes.data(), bytes.size());
+  }
+
+  for (size_t i = inst_bytes.size(); i < max_inst_bytes; ++i) {
     const auto byte_addr = (addr + i) & addr_mask;
     if (byte_addr < addr) {
       break;  // 32- or 64-bit address overflow.
@@ -235,6 +674,67 @@ bool TraceLifter::Impl::ReadInstructionBytes(uint64_t addr) {
   return !inst_bytes.empty();
 }
 
+// Returns the index entry of the instruction at `addr`, if any. Entries for
+// instructions with invalidated bytes are ignored.
+const InstructionIndex::Entry *
+TraceLifter::Impl::FindIndexEntry(uint64_t addr) const {
+  if (!index) {
+    return nullptr;
+  }
+  const auto entry = index->Find(addr);
+  if (entry && IsInvalidated(addr, entry->size)) {
+    return nullptr;
+  }
+  return entry;
+}
+
+// Returns `true` if any of the bytes in `[addr, addr + size)` have been
+// invalidated.
+bool TraceLifter::Impl::IsInvalidated(uint64_t addr, uint64_t size) const {
+  auto end = addr + size;
+  if (end < addr) {
+    end = ~0ULL;  // Overflow.
+  }
+
+  // The ranges are sorted and disjoint, so only the last range starting
+  // before `end` can overlap.
+  auto it = std::lower_bound(
+      invalidated_ranges.begin(), invalidated_ranges.end(), end,
+      [](const std::pair<uint64_t, uint64_t> &range, uint64_t range_end) {
+        return range.first < range_end;
+      });
+  return it != invalidated_ranges.begin() && addr < (it - 1)->second;
+}
+
+// Decode the control flow of the instruction at `addr` into `info`. The
+// index already summarizes the control flow of the instructions that it
+// found, so those don't need to be decoded at all.
+bool TraceLifter::Impl::DecodeControlFlowAt(uint64_t addr,
+                                            ControlFlowInfo &info) {
+  if (auto entry = FindIndexEntry(addr)) {
+    info.size = entry->size;
+    info.category = static_cast<Instruction::Category>(entry->category);
+    info.branch_taken_pc = entry->branch_taken_pc;
+    info.branch_not_taken_pc = entry->branch_not_taken_pc;
+    info.has_delay_slot = entry->has_delay_slot;
+    return true;
+  }
+
+  return ReadInstructionBytes(addr) &&
+         arch->DecodeControlFlow(addr, inst_bytes, info);
+}
+
+// Fully decode the instruction at `addr` into `out`. Only instructions that
+// are going to be lifted should be fully decoded.
+bool TraceLifter::Impl::DecodeInstructionAt(uint64_t addr, Instruction &out) {
+  if (auto entry = FindIndexEntry(addr)) {
+    return index->Materialize(arch, *entry, out);
+  }
+
+  return ReadInstructionBytes(addr) &&
+         arch->DecodeInstruction(addr, inst_bytes, out);
+}
+
 // Lift one or more traces starting from `addr`.
 bool TraceLifter::Lift(
     uint64_t addr, std::function<void(uint64_t, llvm::Function *)> callback) {
@@ -254,7 +754,10 @@ bool TraceLifter::Impl::Lift(
   // Reset the lifting state.
   trace_work_list.clear();
   inst_work_list.clear();
+  hot_traces = {};
   blocks.clear();
+  profile = manager.GetExecutionProfile();
+  index = manager.GetInstructionIndex();
   inst_bytes.clear();
   func = nullptr;
   switch_inst = nullptr;
@@ -274,21 +777,26 @@ bool TraceLifter::Impl::Lift(
     }
   };
 
-  trace_work_list.insert(addr);
+  PushTraceAddress(addr);
   while (!trace_work_list.empty()) {
     const auto trace_addr = PopTraceAddress();
 
-    // Already lifted.
+    // Already lifted, and not invalidated since.
     func = GetLiftedTraceDefinition(trace_addr);
-    if (func) {
+    if (func && !invalidated_traces.count(trace_addr)) {
       continue;
     }
 
     DLOG(INFO) << "Lifting trace at address " << std::hex << trace_addr
                << std::dec;
 
+    llvm::TimeTraceScope trace_scope(
+        "LiftTrace", [&](void) { return manager.TraceName(trace_addr); });
+
     func = get_trace_decl(trace_addr);
     blocks.clear();
+    block_leaders.clear();
+    decoded_pcs.clear();
     
     if (!func || !func->isDeclaration()) {
       func = arch->DeclareLiftedFunction(manager.TraceName(trace_addr), module);
@@ -301,6 +809,10 @@ bool TraceLifter::Impl::Lift(
     // of the trace.
     arch->InitializeEmptyLiftedFunction(func);
 
+    if (profile) {
+      func->setEntryCount(profile->BlockCount(trace_addr));
+    }
+
     auto state_ptr = NthArgument(func, kStatePointerArgNum);
 
     if (auto entry_block = &(func->front())) {
@@ -318,6 +830,9 @@ bool TraceLifter::Impl::Lift(
     CHECK(inst_work_list.empty());
     inst_work_list.insert(trace_addr);
 
+    auto &ranges = trace_ranges[trace_addr];
+    ranges.clear();
+
     // Decode instructions.
     while (!inst_work_list.empty()) {
       const auto inst_addr = PopInstructionAddress();
@@ -341,8 +856,12 @@ bool TraceLifter::Impl::Lift(
         }
       }
 
+      // Instructions found by the index are materialized from it, without
+      // reading their bytes again.
+      const auto entry = FindIndexEntry(inst_addr);
+
       // No executable bytes here.
-      if (!ReadInstructionBytes(inst_addr)) {
+      if (!entry && !ReadInstructionBytes(inst_addr)) {
         AddTerminatingTailCall(block, intrinsics->missing_block,
                                *intrinsics);
         continue;
@@ -350,7 +869,25 @@ bool TraceLifter::Impl::Lift(
 
       inst.Reset();
 
-      (void) arch->DecodeInstruction(inst_addr, inst_bytes, inst);
+      {
+        llvm::TimeTraceScope decode_scope("DecodeInstruction");
+        if (entry) {
+          (void) index->Materialize(arch, *entry, inst);
+        } else {
+          (void) arch->DecodeInstruction(inst_addr, inst_bytes, inst);
+        }
+      }
+
+      // If decoding failed, then conservatively assume that the instruction
+      // depends on every byte that we read.
+      uint64_t num_bytes = inst.NumBytes();
+      if (entry) {
+        num_bytes = entry->size;
+      } else if (!inst.IsValid()) {
+        num_bytes = inst_bytes.size();
+      }
+      ranges.emplace_back(inst_addr, inst_addr + num_bytes);
+      decoded_pcs.insert(inst_addr);
 
       auto lift_status = inst_lifter.LiftIntoBlock(inst, block, state_ptr);
       if (kLiftedInstruction != lift_status) {
@@ -361,6 +898,7 @@ bool TraceLifter::Impl::Lift(
       // Handle lifting a delayed instruction.
       auto try_delay = arch->MayHaveDelaySlot(inst);
       if (try_delay) {
+        llvm::TimeTraceScope decode_scope("DecodeDelayedInstruction");
         delayed_inst.Reset();
         if (!ReadInstructionBytes(inst.delayed_pc) ||
             !arch->DecodeDelayedInstruction(inst.delayed_pc, inst_bytes,
@@ -370,6 +908,9 @@ bool TraceLifter::Impl::Lift(
           AddTerminatingTailCall(block, intrinsics->error, *intrinsics);
           continue;
         }
+
+        ranges.emplace_back(inst.delayed_pc,
+                            inst.delayed_pc + delayed_inst.NumBytes());
       }
 
       // Functor used to add in a delayed instruction.
@@ -484,8 +1025,13 @@ bool TraceLifter::Impl::Lift(
         case Instruction::kCategoryDirectFunctionCall: {
         direct_func_call:
           try_add_delay_slot(true, block);
+          if (!try_delay &&
+              TryInlineDirectCall(trace_addr, state_ptr, ranges)) {
+            continue;
+          }
+
           if (inst.branch_not_taken_pc != inst.branch_taken_pc) {
-            trace_work_list.insert(inst.branch_taken_pc);
+            PushTraceAddress(inst.branch_taken_pc);
             auto target_trace = get_trace_decl(inst.branch_taken_pc);
             AddCall(block, target_trace, *intrinsics);
           }
@@ -524,7 +1070,7 @@ bool TraceLifter::Impl::Lift(
           llvm::BranchInst::Create(taken_block, not_taken_block,
                                    LoadBranchTaken(block), block);
 
-          trace_work_list.insert(inst.branch_taken_pc);
+          PushTraceAddress(inst.branch_taken_pc);
           auto target_trace = get_trace_decl(inst.branch_taken_pc);
 
           AddCall(taken_block, intrinsics->function_call, *intrinsics);
@@ -629,8 +1175,10 @@ bool TraceLifter::Impl::Lift(
             not_taken_block = new_not_taken_block;
           }
 
-          llvm::BranchInst::Create(taken_block, not_taken_block,
-                                   LoadBranchTaken(block), block);
+          AddBranchWeights(
+              llvm::BranchInst::Create(taken_block, not_taken_block,
+                                       LoadBranchTaken(block), block),
+              inst.pc, inst.branch_taken_pc, inst.branch_not_taken_pc);
           break;
         }
         case Instruction::kCategoryConditionalIndirectJump: {
@@ -668,11 +1216,61 @@ bool TraceLifter::Impl::Lift(
       }
     }
 
-    callback(trace_addr, func);
+    if (count_blocks) {
+      AddBlockCounters(trace_addr);
+    }
+
+    // There is one range per decoded instruction until they're coalesced.
+    trace_num_insts[trace_addr] = ranges.size();
+    CoalesceRanges(ranges);
+    invalidated_traces.erase(trace_addr);
+
     manager.SetLiftedTraceDefinition(trace_addr, func);
+    callback(trace_addr, func);
   }
 
   return true;
 }
 
+namespace {
+
+// Define the variable `name` as `init` in `module`, replacing any earlier
+// declaration or definition of it, e.g. one with a different array size.
+static void DefineBlockCounterVariable(llvm::Module *module,
+                                       std::string_view name_,
+                                       llvm::Constant *init, bool is_constant) {
+  const llvm::StringRef name(name_.data(), name_.size());
+  auto old_var = module->getNamedGlobal(name);
+  auto var = new llvm::GlobalVariable(*module, init->getType(), is_constant,
+                                      llvm::GlobalValue::ExternalLinkage, init,
+                                      name);
+  if (old_var) {
+    old_var->replaceAllUsesWith(
+        llvm::ConstantExpr::getBitCast(var, old_var->getType()));
+    var->takeName(old_var);
+    old_var->eraseFromParent();
+  }
+}
+
+}  // namespace
+
+// Define the block execution counters, and the table of the addresses of the
+// counted blocks.
+void DefineBlockCounters(llvm::Module *module,
+                         const std::vector<uint64_t> &block_pcs) {
+  auto &context = module->getContext();
+  const auto count_type = llvm::Type::getInt64Ty(context);
+  const auto counts_type = llvm::ArrayType::get(count_type, block_pcs.size());
+
+  DefineBlockCounterVariable(module, kBlockCountsVariableName,
+                             llvm::ConstantAggregateZero::get(counts_type),
+                             false);
+  DefineBlockCounterVariable(module, kBlockPCsVariableName,
+                             llvm::ConstantDataArray::get(context, block_pcs),
+                             true);
+  DefineBlockCounterVariable(
+      module, kNumBlockCountsVariableName,
+      llvm::ConstantInt::get(count_type, block_pcs.size()), true);
+}
+
 }  // namespace remill
@@ -42,6 +42,7 @@
 #include <llvm/IR/Module.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TimeProfiler.h>
 #include <llvm/Support/raw_ostream.h>
 
 #include "remill/Arch/Arch.h"
@@ -458,6 +459,8 @@ std::unique_ptr<llvm::Module> LoadModuleFromFile(llvm::LLVMContext *context,
 bool StoreModuleToFile(llvm::Module *module, std::string_view file_name,
                        bool allow_failure) {
   DLOG(INFO) << "Saving bitcode to file " << file_name;
+  llvm::TimeTraceScope scope("StoreModuleToFile",
+                             [=](void) { return std::string(file_name); });
 
   std::stringstream ss;
   ss << file_name << ".tmp." << nativeGetProcessID();
@@ -511,6 +514,7 @@ bool StoreModuleToFile(llvm::Module *module, std::string_view file_name,
 bool StoreModuleIRToFile(llvm::Module *module, std::string_view file_name_,
                          bool allow_failure) {
   std::string file_name(file_name_.data(), file_name_.size());
+  llvm::TimeTraceScope scope("StoreModuleIRToFile", file_name);
 #if LLVM_VERSION_NUMBER <= LLVM_VERSION(3, 5)
   std::string error;
   llvm::raw_fd_ostream dest(file_name.c_str(), error, llvm::sys::fs::F_Text);
@@ -1845,6 +1849,8 @@ unsigned ReplaceAllUsesOfConstant(llvm::Constant *old_c, llvm::Constant *new_c,
 //
 // TODO(pag): Make this work across distinct `llvm::LLVMContext`s.
 void MoveFunctionIntoModule(llvm::Function *func, llvm::Module *dest_module) {
+  llvm::TimeTraceScope scope("MoveFunctionIntoModule",
+                             [=](void) { return func->getName().str(); });
   const auto source_context = &(func->getContext());
   const auto dest_context = &(dest_module->getContext());
   CHECK_EQ(source_context, dest_context)
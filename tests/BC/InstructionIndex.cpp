@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <llvm/IR/LLVMContext.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "remill/Arch/Arch.h"
+#include "remill/Arch/Instruction.h"
+#include "remill/Arch/InstructionIndex.h"
+#include "remill/Arch/Name.h"
+#include "remill/OS/OS.h"
+
+namespace {
+
+static constexpr uint64_t kBaseAddress = 0x1000;
+
+// Variable-length amd64 instructions. The immediates decode as other
+// instructions, so sweeps that start in the middle of an instruction get
+// out of sync with the serial sweep.
+static const char kCode[] =
+    "\x48\xb8\x90\x05\x48\x89\xd8\xe8\x0f\x1f"  // movabs rax, imm64
+    "\x90"                                      // nop
+    "\x48\x89\xd8"                              // mov rax, rbx
+    "\xe8\x00\x00\x00\x00"                      // call next
+    "\x05\x48\xb8\xeb\x02"                      // add eax, imm32
+    "\x0f\x1f\x44\x00\x00"                      // nop dword [rax + rax]
+    "\xeb\x02"                                  // jmp +2
+    "\x74\x90"                                  // je -112
+    "\xc3";                                     // ret
+
+// Linear sweep `bytes` one instruction at a time.
+static std::vector<remill::InstructionIndex::Entry>
+SerialSweep(const remill::Arch *arch, std::string_view bytes) {
+  std::vector<remill::InstructionIndex::Entry> entries;
+  remill::ControlFlowInfo info;
+  for (uint64_t offset = 0; offset < bytes.size();) {
+    if (!arch->DecodeControlFlow(
+            kBaseAddress + offset,
+            bytes.substr(offset, arch->MaxInstructionSize()), info) ||
+        remill::Instruction::kCategoryInvalid == info.category || !info.size) {
+      offset += 1;
+      continue;
+    }
+
+    auto &entry = entries.emplace_back();
+    entry.branch_taken_pc = info.branch_taken_pc;
+    entry.branch_not_taken_pc = info.branch_not_taken_pc;
+    entry.offset = static_cast<uint32_t>(offset);
+    entry.size = static_cast<uint8_t>(info.size);
+    entry.category = static_cast<uint8_t>(info.category);
+    entry.has_delay_slot = info.has_delay_slot;
+    offset += info.size;
+  }
+  return entries;
+}
+
+// Indexing with chunks much smaller than an instruction finds the same
+// instructions as a serial sweep, no matter where the chunk boundaries fall.
+TEST(InstructionIndexTest, ChunksMatchSerialSweep) {
+  std::string bytes;
+  for (auto i = 0; i < 8; ++i) {
+    bytes.append(kCode, sizeof(kCode) - 1);
+  }
+
+  llvm::LLVMContext context;
+  const auto arch = remill::Arch::Get(context, "linux", "amd64");
+  ASSERT_NE(arch, nullptr);
+
+  const auto expected = SerialSweep(arch.get(), bytes);
+  ASSERT_FALSE(expected.empty());
+
+  for (auto num_threads : {1u, 2u, 7u, 16u, 64u}) {
+    SCOPED_TRACE(num_threads);
+    const auto index = remill::InstructionIndex::Build(
+        remill::kOSLinux, remill::kArchAMD64, kBaseAddress, bytes,
+        num_threads, 1u);
+    ASSERT_NE(index, nullptr);
+
+    const auto &entries = index->Entries();
+    ASSERT_EQ(entries.size(), expected.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+      EXPECT_EQ(entries[i].offset, expected[i].offset);
+      EXPECT_EQ(entries[i].size, expected[i].size);
+      EXPECT_EQ(entries[i].category, expected[i].category);
+      EXPECT_EQ(entries[i].branch_taken_pc, expected[i].branch_taken_pc);
+      EXPECT_EQ(entries[i].branch_not_taken_pc,
+                expected[i].branch_not_taken_pc);
+    }
+  }
+}
+
+}  // namespace
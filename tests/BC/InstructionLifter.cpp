@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "tests/BC/Test.h"
+
+namespace {
+
+using InstructionLifterTest = test::LifterTest;
+
+// Returns `true` if `func` directly calls a function whose name contains
+// `name`. Semantics functions have mangled names, hence the substring match.
+static bool CallsFunction(llvm::Function *func, const std::string &name) {
+  for (auto &inst : llvm::instructions(func)) {
+    if (auto call = llvm::dyn_cast<llvm::CallInst>(&inst)) {
+      auto callee = call->getCalledFunction();
+      if (callee && callee->getName().contains(name)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Returns `true` if `func`, or anything it calls, calls a function whose name
+// contains `name`.
+static bool TransitivelyCallsFunction(llvm::Function *func,
+                                      const std::string &name) {
+  std::unordered_set<llvm::Function *> seen;
+  std::vector<llvm::Function *> work_list = {func};
+  while (!work_list.empty()) {
+    auto caller = work_list.back();
+    work_list.pop_back();
+    if (!seen.insert(caller).second) {
+      continue;
+    }
+    if (CallsFunction(caller, name)) {
+      return true;
+    }
+    for (auto &inst : llvm::instructions(caller)) {
+      if (auto call = llvm::dyn_cast<llvm::CallInst>(&inst)) {
+        if (auto callee = call->getCalledFunction()) {
+          work_list.push_back(callee);
+        }
+      }
+    }
+  }
+  return false;
+}
+
+// By default, a `LOCK`-prefixed instruction is bracketed by the atomic
+// begin and end intrinsics.
+TEST_F(InstructionLifterTest, AtomicRegion) {
+  manager.SetBytes(0x1000, "\xf0\x01\x18\xc3");  // lock add [rax], ebx; ret
+  ASSERT_TRUE(trace_lifter.Lift(0x1000));
+
+  const auto trace = manager.traces[0x1000];
+  ASSERT_NE(trace, nullptr);
+  EXPECT_TRUE(CallsFunction(trace, "__remill_atomic_begin"));
+  EXPECT_TRUE(CallsFunction(trace, "__remill_atomic_end"));
+  EXPECT_FALSE(CallsFunction(trace, "ATOMIC_ADD"));
+}
+
+// With direct atomics, the same instruction is lifted with its `ATOMIC_`
+// semantics, which use the fetch-and-add intrinsic instead.
+TEST_F(InstructionLifterTest, DirectAtomics) {
+  inst_lifter.SetDirectAtomics(true);
+  manager.SetBytes(0x1000, "\xf0\x01\x18\xc3");  // lock add [rax], ebx; ret
+  ASSERT_TRUE(trace_lifter.Lift(0x1000));
+
+  const auto trace = manager.traces[0x1000];
+  ASSERT_NE(trace, nullptr);
+  EXPECT_TRUE(CallsFunction(trace, "ATOMIC_ADD"));
+  EXPECT_FALSE(CallsFunction(trace, "__remill_atomic_begin"));
+  EXPECT_FALSE(CallsFunction(trace, "__remill_atomic_end"));
+  EXPECT_TRUE(TransitivelyCallsFunction(trace, "__remill_fetch_and_add_32"));
+  EXPECT_FALSE(remill::VerifyModuleMsg(module.get()).has_value());
+}
+
+}  // namespace
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "remill/Arch/Arch.h"
+#include "remill/Arch/Instruction.h"
+#include "remill/Arch/InstructionStream.h"
+#include "remill/BC/Util.h"
+
+namespace {
+
+static constexpr uint64_t kBaseAddress = 0x1000;
+
+// mov rax, [rbx + rcx * 8 + 0x10]; add eax, 5; lea rdx, [rip + 0x100];
+// call next; ret
+static const char kAMD64Code[] =
+    "\x48\x8b\x44\xcb\x10\x83\xc0\x05\x48\x8d\x15\x00\x01\x00\x00"
+    "\xe8\x00\x00\x00\x00\xc3";
+
+// add x0, x1, x2, lsl #3; ldr x0, [x1, #8]; b.eq +8; ret
+static const char kAArch64Code[] =
+    "\x20\x0c\x02\x8b\x20\x04\x40\xf9\x40\x00\x00\x54\xc0\x03\x5f\xd6";
+
+// Describe everything about `inst` that the stream is meant to preserve.
+static std::string Describe(const remill::Instruction &inst) {
+  std::stringstream ss;
+  ss << inst.Serialize() << ' ' << inst.function << ' ' << inst.category
+     << ' ' << inst.next_pc << ' ' << inst.branch_taken_pc << ' '
+     << inst.branch_not_taken_pc << ' ' << inst.bytes.size();
+  for (const auto &op : inst.operands) {
+    ss << '\n' << op.Serialize();
+    if (op.expr) {
+      ss << " = " << op.expr->Serialize();
+    }
+  }
+  return ss.str();
+}
+
+// Returns the path of a new temporary file.
+static std::string TemporaryFile(void) {
+  llvm::SmallString<128> path;
+  EXPECT_FALSE(
+      llvm::sys::fs::createTemporaryFile("remill-test", "insts", path));
+  return path.str().str();
+}
+
+static std::string ReadFile(const std::string &path) {
+  std::ifstream is(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(is), {});
+}
+
+static void WriteFile(const std::string &path, std::string_view data) {
+  std::ofstream os(path, std::ios::binary | std::ios::trunc);
+  os.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+// Decode `code`, write the instructions to a stream, and check that reading
+// them back gives the same instructions.
+static void CheckRoundTrip(std::string_view arch_name, std::string_view code,
+                           size_t num_insts) {
+  llvm::LLVMContext context;
+  const auto arch = remill::Arch::Get(context, "linux", arch_name);
+  ASSERT_NE(arch, nullptr);
+  const auto semantics = remill::LoadArchSemantics(arch.get());
+  ASSERT_NE(semantics, nullptr);
+
+  remill::InstructionStreamWriter writer(arch->arch_name);
+  std::vector<std::string> expected;
+  remill::Instruction inst;
+  for (uint64_t offset = 0; offset < code.size();
+       offset += inst.bytes.size()) {
+    inst.Reset();
+    ASSERT_TRUE(arch->DecodeInstruction(
+        kBaseAddress + offset,
+        code.substr(offset, arch->MaxInstructionSize()), inst));
+    ASSERT_TRUE(writer.Add(inst));
+    expected.push_back(Describe(inst));
+  }
+  ASSERT_EQ(expected.size(), num_insts);
+
+  const auto path = TemporaryFile();
+  ASSERT_TRUE(writer.WriteToFile(path));
+  const auto stream = remill::InstructionStream::Open(path);
+  llvm::sys::fs::remove(path);
+
+  ASSERT_NE(stream, nullptr);
+  EXPECT_EQ(stream->GetArchName(), arch->arch_name);
+  ASSERT_EQ(stream->Size(), expected.size());
+
+  for (size_t i = 0; i < stream->Size(); ++i) {
+    ASSERT_TRUE(stream->Read(i, arch.get(), inst));
+    EXPECT_EQ(stream->Address(i), inst.pc);
+    EXPECT_EQ(Describe(inst), expected[i]);
+  }
+}
+
+TEST(InstructionStreamTest, RoundTripAMD64) {
+  CheckRoundTrip("amd64", std::string_view(kAMD64Code, sizeof(kAMD64Code) - 1),
+                 5u);
+}
+
+TEST(InstructionStreamTest, RoundTripAArch64) {
+  CheckRoundTrip("aarch64",
+                 std::string_view(kAArch64Code, sizeof(kAArch64Code) - 1),
+                 4u);
+}
+
+// Truncated streams, and streams written by another version of the format,
+// are rejected when they are opened.
+TEST(InstructionStreamTest, RejectBadStreams) {
+  llvm::LLVMContext context;
+  const auto arch = remill::Arch::Get(context, "linux", "amd64");
+  ASSERT_NE(arch, nullptr);
+  const auto semantics = remill::LoadArchSemantics(arch.get());
+  ASSERT_NE(semantics, nullptr);
+
+  remill::InstructionStreamWriter writer(arch->arch_name);
+  remill::Instruction inst;
+  ASSERT_TRUE(arch->DecodeInstruction(
+      kBaseAddress, std::string_view(kAMD64Code, sizeof(kAMD64Code) - 1),
+      inst));
+  ASSERT_TRUE(writer.Add(inst));
+
+  const auto path = TemporaryFile();
+  ASSERT_TRUE(writer.WriteToFile(path));
+  const auto data = ReadFile(path);
+  ASSERT_NE(remill::InstructionStream::Open(path), nullptr);
+
+  for (size_t size = 0; size < data.size(); ++size) {
+    SCOPED_TRACE(size);
+    WriteFile(path, std::string_view(data).substr(0, size));
+    EXPECT_EQ(remill::InstructionStream::Open(path), nullptr);
+  }
+
+  // The version follows the 8-byte magic number.
+  auto bad_version = data;
+  bad_version[8] ^= 0x80;
+  WriteFile(path, bad_version);
+  EXPECT_EQ(remill::InstructionStream::Open(path), nullptr);
+
+  auto bad_magic = data;
+  bad_magic[0] = 'X';
+  WriteFile(path, bad_magic);
+  EXPECT_EQ(remill::InstructionStream::Open(path), nullptr);
+
+  llvm::sys::fs::remove(path);
+}
+
+}  // namespace
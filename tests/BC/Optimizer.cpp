@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "remill/BC/Optimizer.h"
+
+#include <llvm/ADT/Triple.h>
+#include <llvm/Analysis/AliasAnalysis.h>
+#include <llvm/Analysis/MemoryLocation.h>
+#include <llvm/Analysis/TargetLibraryInfo.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+
+#include <string_view>
+
+#include "lib/BC/AliasAnalysis.h"
+#include "remill/BC/ABI.h"
+#include "tests/BC/Test.h"
+
+namespace {
+
+using OptimizerTest = test::LifterTest;
+
+// Returns the number of calls in `func` to the function named `name`.
+static unsigned NumCallsTo(llvm::Function *func, llvm::StringRef name) {
+  unsigned num_calls = 0;
+  for (auto &inst : llvm::instructions(func)) {
+    if (auto call = llvm::dyn_cast<llvm::CallInst>(&inst)) {
+      auto callee = call->getCalledFunction();
+      if (callee && callee->getName() == name) {
+        ++num_calls;
+      }
+    }
+  }
+  return num_calls;
+}
+
+// A leaf function that stores to, and loads from, its own stack frame.
+static constexpr char kLeafWithFrame[] =
+    "\x48\x8d\x64\x24\xf8"  // lea rsp, [rsp - 8]
+    "\xc7\x04\x24\x01\x00\x00\x00"  // mov dword ptr [rsp], 1
+    "\x8b\x04\x24"  // mov eax, dword ptr [rsp]
+    "\x48\x8d\x64\x24\x08"  // lea rsp, [rsp + 8]
+    "\xc3";  // ret
+
+// The bytes of `kLeafWithFrame`, which contains NULs.
+static constexpr std::string_view kLeafWithFrameBytes(
+    kLeafWithFrame, sizeof(kLeafWithFrame) - 1u);
+
+// Without promotion, the accesses to the frame stay memory intrinsic calls.
+TEST_F(OptimizerTest, KeepStackFrame) {
+  manager.SetBytes(0x1000, kLeafWithFrameBytes);
+  ASSERT_TRUE(trace_lifter.Lift(0x1000));
+
+  const auto trace = manager.traces[0x1000];
+  remill::OptimizeModule(arch.get(), module.get(), {trace});
+
+  EXPECT_EQ(NumCallsTo(trace, "__remill_write_memory_32"), 1u);
+  EXPECT_EQ(NumCallsTo(trace, "__remill_read_memory_32"), 1u);
+}
+
+// With promotion, the accesses to the frame are promoted to an `alloca`,
+// and then optimized away. The read of the return address, which is above
+// the frame, is left alone.
+TEST_F(OptimizerTest, PromoteStackFrame) {
+  manager.SetBytes(0x1000, kLeafWithFrameBytes);
+  ASSERT_TRUE(trace_lifter.Lift(0x1000));
+
+  const auto trace = manager.traces[0x1000];
+  remill::OptimizationGuide guide = {};
+  guide.promote_stack_frames = true;
+  remill::OptimizeModule(arch.get(), module.get(), {trace}, guide);
+
+  EXPECT_EQ(NumCallsTo(trace, "__remill_write_memory_32"), 0u);
+  EXPECT_EQ(NumCallsTo(trace, "__remill_read_memory_32"), 0u);
+  EXPECT_EQ(NumCallsTo(trace, "__remill_read_memory_64"), 1u);
+  EXPECT_FALSE(remill::VerifyModuleMsg(module.get()).has_value());
+}
+
+// A read of the red zone that isn't preceded by a write to it reads a value
+// from before the trace, so the frame can't be promoted.
+TEST_F(OptimizerTest, KeepStackFrameReadBeforeWrite) {
+  static constexpr char kReadRedZone[] =
+      "\x8b\x44\x24\xf8"  // mov eax, dword ptr [rsp - 8]
+      "\xc7\x44\x24\xf8\x01\x00\x00\x00"  // mov dword ptr [rsp - 8], 1
+      "\xc3";  // ret
+
+  manager.SetBytes(0x1000,
+                   std::string_view(kReadRedZone, sizeof(kReadRedZone) - 1u));
+  ASSERT_TRUE(trace_lifter.Lift(0x1000));
+
+  const auto trace = manager.traces[0x1000];
+  remill::OptimizationGuide guide = {};
+  guide.promote_stack_frames = true;
+  remill::OptimizeModule(arch.get(), module.get(), {trace}, guide);
+
+  EXPECT_EQ(NumCallsTo(trace, "__remill_read_memory_32"), 1u);
+  EXPECT_EQ(NumCallsTo(trace, "__remill_write_memory_32"), 1u);
+  EXPECT_FALSE(remill::VerifyModuleMsg(module.get()).has_value());
+}
+
+// Two adjacent 32-bit reads are fused into one 64-bit read, which is split
+// back into the two values.
+TEST_F(OptimizerTest, CoalesceReads) {
+  manager.SetBytes(0x1000,
+                   "\x8b\x07"  // mov eax, dword ptr [rdi]
+                   "\x8b\x57\x04"  // mov edx, dword ptr [rdi + 4]
+                   "\xc3");  // ret
+
+  ASSERT_TRUE(trace_lifter.Lift(0x1000));
+
+  const auto trace = manager.traces[0x1000];
+  remill::OptimizationGuide guide = {};
+  guide.coalesce_memory_accesses = true;
+  remill::OptimizeModule(arch.get(), module.get(), {trace}, guide);
+
+  // One 64-bit read is the coalesced one, and the other is `ret` reading
+  // the return address.
+  EXPECT_EQ(NumCallsTo(trace, "__remill_read_memory_32"), 0u);
+  EXPECT_EQ(NumCallsTo(trace, "__remill_read_memory_64"), 2u);
+  EXPECT_FALSE(remill::VerifyModuleMsg(module.get()).has_value());
+}
+
+// Two adjacent 32-bit writes are fused into one 64-bit write.
+TEST_F(OptimizerTest, CoalesceWrites) {
+  manager.SetBytes(0x1000,
+                   "\x89\x07"  // mov dword ptr [rdi], eax
+                   "\x89\x57\x04"  // mov dword ptr [rdi + 4], edx
+                   "\xc3");  // ret
+
+  ASSERT_TRUE(trace_lifter.Lift(0x1000));
+
+  const auto trace = manager.traces[0x1000];
+  remill::OptimizationGuide guide = {};
+  guide.coalesce_memory_accesses = true;
+  remill::OptimizeModule(arch.get(), module.get(), {trace}, guide);
+
+  EXPECT_EQ(NumCallsTo(trace, "__remill_write_memory_32"), 0u);
+  EXPECT_EQ(NumCallsTo(trace, "__remill_write_memory_64"), 1u);
+  EXPECT_FALSE(remill::VerifyModuleMsg(module.get()).has_value());
+}
+
+// Accesses to distinct registers in the `State` structure don't alias, even
+// when one is addressed with a byte offset instead of a field index. Parts
+// of the same register may alias.
+TEST_F(OptimizerTest, RemillAAStateRegisters) {
+  const auto func = arch->DefineLiftedFunction("test_aa_regs", module.get());
+  const auto block = &(func->getEntryBlock());
+  const auto state_ptr = remill::NthArgument(func, remill::kStatePointerArgNum);
+  const auto rax = arch->RegisterByName("RAX");
+  const auto rbx = arch->RegisterByName("RBX");
+  const auto eax = arch->RegisterByName("EAX");
+  ASSERT_TRUE(rax && rbx && eax);
+
+  llvm::IRBuilder<> ir(block);
+  const auto rbx_bytes = ir.CreateConstGEP1_64(
+      ir.getInt8Ty(), ir.CreateBitCast(state_ptr, ir.getInt8PtrTy()),
+      rbx->offset);
+
+  const auto loc = [](llvm::Value *ptr, uint64_t size) {
+    return llvm::MemoryLocation(ptr, llvm::LocationSize::precise(size));
+  };
+  const auto rax_loc = loc(rax->AddressOf(state_ptr, block), 8);
+  const auto rbx_loc = loc(rbx->AddressOf(state_ptr, block), 8);
+  const auto eax_loc = loc(eax->AddressOf(state_ptr, block), 4);
+  const auto rbx_bytes_loc = loc(rbx_bytes, 8);
+
+  // Only ask `RemillAAResult`, so that no other analysis can answer.
+  llvm::TargetLibraryInfoImpl tlii(llvm::Triple(module->getTargetTriple()));
+  llvm::TargetLibraryInfo tli(tlii);
+  remill::RemillAAResult remill_aa(arch.get());
+  llvm::AAResults aa(tli);
+  aa.addAAResult(remill_aa);
+
+  EXPECT_EQ(aa.alias(rax_loc, rbx_loc), llvm::AliasResult::NoAlias);
+  EXPECT_EQ(aa.alias(rax_loc, rbx_bytes_loc), llvm::AliasResult::NoAlias);
+  EXPECT_EQ(aa.alias(eax_loc, rbx_bytes_loc), llvm::AliasResult::NoAlias);
+  EXPECT_EQ(aa.alias(rax_loc, eax_loc), llvm::AliasResult::MayAlias);
+  EXPECT_EQ(aa.alias(rbx_loc, rbx_bytes_loc), llvm::AliasResult::MayAlias);
+}
+
+// Writing to memory doesn't clobber the `State` structure, so a register
+// loaded before the write is forwarded to a load of it after the write.
+TEST_F(OptimizerTest, RemillAAForwardAcrossMemoryWrite) {
+  const auto func = arch->DefineLiftedFunction("test_aa_write", module.get());
+  const auto block = &(func->getEntryBlock());
+  const auto state_ptr = remill::NthArgument(func, remill::kStatePointerArgNum);
+  auto mem_ptr = remill::NthArgument(func, remill::kMemoryPointerArgNum);
+  const auto rax = arch->RegisterByName("RAX");
+  const auto rbx = arch->RegisterByName("RBX");
+  ASSERT_TRUE(rax && rbx);
+
+  llvm::IRBuilder<> ir(block);
+  const auto rax_ptr = rax->AddressOf(state_ptr, ir);
+  const auto rbx_ptr = rbx->AddressOf(state_ptr, ir);
+  const auto before = ir.CreateLoad(ir.getInt64Ty(), rax_ptr);
+  const auto write =
+      ir.CreateCall(intrinsics.write_memory_64, {mem_ptr, before, before});
+  const auto after = ir.CreateLoad(ir.getInt64Ty(), rax_ptr);
+  ir.CreateStore(ir.CreateAdd(before, after), rbx_ptr);
+  ir.CreateRet(write);
+
+  // Only ask `RemillAAResult` about the call.
+  llvm::TargetLibraryInfoImpl tlii(llvm::Triple(module->getTargetTriple()));
+  llvm::TargetLibraryInfo tli(tlii);
+  remill::RemillAAResult remill_aa(arch.get());
+  llvm::AAResults aa(tli);
+  aa.addAAResult(remill_aa);
+  EXPECT_EQ(aa.getModRefInfo(write, llvm::MemoryLocation::get(after)),
+            llvm::ModRefInfo::NoModRef);
+
+  remill::OptimizeModule(arch.get(), module.get(), {func});
+
+  unsigned num_loads = 0;
+  for (auto &inst : llvm::instructions(func)) {
+    num_loads += llvm::isa<llvm::LoadInst>(&inst);
+  }
+  EXPECT_EQ(num_loads, 1u);
+  EXPECT_EQ(NumCallsTo(func, "__remill_write_memory_64"), 1u);
+  EXPECT_FALSE(remill::VerifyModuleMsg(module.get()).has_value());
+}
+
+}  // namespace
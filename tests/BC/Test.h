@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <gtest/gtest.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+#include "remill/Arch/Arch.h"
+#include "remill/Arch/InstructionIndex.h"
+#include "remill/BC/IntrinsicTable.h"
+#include "remill/BC/Lifter.h"
+#include "remill/BC/Util.h"
+
+namespace test {
+
+// Trace manager over a map of executable bytes, which tests can change
+// between lifts.
+class TraceManager : public remill::TraceManager {
+ public:
+  virtual ~TraceManager(void) = default;
+
+  void SetLiftedTraceDefinition(uint64_t addr,
+                                llvm::Function *lifted_func) override {
+    traces[addr] = lifted_func;
+  }
+
+  llvm::Function *GetLiftedTraceDeclaration(uint64_t addr) override {
+    auto trace_it = traces.find(addr);
+    return trace_it != traces.end() ? trace_it->second : nullptr;
+  }
+
+  llvm::Function *GetLiftedTraceDefinition(uint64_t addr) override {
+    return GetLiftedTraceDeclaration(addr);
+  }
+
+  const remill::InstructionIndex *GetInstructionIndex(void) override {
+    return index;
+  }
+
+  bool TryReadExecutableByte(uint64_t addr, uint8_t *byte) override {
+    auto byte_it = memory.find(addr);
+    if (byte_it == memory.end()) {
+      return false;
+    }
+    *byte = byte_it->second;
+    return true;
+  }
+
+  // Place the raw bytes `bytes` in memory, starting at `addr`.
+  void SetBytes(uint64_t addr, std::string_view bytes) {
+    for (auto byte : bytes) {
+      memory[addr++] = static_cast<uint8_t>(byte);
+    }
+  }
+
+  std::map<uint64_t, uint8_t> memory;
+  std::unordered_map<uint64_t, llvm::Function *> traces;
+  const remill::InstructionIndex *index{nullptr};
+};
+
+// Fixture that lifts amd64 code into a freshly loaded semantics module.
+class LifterTest : public ::testing::Test {
+ protected:
+  LifterTest(void)
+      : arch(remill::Arch::Get(context, "linux", "amd64")),
+        module(remill::LoadArchSemantics(arch.get())),
+        intrinsics(module.get()),
+        inst_lifter(arch.get(), intrinsics),
+        trace_lifter(inst_lifter, manager) {}
+
+  llvm::LLVMContext context;
+  const remill::Arch::ArchPtr arch;
+  const std::unique_ptr<llvm::Module> module;
+  const remill::IntrinsicTable intrinsics;
+  remill::InstructionLifter inst_lifter;
+  TraceManager manager;
+  remill::TraceLifter trace_lifter;
+};
+
+}  // namespace test
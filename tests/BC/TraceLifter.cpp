@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020 Trail of Bits, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "remill/Arch/Name.h"
+#include "remill/OS/OS.h"
+#include "tests/BC/Test.h"
+
+namespace {
+
+using TraceLifterTest = test::LifterTest;
+
+// Invalidating the bytes of a trace deletes its body, and lifting it again
+// re-defines the same function from the new bytes.
+TEST_F(TraceLifterTest, InvalidateAndRelift) {
+  manager.SetBytes(0x1000, "\x90\xc3");  // nop; ret
+  ASSERT_TRUE(trace_lifter.Lift(0x1000));
+
+  const auto trace = manager.traces[0x1000];
+  ASSERT_NE(trace, nullptr);
+  EXPECT_FALSE(trace->isDeclaration());
+  EXPECT_EQ(trace_lifter.NumDecodedInstructions(0x1000), 2u);
+
+  // Empty ranges invalidate nothing, even inside of the trace.
+  EXPECT_TRUE(trace_lifter.Invalidate(0x1000, 0).empty());
+  EXPECT_TRUE(trace_lifter.Invalidate(0x1001, 0).empty());
+
+  // Neither do ranges next to the trace.
+  EXPECT_TRUE(trace_lifter.Invalidate(0x1002, 16).empty());
+  EXPECT_TRUE(trace_lifter.Invalidate(0xff0, 0x10).empty());
+  EXPECT_FALSE(trace->isDeclaration());
+
+  const auto invalidated = trace_lifter.Invalidate(0x1000, 1);
+  EXPECT_EQ(invalidated, std::vector<uint64_t>{0x1000});
+  EXPECT_TRUE(trace->isDeclaration());
+  EXPECT_EQ(trace_lifter.NumDecodedInstructions(0x1000), 0u);
+
+  manager.SetBytes(0x1000, "\xc3");  // ret
+  ASSERT_TRUE(trace_lifter.Lift(0x1000));
+
+  EXPECT_EQ(manager.traces[0x1000], trace);
+  EXPECT_FALSE(trace->isDeclaration());
+  EXPECT_EQ(trace_lifter.NumDecodedInstructions(0x1000), 1u);
+  EXPECT_FALSE(remill::VerifyModuleMsg(module.get()).has_value());
+}
+
+// Re-lifting invalidated bytes doesn't use the instruction index's stale copy
+// of them.
+TEST_F(TraceLifterTest, InvalidateAndReliftIndexed) {
+  const auto index = remill::InstructionIndex::Build(
+      remill::kOSLinux, remill::kArchAMD64, 0x1000, "\x90\xc3", 1);
+  ASSERT_NE(index, nullptr);
+  manager.index = index.get();
+
+  manager.SetBytes(0x1000, "\x90\xc3");  // nop; ret
+  ASSERT_TRUE(trace_lifter.Lift(0x1000));
+  EXPECT_EQ(trace_lifter.NumDecodedInstructions(0x1000), 2u);
+
+  const auto trace = manager.traces[0x1000];
+  EXPECT_EQ(trace_lifter.Invalidate(0x1000, 1),
+            std::vector<uint64_t>{0x1000});
+
+  manager.SetBytes(0x1000, "\xc3");  // ret
+  ASSERT_TRUE(trace_lifter.Lift(0x1000));
+
+  EXPECT_EQ(manager.traces[0x1000], trace);
+  EXPECT_FALSE(trace->isDeclaration());
+  EXPECT_EQ(trace_lifter.NumDecodedInstructions(0x1000), 1u);
+  EXPECT_FALSE(remill::VerifyModuleMsg(module.get()).has_value());
+}
+
+}  // namespace
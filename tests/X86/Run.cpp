@@ -83,6 +83,13 @@ NEVER_INLINE static T &AccessMemory(addr_t addr) {
   return *reinterpret_cast<T *>(static_cast<uintptr_t>(addr));
 }
 
+NEVER_INLINE static uint8_t *AccessMemoryBytes(addr_t addr, addr_t size) {
+  if (size && !(addr >= gStackBase && (addr + size) <= gStackLimit)) {
+    EXPECT_TRUE(!"Memory access falls outside the valid range of the stack.");
+  }
+  return reinterpret_cast<uint8_t *>(static_cast<uintptr_t>(addr));
+}
+
 // Used to handle exceptions in instructions.
 static sigjmp_buf gJmpBuf;
 static sigjmp_buf gUnsupportedInstrBuf;
@@ -193,6 +200,38 @@ NEVER_INLINE Memory *__remill_write_memory_f80(Memory *, addr_t addr,
   return nullptr;
 }
 
+NEVER_INLINE Memory *__remill_memory_copy(Memory *, addr_t dst, addr_t src,
+                                          addr_t size) {
+  memmove(AccessMemoryBytes(dst, size), AccessMemoryBytes(src, size), size);
+  return nullptr;
+}
+
+#define MAKE_MEMORY_FILL(size) \
+  NEVER_INLINE Memory *__remill_memory_fill_##size( \
+      Memory *, addr_t dst, uint##size##_t value, addr_t count) { \
+    auto elems = reinterpret_cast<uint##size##_t *>( \
+        AccessMemoryBytes(dst, count * sizeof(value))); \
+    for (addr_t i = 0; i < count; ++i) { \
+      elems[i] = value; \
+    } \
+    return nullptr; \
+  }
+
+MAKE_MEMORY_FILL(8)
+MAKE_MEMORY_FILL(16)
+MAKE_MEMORY_FILL(32)
+MAKE_MEMORY_FILL(64)
+
+NEVER_INLINE addr_t __remill_memory_compare(Memory *, addr_t lhs, addr_t rhs,
+                                            addr_t size) {
+  auto lhs_bytes = AccessMemoryBytes(lhs, size);
+  auto rhs_bytes = AccessMemoryBytes(rhs, size);
+  addr_t i = 0;
+  for (; i < size && lhs_bytes[i] == rhs_bytes[i]; ++i) {
+  }
+  return i;
+}
+
 Memory *__remill_compare_exchange_memory_8(Memory *memory, addr_t addr,
                                            uint8_t &expected, uint8_t desired) {
   expected = __sync_val_compare_and_swap(reinterpret_cast<uint8_t *>(addr),